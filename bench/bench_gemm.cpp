@@ -0,0 +1,49 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "math/gemm.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace jinfer;
+
+/// 参数为(kernel, m, n, k)，形状取自resnet18卷积展开后的矩阵：m为输出像素数，n为输出通道数
+static void
+BM_Sgemm(benchmark::State &state)
+{
+    const auto kernel = GemmKernel(state.range(0));
+    const auto m = (uint32_t) state.range(1);
+    const auto n = (uint32_t) state.range(2);
+    const auto k = (uint32_t) state.range(3);
+    const GemmKernel default_kernel = gemm_kernel();
+    if (!set_gemm_kernel(kernel)) {
+        state.SkipWithError("the gemm kernel is not supported by this cpu");
+        return;
+    }
+
+    const std::vector<float> a(size_t(m) * k, 0.5f);
+    const std::vector<float> b(size_t(k) * n, 0.25f);
+    std::vector<float> c(size_t(m) * n);
+    for (auto _ : state) {
+        sgemm(m, n, k, a.data(), m, b.data(), k, c.data(), m);
+        benchmark::ClobberMemory();
+    }
+    set_gemm_kernel(default_kernel);
+
+    state.counters["FLOPS"] = benchmark::Counter(2.0 * m * n * k, benchmark::Counter::kIsIterationInvariantRate,
+                                                 benchmark::Counter::kIs1000);
+    state.SetBytesProcessed(state.iterations() * (int64_t(m) * k + int64_t(k) * n + int64_t(m) * n) * (int64_t) sizeof(float));
+}
+
+static void
+GemmArgs(benchmark::internal::Benchmark *bench)
+{
+    bench->ArgNames({"kernel", "m", "n", "k"});
+    for (int kernel = 0; kernel <= 2; kernel++) {
+        bench->Args({kernel, 3136, 64, 576})
+            ->Args({kernel, 784, 128, 1152})
+            ->Args({kernel, 196, 256, 2304})
+            ->Args({kernel, 49, 512, 4608});
+    }
+}
+BENCHMARK(BM_Sgemm)->Apply(GemmArgs)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,97 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/runtime_ir.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace jinfer;
+
+/// 端到端的图，只列出所有算子都有对应层、权重文件齐全的模型；路径相对于仓库根目录，请在仓库根目录下运行jinfer_bench
+struct GraphCase {
+    const char *param_path;
+    const char *bin_path;
+    uint32_t batch;
+    uint32_t channels;
+    uint32_t rows;
+    uint32_t cols;
+};
+
+static const GraphCase kGraphCases[] = {
+    {"model_file/simple_ops2.pnnx.param", "model_file/simple_ops2.pnnx.bin", 2, 3, 16, 16},
+    {"model_file/test_linear.pnnx.param", "model_file/test_linear.pnnx.bin", 1, 1, 1, 32},
+    {"model_file/dynamic_ops.pnnx.param", "model_file/dynamic_ops.pnnx.bin", 4, 3, 64, 64},
+};
+static const int kGraphCaseNum = int(sizeof(kGraphCases) / sizeof(kGraphCases[0]));
+
+static bool
+BuildGraph(RuntimeGraph &graph)
+{
+    return graph.init() && graph.build("pnnx_input_0", "pnnx_output_0");
+}
+
+static void
+BM_GraphBuild(benchmark::State &state)
+{
+    const GraphCase &graph_case = kGraphCases[state.range(0)];
+    state.SetLabel(graph_case.param_path);
+    for (auto _ : state) {
+        RuntimeGraph graph(graph_case.param_path, graph_case.bin_path);
+        if (!BuildGraph(graph)) {
+            state.SkipWithError("init or build graph failed");
+            break;
+        }
+    }
+}
+BENCHMARK(BM_GraphBuild)->DenseRange(0, kGraphCaseNum - 1)->Unit(benchmark::kMillisecond);
+
+/// 用性能分析器执行一次推理，累加各节点估算的浮点运算数
+static double
+ForwardFlops(RuntimeGraph &graph, const std::vector<sftensor> &inputs)
+{
+    auto profiler = std::make_shared<Profiler>();
+    graph.set_profiler(profiler);
+    graph.forward(inputs);
+    graph.set_profiler(nullptr);
+
+    double flops = 0.;
+    for (const auto &profile : profiler->profiles()) {
+        flops += double(profile.flops);
+    }
+    return flops;
+}
+
+/// 只计时forward，每秒处理的样本数为items_per_second，FLOPS按性能分析器的估算值计
+static void
+BM_GraphForward(benchmark::State &state)
+{
+    const GraphCase &graph_case = kGraphCases[state.range(0)];
+    state.SetLabel(graph_case.param_path);
+    RuntimeGraph graph(graph_case.param_path, graph_case.bin_path);
+    if (!BuildGraph(graph)) {
+        state.SkipWithError("init or build graph failed");
+        return;
+    }
+
+    std::vector<sftensor> inputs;
+    for (uint32_t i = 0; i < graph_case.batch; i++) {
+        inputs.push_back(std::make_shared<ftensor>(graph_case.channels, graph_case.rows, graph_case.cols));
+        inputs.back()->rand();
+    }
+
+    const double flops = ForwardFlops(graph, inputs);
+    int64_t output_bytes = 0;
+    for (auto _ : state) {
+        const auto &outputs = graph.forward(inputs);
+        benchmark::DoNotOptimize(outputs.data());
+        if (output_bytes == 0) {
+            for (const auto &output : outputs) output_bytes += output->size() * sizeof(float);
+        }
+    }
+    const int64_t input_bytes = int64_t(graph_case.batch) * graph_case.channels * graph_case.rows
+        * graph_case.cols * (int64_t) sizeof(float);
+    state.SetItemsProcessed(state.iterations() * graph_case.batch);
+    state.SetBytesProcessed(state.iterations() * (input_bytes + output_bytes));
+    state.counters["FLOPS"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate,
+                                                 benchmark::Counter::kIs1000);
+}
+BENCHMARK(BM_GraphForward)->DenseRange(0, kGraphCaseNum - 1)->Unit(benchmark::kMicrosecond);
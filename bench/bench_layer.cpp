@@ -0,0 +1,296 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/adaptive_avgpooling.hpp"
+#include "layer/details/convolution.hpp"
+#include "layer/details/deconvolution.hpp"
+#include "layer/details/linear.hpp"
+#include "layer/details/pooling.hpp"
+#include "layer/details/relu.hpp"
+#include "layer/details/sigmoid.hpp"
+#include "layer/details/upsample.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+
+using namespace jinfer;
+
+/// 各个层的输入形状取自resnet18(batch=1, 224x224)
+static std::vector<sftensor>
+RandTensors(uint32_t batch, uint32_t channels, uint32_t rows, uint32_t cols)
+{
+    std::vector<sftensor> tensors;
+    for (uint32_t i = 0; i < batch; i++) {
+        tensors.push_back(std::make_shared<ftensor>(channels, rows, cols));
+        tensors.back()->rand();
+    }
+    return tensors;
+}
+
+static std::vector<float>
+RandValues(size_t size)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    std::vector<float> values(size);
+    for (auto &value : values) value = dist(gen);
+    return values;
+}
+
+/// 每次迭代的浮点运算数，以GFLOP/s的形式输出
+static void
+SetFlops(benchmark::State &state, double flops)
+{
+    state.counters["FLOPS"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate,
+                                                 benchmark::Counter::kIs1000);
+}
+
+static void
+BM_Relu(benchmark::State &state)
+{
+    const auto channels = (uint32_t) state.range(0);
+    const auto size = (uint32_t) state.range(1);
+    const auto inputs = RandTensors(1, channels, size, size);
+    auto outputs = RandTensors(1, channels, size, size);
+
+    ReluLayer layer;
+    for (auto _ : state) {
+        layer.forward(inputs, outputs);
+        benchmark::ClobberMemory();
+    }
+    const int64_t elements = int64_t(channels) * size * size;
+    SetFlops(state, double(elements));
+    state.SetBytesProcessed(state.iterations() * elements * 2 * (int64_t) sizeof(float));
+}
+BENCHMARK(BM_Relu)->Args({64, 112})->Args({256, 14});
+
+static void
+BM_Sigmoid(benchmark::State &state)
+{
+    const auto channels = (uint32_t) state.range(0);
+    const auto size = (uint32_t) state.range(1);
+    const auto inputs = RandTensors(1, channels, size, size);
+    auto outputs = RandTensors(1, channels, size, size);
+
+    SigmoidLayer layer;
+    for (auto _ : state) {
+        layer.forward(inputs, outputs);
+        benchmark::ClobberMemory();
+    }
+    const int64_t elements = int64_t(channels) * size * size;
+    SetFlops(state, double(elements) * 3);
+    state.SetBytesProcessed(state.iterations() * elements * 2 * (int64_t) sizeof(float));
+}
+BENCHMARK(BM_Sigmoid)->Args({64, 112})->Args({256, 14});
+
+/// 参数为(in_channels, out_channels, kernel, stride, padding, input_size)
+static void
+BM_Conv2d(benchmark::State &state)
+{
+    const auto in_channels = (uint32_t) state.range(0);
+    const auto out_channels = (uint32_t) state.range(1);
+    const auto kernel = (uint32_t) state.range(2);
+    const auto stride = (uint32_t) state.range(3);
+    const auto padding = (uint32_t) state.range(4);
+    const auto input_size = (uint32_t) state.range(5);
+    const uint32_t output_size = (input_size + 2 * padding - kernel) / stride + 1;
+
+    ConvolutionLayer layer(in_channels, out_channels, kernel, kernel, stride, stride, padding, padding);
+    layer.set_weights(RandValues(size_t(out_channels) * in_channels * kernel * kernel));
+    layer.set_bias(RandValues(out_channels));
+
+    const auto inputs = RandTensors(1, in_channels, input_size, input_size);
+    auto outputs = RandTensors(1, out_channels, output_size, output_size);
+    for (auto _ : state) {
+        layer.forward(inputs, outputs);
+        benchmark::ClobberMemory();
+    }
+
+    const double macs = double(out_channels) * output_size * output_size * in_channels * kernel * kernel;
+    SetFlops(state, macs * 2);
+    const int64_t bytes = (int64_t(in_channels) * input_size * input_size
+        + int64_t(out_channels) * output_size * output_size
+        + int64_t(out_channels) * in_channels * kernel * kernel) * (int64_t) sizeof(float);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_Conv2d)
+    ->ArgNames({"in", "out", "k", "s", "p", "size"})
+    ->Args({3, 64, 7, 2, 3, 224})
+    ->Args({64, 64, 3, 1, 1, 56})
+    ->Args({64, 128, 3, 2, 1, 56})
+    ->Args({64, 128, 1, 2, 0, 56})
+    ->Args({128, 128, 3, 1, 1, 28})
+    ->Args({256, 256, 3, 1, 1, 14})
+    ->Args({512, 512, 3, 1, 1, 7})
+    ->Unit(benchmark::kMicrosecond);
+
+/// 参数为(channels, kernel, stride, input_size)，形状取自mobilenet_v2，融合ReLU6
+static void
+BM_DepthwiseConv2d(benchmark::State &state)
+{
+    const auto channels = (uint32_t) state.range(0);
+    const auto kernel = (uint32_t) state.range(1);
+    const auto stride = (uint32_t) state.range(2);
+    const auto input_size = (uint32_t) state.range(3);
+    const uint32_t padding = kernel / 2;
+    const uint32_t output_size = (input_size + 2 * padding - kernel) / stride + 1;
+
+    ConvolutionLayer layer(channels, channels, kernel, kernel, stride, stride, padding, padding, 1, 1, channels);
+    layer.set_weights(RandValues(size_t(channels) * kernel * kernel));
+    layer.set_bias(RandValues(channels));
+    layer.set_activation(ActivationType::kActivationRelu6);
+
+    const auto inputs = RandTensors(1, channels, input_size, input_size);
+    auto outputs = RandTensors(1, channels, output_size, output_size);
+    for (auto _ : state) {
+        layer.forward(inputs, outputs);
+        benchmark::ClobberMemory();
+    }
+
+    const double macs = double(channels) * output_size * output_size * kernel * kernel;
+    SetFlops(state, macs * 2);
+    const int64_t bytes = (int64_t(channels) * input_size * input_size + int64_t(channels) * output_size * output_size)
+        * (int64_t) sizeof(float);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_DepthwiseConv2d)
+    ->ArgNames({"c", "k", "s", "size"})
+    ->Args({32, 3, 1, 112})
+    ->Args({96, 3, 2, 112})
+    ->Args({144, 3, 1, 56})
+    ->Args({384, 3, 1, 14})
+    ->Args({960, 3, 1, 7})
+    ->Args({672, 5, 1, 14})
+    ->Unit(benchmark::kMicrosecond);
+
+/// 参数为(in_channels, out_channels, input_size)，4x4卷积核、stride=2、padding=1，即分割网络解码器中的2倍上采样
+static void
+BM_ConvTranspose2d(benchmark::State &state)
+{
+    const auto in_channels = (uint32_t) state.range(0);
+    const auto out_channels = (uint32_t) state.range(1);
+    const auto input_size = (uint32_t) state.range(2);
+    const uint32_t kernel = 4;
+    const uint32_t output_size = input_size * 2;
+
+    DeconvolutionLayer layer(in_channels, out_channels, kernel, kernel, 2, 2, 1, 1);
+    layer.set_weights(RandValues(size_t(in_channels) * out_channels * kernel * kernel));
+    layer.set_bias(RandValues(out_channels));
+
+    const auto inputs = RandTensors(1, in_channels, input_size, input_size);
+    auto outputs = RandTensors(1, out_channels, output_size, output_size);
+    for (auto _ : state) {
+        layer.forward(inputs, outputs);
+        benchmark::ClobberMemory();
+    }
+
+    const double macs = double(in_channels) * out_channels * input_size * input_size * kernel * kernel;
+    SetFlops(state, macs * 2);
+    const int64_t bytes = (int64_t(in_channels) * input_size * input_size
+                           + int64_t(out_channels) * output_size * output_size) * (int64_t) sizeof(float);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_ConvTranspose2d)
+    ->ArgNames({"ic", "oc", "size"})
+    ->Args({512, 256, 14})
+    ->Args({256, 128, 28})
+    ->Args({128, 64, 56})
+    ->Args({64, 32, 112})
+    ->Unit(benchmark::kMicrosecond);
+
+/// 参数为(mode, channels, input_size)，2倍上采样，形状取自FPN的各个尺度
+static void
+BM_Upsample(benchmark::State &state)
+{
+    ResizeParam param;
+    param.mode = ResizeMode(state.range(0));
+    param.scale_h = 2.f;
+    param.scale_w = 2.f;
+    const auto channels = (uint32_t) state.range(1);
+    const auto input_size = (uint32_t) state.range(2);
+    const uint32_t output_size = input_size * 2;
+
+    UpsampleLayer layer(param);
+    const auto plan = layer.make_plan(input_size, input_size, output_size, output_size);
+
+    const auto inputs = RandTensors(1, channels, input_size, input_size);
+    auto outputs = RandTensors(1, channels, output_size, output_size);
+    for (auto _ : state) {
+        layer.forward(inputs, outputs, plan.get());
+        benchmark::ClobberMemory();
+    }
+
+    const int64_t bytes = int64_t(channels) * (input_size * input_size + output_size * output_size)
+        * (int64_t) sizeof(float);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_Upsample)
+    ->ArgNames({"mode", "c", "size"})
+    ->ArgsProduct({{int(ResizeMode::kResizeNearest), int(ResizeMode::kResizeBilinear)}, {256}, {10, 20, 40, 80}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void
+BM_MaxPool2d(benchmark::State &state)
+{
+    const uint32_t channels = 64;
+    const uint32_t input_size = 112;
+    const uint32_t output_size = 56;
+    PoolingLayer layer(PoolingType::kMaxPooling, 3, 3, 2, 2, 1, 1);
+
+    const auto inputs = RandTensors(1, channels, input_size, input_size);
+    auto outputs = RandTensors(1, channels, output_size, output_size);
+    for (auto _ : state) {
+        layer.forward(inputs, outputs);
+        benchmark::ClobberMemory();
+    }
+    SetFlops(state, double(channels) * output_size * output_size * 9);
+    const int64_t bytes = int64_t(channels) * (input_size * input_size + output_size * output_size) * (int64_t) sizeof(float);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_MaxPool2d)->Unit(benchmark::kMicrosecond);
+
+static void
+BM_AdaptiveAvgPool2d(benchmark::State &state)
+{
+    const uint32_t channels = 512;
+    const uint32_t input_size = 7;
+    AdaptiveAvgPoolingLayer layer(1, 1);
+
+    const auto inputs = RandTensors(1, channels, input_size, input_size);
+    auto outputs = RandTensors(1, channels, 1, 1);
+    for (auto _ : state) {
+        layer.forward(inputs, outputs);
+        benchmark::ClobberMemory();
+    }
+    SetFlops(state, double(channels) * input_size * input_size);
+    const int64_t bytes = int64_t(channels) * (input_size * input_size + 1) * (int64_t) sizeof(float);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_AdaptiveAvgPool2d);
+
+/// 参数为(batch, in_features, out_features)，batch为1时走GEMV
+static void
+BM_Linear(benchmark::State &state)
+{
+    const auto batch = (uint32_t) state.range(0);
+    const auto in_features = (uint32_t) state.range(1);
+    const auto out_features = (uint32_t) state.range(2);
+    LinearLayer layer(in_features, out_features, true);
+    layer.set_weights(RandValues(size_t(in_features) * out_features));
+    layer.set_bias(RandValues(out_features));
+
+    const auto inputs = RandTensors(1, 1, batch, in_features);
+    auto outputs = RandTensors(1, 1, batch, out_features);
+    for (auto _ : state) {
+        layer.forward(inputs, outputs);
+        benchmark::ClobberMemory();
+    }
+    SetFlops(state, 2.0 * batch * in_features * out_features);
+    const int64_t bytes = (int64_t(batch) * (in_features + out_features)
+        + int64_t(in_features) * out_features) * (int64_t) sizeof(float);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_Linear)
+    ->ArgNames({"batch", "in", "out"})
+    ->Args({1, 512, 1000})
+    ->Args({32, 512, 1000})
+    ->Unit(benchmark::kMicrosecond);
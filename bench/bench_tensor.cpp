@@ -0,0 +1,107 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "data/tensor.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace jinfer;
+
+// 参数为(channels, rows, cols)，字节数按一次读或写整个张量计
+static void
+TensorArgs(benchmark::internal::Benchmark *bench)
+{
+    bench->Args({3, 224, 224})->Args({64, 56, 56})->Args({512, 7, 7});
+}
+
+static int64_t
+TensorBytes(const benchmark::State &state)
+{
+    return state.range(0) * state.range(1) * state.range(2) * (int64_t) sizeof(float);
+}
+
+static void
+BM_TensorCreate(benchmark::State &state)
+{
+    for (auto _ : state) {
+        Tensor<float> tensor(state.range(0), state.range(1), state.range(2));
+        benchmark::DoNotOptimize(tensor.raw_ptr());
+    }
+    state.SetBytesProcessed(state.iterations() * TensorBytes(state));
+}
+BENCHMARK(BM_TensorCreate)->Apply(TensorArgs);
+
+static void
+BM_TensorFillValue(benchmark::State &state)
+{
+    Tensor<float> tensor(state.range(0), state.range(1), state.range(2));
+    for (auto _ : state) {
+        tensor.fill(1.f);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * TensorBytes(state));
+}
+BENCHMARK(BM_TensorFillValue)->Apply(TensorArgs);
+
+static void
+BM_TensorFillValues(benchmark::State &state)
+{
+    Tensor<float> tensor(state.range(0), state.range(1), state.range(2));
+    const std::vector<float> values(tensor.size(), 1.f);
+    for (auto _ : state) {
+        tensor.fill(values, true);
+        benchmark::ClobberMemory();
+    }
+    // 读values，写张量
+    state.SetBytesProcessed(state.iterations() * TensorBytes(state) * 2);
+}
+BENCHMARK(BM_TensorFillValues)->Apply(TensorArgs);
+
+static void
+BM_TensorReshape(benchmark::State &state)
+{
+    const auto channels = (uint32_t) state.range(0);
+    const auto rows = (uint32_t) state.range(1);
+    const auto cols = (uint32_t) state.range(2);
+    Tensor<float> tensor(channels, rows, cols);
+    tensor.rand();
+    for (auto _ : state) {
+        tensor.reshape({channels, cols, rows}, true);
+        tensor.reshape({channels, rows, cols}, true);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * TensorBytes(state) * 4);
+}
+BENCHMARK(BM_TensorReshape)->Apply(TensorArgs);
+
+static void
+BM_TensorValues(benchmark::State &state)
+{
+    Tensor<float> tensor(state.range(0), state.range(1), state.range(2));
+    tensor.rand();
+    for (auto _ : state) {
+        auto values = tensor.values(true);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetBytesProcessed(state.iterations() * TensorBytes(state) * 2);
+}
+BENCHMARK(BM_TensorValues)->Apply(TensorArgs);
+
+static void
+BM_TensorPadding(benchmark::State &state)
+{
+    const auto channels = (uint32_t) state.range(0);
+    const auto rows = (uint32_t) state.range(1);
+    const auto cols = (uint32_t) state.range(2);
+    Tensor<float> input(channels, rows, cols);
+    input.rand();
+    for (auto _ : state) {
+        state.PauseTiming();
+        Tensor<float> tensor(input);
+        state.ResumeTiming();
+        tensor.padding({1, 1, 1, 1}, 0.f);
+        benchmark::DoNotOptimize(tensor.raw_ptr());
+    }
+    const int64_t padded = channels * (rows + 2) * (cols + 2) * (int64_t) sizeof(float);
+    state.SetBytesProcessed(state.iterations() * (TensorBytes(state) + padded));
+}
+BENCHMARK(BM_TensorPadding)->Apply(TensorArgs);
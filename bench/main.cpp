@@ -0,0 +1,16 @@
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+
+int main(int argc, char *argv[])
+{
+    google::InitGoogleLogging("jinfer_bench");
+    FLAGS_minloglevel = google::GLOG_ERROR;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
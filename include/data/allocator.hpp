@@ -0,0 +1,91 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _ALLOCATOR_HPP_
+#define _ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace jinfer
+{
+
+/// 张量数据的分配器，大小以float个数计，实现需要是线程安全的
+class TensorAllocator
+{
+public:
+    virtual ~TensorAllocator() = default;
+
+    virtual float *
+    allocate(size_t size) = 0;
+
+    /// size与分配时相同
+    virtual void
+    deallocate(float *ptr, size_t size) = 0;
+};
+
+/**
+ * 按大小分级缓存的分配器，释放的缓冲区留在对应级别的空闲链表中供下次分配复用；
+ * 大小向上取整到kMinBlockSize或不小于size / 8的2的幂的倍数，浪费不超过1/4。
+ * 空闲链表中的float个数超过上限时从最大的级别开始归还给系统
+ */
+class PoolAllocator: public TensorAllocator
+{
+public:
+    static constexpr size_t kMinBlockSize = 64;
+    static constexpr size_t kAlignment = 64;
+    /// 默认最多缓存64M个float，即256MB
+    static constexpr size_t kDefaultMaxCachedSize = size_t(64) << 20;
+
+    explicit PoolAllocator(size_t max_cached_size = kDefaultMaxCachedSize);
+
+    PoolAllocator(const PoolAllocator &) = delete;
+
+    PoolAllocator &
+    operator=(const PoolAllocator &) = delete;
+
+    ~PoolAllocator() override;
+
+    float *
+    allocate(size_t size) override;
+
+    void
+    deallocate(float *ptr, size_t size) override;
+
+    /// 空闲缓冲区全部还给系统
+    void
+    release();
+
+    /// 向系统申请且尚未归还的float个数，包括正在使用的和空闲的
+    size_t
+    reserved_size() const;
+
+    /// 空闲链表中的float个数
+    size_t
+    cached_size() const;
+
+    /// 空闲链表中float个数的上限
+    size_t
+    max_cached_size() const;
+
+    static size_t
+    block_size_of(size_t size);
+
+private:
+    /// 从最大的级别开始归还空闲缓冲区，直到缓存的float个数不超过上限，调用时已持有锁
+    void
+    trim_locked();
+
+    mutable std::mutex mutex_;
+    std::map<size_t, std::vector<float *>> free_blocks_;
+    size_t reserved_size_ = 0;
+    size_t cached_size_ = 0;
+    size_t max_cached_size_ = kDefaultMaxCachedSize;
+};
+
+}// namespace jinfer
+
+#endif//_ALLOCATOR_HPP_
@@ -5,6 +5,7 @@
 #ifndef JINFER_TENSOR_HPP
 #define JINFER_TENSOR_HPP
 
+#include "data/allocator.hpp"
 #include <armadillo>
 #include <memory>
 
@@ -36,6 +37,20 @@ public:
 
     explicit Tensor(const std::vector<uint32_t> &shapes);
 
+    /**
+     * 由分配器分配数据，张量释放时归还给分配器，数据未初始化
+     * @param allocator 为空时与Tensor(channels, rows, cols)相同
+     */
+    Tensor(uint32_t channels, uint32_t rows, uint32_t cols, const std::shared_ptr<TensorAllocator> &allocator);
+
+    /**
+     * 直接使用外部内存，不复制数据；之后若形状改变(如padding)，张量会改为持有自己分配的内存
+     * @param data 至少有channels * rows * cols个float，按张量的内存顺序存放
+     * @param owner 外部内存的持有者，张量存在期间保持它存活；为空时由调用者保证内存的生命周期
+     */
+    Tensor(float *data, uint32_t channels, uint32_t rows, uint32_t cols, std::shared_ptr<void> owner = nullptr);
+
+    /// 复制出的张量持有自己分配的内存
     Tensor(const Tensor &tensor);
 
     Tensor(Tensor &&tensor) noexcept;
@@ -100,10 +115,14 @@ public:
     const float *
     raw_ptr() const;
 
+    float *
+    raw_ptr();
+
     void
     flatten(bool row_major = true);
 
     /**
+     * 生成一份填充后的新数据，卷积和池化的计算中不使用，由算子在计算时自行处理边界
      * @param pads index represents: 0->up, 1->bottom, 2->left, 3->right
      * @param padding_value
      */
@@ -114,6 +133,13 @@ private:
     std::vector<uint32_t> raw_shape_;
     arma::fcube data_;
 
+    /// data_使用的外部内存及其持有者，data_改为自己分配内存后清空
+    float *external_ = nullptr;
+    std::shared_ptr<void> owner_;
+
+    void
+    release_external();
+
     void
     assign_each_shape(std::vector<uint32_t> shapes, uint32_t &rows, uint32_t &cols, uint32_t &channels);
 };
@@ -0,0 +1,34 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _WORKSPACE_HPP_
+#define _WORKSPACE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace jinfer
+{
+
+/**
+ * 线程私有的临时缓冲区，容量只增不减，预热之后相同大小的请求不再分配内存；
+ * 每个Tag对应一块独立的缓冲区，同一线程中会同时使用的缓冲区(如im2col的结果和gemm的打包面板)需要不同的Tag，
+ * 在OpenMP并行区域内调用时每个工作线程得到自己的缓冲区
+ * @param size 元素个数，新增的元素值初始化，已有的元素保持上次的值
+ * @return 至少有size个元素的缓冲区，在同一线程下次以相同Tag调用前有效
+ */
+template<typename Tag, typename T = float>
+T *
+thread_workspace(size_t size)
+{
+    thread_local std::vector<T> buffer;
+    if (buffer.size() < size) {
+        buffer.resize(size);
+    }
+    return buffer.data();
+}
+
+}// namespace jinfer
+
+#endif//_WORKSPACE_HPP_
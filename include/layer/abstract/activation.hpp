@@ -0,0 +1,86 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _ACTIVATION_HPP_
+#define _ACTIVATION_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+namespace jinfer
+{
+
+/// 可以融合到前一层计算结果写回阶段的激活函数
+enum class ActivationType
+{
+    kActivationNone = 0,
+    kActivationRelu = 1,
+    kActivationRelu6 = 2,
+    kActivationSigmoid = 3,
+};
+
+/**
+ * 根据算子类型得到可融合的激活函数
+ * @param op_type 算子类型，例如nn.ReLU
+ * @return 不可融合时返回kActivationNone
+ */
+inline ActivationType
+activation_type_of(const std::string &op_type)
+{
+    if (op_type == "nn.ReLU" || op_type == "F.relu") {
+        return ActivationType::kActivationRelu;
+    }
+    if (op_type == "nn.ReLU6" || op_type == "F.relu6") {
+        return ActivationType::kActivationRelu6;
+    }
+    if (op_type == "nn.Sigmoid" || op_type == "F.sigmoid") {
+        return ActivationType::kActivationSigmoid;
+    }
+    return ActivationType::kActivationNone;
+}
+
+inline float
+apply_activation(ActivationType type, float value)
+{
+    switch (type) {
+    case ActivationType::kActivationRelu: return std::max(value, 0.f);
+    case ActivationType::kActivationRelu6: return std::min(std::max(value, 0.f), 6.f);
+    case ActivationType::kActivationSigmoid: return 1.f / (1.f + std::exp(-value));
+    default: return value;
+    }
+}
+
+inline void
+apply_activation(ActivationType type, float *data, uint32_t size)
+{
+    switch (type) {
+    case ActivationType::kActivationRelu: {
+#pragma omp simd
+        for (uint32_t i = 0; i < size; i++) {
+            data[i] = std::max(data[i], 0.f);
+        }
+        break;
+    }
+    case ActivationType::kActivationRelu6: {
+#pragma omp simd
+        for (uint32_t i = 0; i < size; i++) {
+            data[i] = std::min(std::max(data[i], 0.f), 6.f);
+        }
+        break;
+    }
+    case ActivationType::kActivationSigmoid: {
+        for (uint32_t i = 0; i < size; i++) {
+            data[i] = 1.f / (1.f + std::exp(-data[i]));
+        }
+        break;
+    }
+    default: break;
+    }
+}
+
+}// namespace jinfer
+
+#endif//_ACTIVATION_HPP_
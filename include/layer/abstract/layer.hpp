@@ -0,0 +1,91 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _LAYER_HPP_
+#define _LAYER_HPP_
+
+#include "data/tensor.hpp"
+#include "runtime/runtime_operator.hpp"
+#include "status_code.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jinfer
+{
+
+/// 层只与形状有关的预计算数据，例如插值的索引表，随内存规划按输入形状缓存，推理时只读
+struct LayerPlan {
+    virtual ~LayerPlan() = default;
+};
+
+class Layer
+{
+public:
+    explicit Layer(std::string layer_name);
+
+    virtual ~Layer() = default;
+
+    /**
+     * 从runtime_operator_的输入操作数中取出输入，计算结果写入输出操作数
+     * @return 推理状态
+     */
+    virtual InferStatus
+    forward();
+
+    /**
+     * 层的计算过程，outputs中的张量由计算图预先按形状分配好；
+     * 同一个层会被多个Session并发调用，实现中不能修改层自身的状态
+     * @param inputs 输入张量，按批次排列
+     * @param outputs 输出张量，按批次排列
+     * @return 推理状态
+     */
+    virtual InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs);
+
+    /**
+     * 带预计算数据的计算过程，计算图和Session传入内存规划中这个节点的LayerPlan；默认忽略plan
+     * @param plan create_plan的结果，可以为nullptr
+     */
+    virtual InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs,
+            const LayerPlan *plan);
+
+    /**
+     * 为一组输入输出形状预先计算只与形状有关的数据，在创建内存规划时调用，默认不需要
+     * @param input_shapes 带批次维度的输入形状
+     * @param output_shapes 带批次维度的输出形状
+     * @return 预计算数据，不需要时返回nullptr
+     */
+    virtual std::shared_ptr<const LayerPlan>
+    create_plan(const std::vector<std::vector<int>> &input_shapes,
+                const std::vector<std::vector<int>> &output_shapes) const;
+
+    /**
+     * 多输出层的计算过程，如torch.chunk，默认不支持
+     * @param inputs 输入张量，按批次排列
+     * @param outputs 与output_operands一一对应的输出张量，各自按批次排列并已按形状分配；
+     *                层可以把其中的张量替换为输入的视图，不复制数据
+     * @return 推理状态
+     */
+    virtual InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            const std::vector<std::vector<std::shared_ptr<Tensor<float>>> *> &outputs);
+
+    const std::string &
+    layer_name() const;
+
+    void
+    set_runtime_operator(const std::shared_ptr<RuntimeOperator> &runtime_operator);
+
+protected:
+    std::string layer_name_;
+    std::weak_ptr<RuntimeOperator> runtime_operator_;
+};
+
+}// namespace jinfer
+
+#endif//_LAYER_HPP_
@@ -0,0 +1,65 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _LAYER_FACTORY_HPP_
+#define _LAYER_FACTORY_HPP_
+
+#include "layer.hpp"
+#include "runtime/runtime_operator.hpp"
+#include "status_code.hpp"
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace jinfer
+{
+
+class LayerRegisterer
+{
+public:
+    using Creator = std::function<ParseParameterAttrStatus(const std::shared_ptr<RuntimeOperator> &,
+                                                           std::shared_ptr<Layer> &)>;
+    using CreateRegistry = std::map<std::string, Creator>;
+
+    /**
+     * 注册算子类型对应的层创建函数
+     * @param layer_type 算子类型，例如nn.ReLU
+     * @param creator 层创建函数
+     */
+    static void
+    register_creator(const std::string &layer_type, const Creator &creator);
+
+    /**
+     * 根据计算图节点的类型创建对应的层
+     * @param op 计算图节点
+     * @param status 解析参数和权重的状态，类型未注册时为kParameterMissingUnknown
+     * @return 创建的层，类型未注册或创建失败时返回nullptr
+     */
+    static std::shared_ptr<Layer>
+    create_layer(const std::shared_ptr<RuntimeOperator> &op, ParseParameterAttrStatus &status);
+
+    static bool
+    has_creator(const std::string &layer_type);
+
+    static CreateRegistry &
+    registry();
+};
+
+/**
+ * 在层的源文件中定义静态对象完成注册；
+ * 链接静态库libjinfer.a时需要保留全部目标文件(见CMakeLists中的jinfer_link_runtime)，否则注册会被丢弃
+ */
+class LayerRegistererWrapper
+{
+public:
+    LayerRegistererWrapper(const std::string &layer_type, const LayerRegisterer::Creator &creator)
+    {
+        LayerRegisterer::register_creator(layer_type, creator);
+    }
+};
+
+}// namespace jinfer
+
+#endif//_LAYER_FACTORY_HPP_
@@ -0,0 +1,39 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _PARAM_LAYER_HPP_
+#define _PARAM_LAYER_HPP_
+
+#include "layer.hpp"
+#include <vector>
+
+namespace jinfer
+{
+
+/// 带有权重和偏置的层，权重按pytorch中的存储顺序(行主序)连续存放
+class ParamLayer: public Layer
+{
+public:
+    explicit ParamLayer(std::string layer_name);
+
+    virtual void
+    set_weights(const std::vector<float> &weights);
+
+    virtual void
+    set_bias(const std::vector<float> &bias);
+
+    const std::vector<float> &
+    weights() const;
+
+    const std::vector<float> &
+    bias() const;
+
+protected:
+    std::vector<float> weights_;
+    std::vector<float> bias_;
+};
+
+}// namespace jinfer
+
+#endif//_PARAM_LAYER_HPP_
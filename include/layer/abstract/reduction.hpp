@@ -0,0 +1,88 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _REDUCTION_HPP_
+#define _REDUCTION_HPP_
+
+#include "runtime/runtime_operator.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jinfer
+{
+
+/**
+ * 沿张量的一个维度计算时把张量看作[outer][length][inner]三层嵌套，
+ * 张量的单个通道是列主序矩阵，内存中由外到内依次为channels、cols、rows
+ */
+struct AxisSplit {
+    uint32_t outer = 1;
+    uint32_t length = 1;
+    uint32_t inner = 1;/// 该维度上相邻两个元素的间隔，为1时该维度连续存放
+};
+
+/**
+ * 逻辑维度转换为张量的维度，与RuntimeGraph::init_data一致，逻辑形状不足4维时在张量前面补1
+ * @param dim 逻辑维度，负数从末尾计数，0为批次维度
+ * @param rank 带批次维度的逻辑形状的维数，2到4
+ * @return 张量的维度，0为channels，1为rows，2为cols；维度无效或为批次维度时返回-1
+ */
+inline int
+tensor_axis_of(int dim, int rank)
+{
+    if (rank < 2 || rank > 4) {
+        return -1;
+    }
+    if (dim < 0) {
+        dim += rank;
+    }
+    if (dim <= 0 || dim >= rank) {
+        return -1;
+    }
+    return dim - 1 + (4 - rank);
+}
+
+inline AxisSplit
+split_axis(uint32_t channels, uint32_t rows, uint32_t cols, int axis)
+{
+    switch (axis) {
+    case 0: return {1, channels, rows * cols};
+    case 1: return {channels * cols, rows, 1};
+    default: return {channels, cols, rows};
+    }
+}
+
+/**
+ * 读取维度或形状参数，pnnx中只有一个值时可能为整数，多个值时为整数数组
+ * @return 参数不存在或为空时返回false
+ */
+inline bool
+get_int_list(const std::shared_ptr<RuntimeOperator> &op, const std::string &name, std::vector<int> &values)
+{
+    if (auto array = op->get_param<RuntimeParameterIntArray>(name)) {
+        values = array->value;
+        return !values.empty();
+    }
+    if (auto value = op->get_param<RuntimeParameterInt>(name)) {
+        values = {value->value};
+        return true;
+    }
+    return false;
+}
+
+/// 节点第一个输入操作数的逻辑维数，没有输入时返回0
+inline int
+input_rank_of(const std::shared_ptr<RuntimeOperator> &op)
+{
+    if (op->input_operands_seq.empty() || !op->input_operands_seq.front()) {
+        return 0;
+    }
+    return int(op->input_operands_seq.front()->shape.size());
+}
+
+}// namespace jinfer
+
+#endif//_REDUCTION_HPP_
@@ -0,0 +1,34 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _ADAPTIVE_AVGPOOLING_HPP_
+#define _ADAPTIVE_AVGPOOLING_HPP_
+
+#include "layer/abstract/layer.hpp"
+
+namespace jinfer
+{
+
+/// nn.AdaptiveAvgPool2d，输出为(1, 1)时即全局平均池化
+class AdaptiveAvgPoolingLayer: public Layer
+{
+public:
+    AdaptiveAvgPoolingLayer(uint32_t output_h, uint32_t output_w);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &avgpooling_layer);
+
+private:
+    /// 为0时表示与输入大小相同
+    uint32_t output_h_;
+    uint32_t output_w_;
+};
+
+}// namespace jinfer
+
+#endif//_ADAPTIVE_AVGPOOLING_HPP_
@@ -0,0 +1,47 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _BATCHNORM_HPP_
+#define _BATCHNORM_HPP_
+
+#include "layer/abstract/param_layer.hpp"
+
+namespace jinfer
+{
+
+/**
+ * nn.BatchNorm1d / nn.BatchNorm2d，y = x * scale + shift，
+ * 每个通道的scale和shift在创建时由running_mean、running_var、weight、bias算好，分别保存为层的权重和偏置；
+ * 大部分BatchNorm在构建时已经折叠进前一个卷积或线性层，只有无法折叠的才会创建这个层
+ */
+class BatchNormLayer: public ParamLayer
+{
+public:
+    /// @param channel_axis 通道所在的张量维度，0为channels，1为rows，2为cols
+    BatchNormLayer(uint32_t num_features, int channel_axis);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    /**
+     * 计算每个通道的scale = gamma / sqrt(running_var + eps)和shift = beta - running_mean * scale，
+     * affine为False时gamma为1，beta为0
+     * @param need_clear_weight 读取后是否释放BatchNorm的原始权重
+     */
+    static ParseParameterAttrStatus
+    scale_shift(const std::shared_ptr<RuntimeOperator> &op, std::vector<float> &scale, std::vector<float> &shift,
+                bool need_clear_weight = true);
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &batchnorm_layer);
+
+private:
+    uint32_t num_features_;
+    int channel_axis_;
+};
+
+}// namespace jinfer
+
+#endif//_BATCHNORM_HPP_
@@ -0,0 +1,39 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _CONCAT_HPP_
+#define _CONCAT_HPP_
+
+#include "layer/abstract/layer.hpp"
+
+namespace jinfer
+{
+
+/**
+ * torch.cat，按输入顺序沿一个维度拼接；
+ * 内存规划可以让前驱节点直接把结果写入输出中对应的一段，这样的输入已在原位，不再复制
+ */
+class ConcatLayer: public Layer
+{
+public:
+    /// @param axis 张量的维度，0为channels，1为rows，2为cols
+    explicit ConcatLayer(int axis);
+
+    /**
+     * @param inputs 各个输入操作数的数据依次排列，每个操作数的批次与outputs相同
+     */
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &concat_layer);
+
+private:
+    int axis_;
+};
+
+}// namespace jinfer
+
+#endif//_CONCAT_HPP_
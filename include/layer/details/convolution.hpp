@@ -0,0 +1,128 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _CONVOLUTION_HPP_
+#define _CONVOLUTION_HPP_
+
+#include "layer/abstract/activation.hpp"
+#include "layer/abstract/param_layer.hpp"
+
+namespace jinfer
+{
+
+/**
+ * nn.Conv2d，im2col + GEMM，矩阵乘法使用仓库内的sgemm，不依赖系统的BLAS
+ * 填充只在im2col展开时以0写入，输入的张量不会被复制成填充后的张量；
+ * 1x1、步长为1且无填充的卷积直接把输入当作展开后的矩阵；
+ * groups与输入通道数相同时每个输出通道只依赖一个输入通道，不展开，按通道并行直接卷积；
+ * 布局传播标记为NCHW8c时改为直接卷积，每次计算同一位置的8个输出通道
+ */
+class ConvolutionLayer: public ParamLayer
+{
+public:
+    ConvolutionLayer(uint32_t in_channels, uint32_t out_channels,
+                     uint32_t kernel_h, uint32_t kernel_w,
+                     uint32_t stride_h, uint32_t stride_w,
+                     uint32_t padding_h, uint32_t padding_w,
+                     uint32_t dilation_h = 1, uint32_t dilation_w = 1,
+                     uint32_t groups = 1, bool use_bias = true);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    void
+    set_weights(const std::vector<float> &weights) override;
+
+    void
+    set_bias(const std::vector<float> &bias) override;
+
+    /// 融合的激活函数，在加偏置的同时计算
+    void
+    set_activation(ActivationType activation);
+
+    ActivationType
+    activation() const;
+
+    /**
+     * 输入输出按NCHW8c布局存放，只支持groups为1的卷积，权重会重排成[out_block][in][kernel_h][kernel_w][8]
+     * @param blocked 是否为NCHW8c布局
+     */
+    void
+    set_blocked_layout(bool blocked);
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &conv_layer);
+
+private:
+    bool
+    is_pointwise() const;
+
+    /// groups与输入通道数相同且大于1，每个输出通道由一个输入通道计算，输出通道数可以是输入的整数倍
+    bool
+    is_depthwise() const;
+
+    /**
+     * 把一组输入通道展开成列主序的(output_rows * output_cols) x (channels * kernel_h * kernel_w)矩阵
+     * 每一列按输出位置分成上下边界和内部三段，边界部分直接写0
+     */
+    void
+    im2col(const float *input, uint32_t rows, uint32_t cols,
+           uint32_t output_rows, uint32_t output_cols, float *col) const;
+
+    InferStatus
+    forward_depthwise(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                      std::vector<std::shared_ptr<Tensor<float>>> &outputs) const;
+
+    /**
+     * 计算一个depthwise输出通道：输出列先写入偏置，再把每个卷积核位置对应的输入列按权重累加上去，
+     * 列沿rows连续存放，最内层沿输出行向量化，最后在同一列上计算激活函数
+     * @tparam kernel 卷积核为kernel x kernel时在编译期确定循环次数，为0时使用kernel_h_和kernel_w_
+     * @param weights 该输出通道的kernel_h x kernel_w个权重
+     */
+    template<uint32_t kernel>
+    void
+    depthwise_channel(const float *input, uint32_t rows, uint32_t cols,
+                      const float *weights, float bias,
+                      float *output, uint32_t output_rows, uint32_t output_cols) const;
+
+    InferStatus
+    forward_blocked(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                    std::vector<std::shared_ptr<Tensor<float>>> &outputs) const;
+
+    /**
+     * 计算一组8个输出通道在一个输出列上的结果
+     * @param input NCHW8c布局的输入
+     * @param output 输出列的起始地址，每个输出行占8个连续元素
+     */
+    void
+    conv_blocked_column(const float *input, uint32_t rows, uint32_t cols,
+                        uint32_t out_block, uint32_t ow,
+                        float *output, uint32_t output_rows) const;
+
+    void
+    pack_blocked_weights();
+
+    uint32_t in_channels_;
+    uint32_t out_channels_;
+    uint32_t kernel_h_;
+    uint32_t kernel_w_;
+    uint32_t stride_h_;
+    uint32_t stride_w_;
+    uint32_t padding_h_;
+    uint32_t padding_w_;
+    uint32_t dilation_h_;
+    uint32_t dilation_w_;
+    uint32_t groups_;
+    bool use_bias_;
+    ActivationType activation_ = ActivationType::kActivationNone;
+
+    bool blocked_ = false;
+    std::vector<float> blocked_weights_;
+    std::vector<float> blocked_bias_;/// 补齐到8的倍数，无偏置时全为0
+};
+
+}// namespace jinfer
+
+#endif//_CONVOLUTION_HPP_
@@ -0,0 +1,74 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _DECONVOLUTION_HPP_
+#define _DECONVOLUTION_HPP_
+
+#include "layer/abstract/param_layer.hpp"
+
+namespace jinfer
+{
+
+/**
+ * nn.ConvTranspose2d，GEMM + col2im：
+ * 先用一次矩阵乘法求出每个输入位置对每个(输出通道, kh, kw)的贡献，写入列缓冲区，
+ * 再把列缓冲区按输出通道并行地累加到输出上，每个线程只写自己的输出通道，不需要原子操作
+ */
+class DeconvolutionLayer: public ParamLayer
+{
+public:
+    DeconvolutionLayer(uint32_t in_channels, uint32_t out_channels,
+                       uint32_t kernel_h, uint32_t kernel_w,
+                       uint32_t stride_h, uint32_t stride_w,
+                       uint32_t padding_h, uint32_t padding_w,
+                       uint32_t output_padding_h = 0, uint32_t output_padding_w = 0,
+                       uint32_t dilation_h = 1, uint32_t dilation_w = 1,
+                       uint32_t groups = 1, bool use_bias = true);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    /**
+     * 权重按pytorch的(in_channels, out_channels / groups, kernel_h, kernel_w)存放，
+     * 每组重排成列主序的(in_channels / groups) x (out_channels / groups * kernel_h * kernel_w)矩阵，只保存重排后的权重
+     */
+    void
+    set_weights(const std::vector<float> &weights) override;
+
+    void
+    set_bias(const std::vector<float> &bias) override;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &deconv_layer);
+
+private:
+    /**
+     * 把列缓冲区累加到一个输出通道上，输出通道先写入偏置
+     * @param col 该输出通道的kernel_h * kernel_w列，每列是所有输入位置的贡献，按输入的内存顺序排列
+     */
+    void
+    col2im(const float *col, uint32_t rows, uint32_t cols, float bias,
+           float *output, uint32_t output_rows, uint32_t output_cols) const;
+
+    uint32_t in_channels_;
+    uint32_t out_channels_;
+    uint32_t kernel_h_;
+    uint32_t kernel_w_;
+    uint32_t stride_h_;
+    uint32_t stride_w_;
+    uint32_t padding_h_;
+    uint32_t padding_w_;
+    uint32_t output_padding_h_;
+    uint32_t output_padding_w_;
+    uint32_t dilation_h_;
+    uint32_t dilation_w_;
+    uint32_t groups_;
+    bool use_bias_;
+    std::vector<float> packed_weights_;
+};
+
+}// namespace jinfer
+
+#endif//_DECONVOLUTION_HPP_
@@ -0,0 +1,62 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _LAYER_NORM_HPP_
+#define _LAYER_NORM_HPP_
+
+#include "layer/abstract/param_layer.hpp"
+
+namespace jinfer
+{
+
+/**
+ * nn.LayerNorm，对最后len(normalized_shape)个维度归一化，均值和方差由Welford算法一遍求出；
+ * 只归一化最后一维时该维度不连续，一次处理kTileWidth个交错的行，
+ * 归一化多个维度时它们在内存中连续，按kLanes路分别累加后合并
+ */
+class LayerNormLayer: public ParamLayer
+{
+public:
+    static constexpr uint32_t kTileWidth = 64;
+    static constexpr uint32_t kLanes = 8;
+
+    /**
+     * @param normalized_shape 归一化的维度，1到3维
+     * @param eps 加到方差上的常数
+     * @param elementwise_affine 是否有逐元素的缩放和偏移
+     */
+    LayerNormLayer(std::vector<uint32_t> normalized_shape, float eps, bool elementwise_affine);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    /// 权重按normalized_shape的行主序给出，保存时重排成张量的内存顺序
+    void
+    set_weights(const std::vector<float> &weights) override;
+
+    void
+    set_bias(const std::vector<float> &bias) override;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &layer_norm_layer);
+
+private:
+    /// 行主序的第index个元素在张量内存中相对于归一化区域起点的偏移
+    size_t
+    physical_index(size_t index) const;
+
+    std::vector<float>
+    to_physical(const std::vector<float> &values) const;
+
+    std::vector<uint32_t> normalized_shape_;/// 补齐到3维，与张量的(channels, rows, cols)对应
+    uint32_t normalized_dims_;
+    uint32_t normalized_size_;
+    float eps_;
+    bool elementwise_affine_;
+};
+
+}// namespace jinfer
+
+#endif//_LAYER_NORM_HPP_
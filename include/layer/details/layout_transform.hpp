@@ -0,0 +1,66 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _LAYOUT_TRANSFORM_HPP_
+#define _LAYOUT_TRANSFORM_HPP_
+
+#include "layer/abstract/layer.hpp"
+
+namespace jinfer
+{
+
+/// NCHW8c布局中每组的通道数
+constexpr uint32_t kChannelBlock = 8;
+
+/// 构建时布局传播在节点参数layout中写入该值，对应的层按NCHW8c布局计算
+constexpr const char *kBlockedLayoutName = "NCHW8c";
+
+inline uint32_t
+channel_blocks(uint32_t channels)
+{
+    return (channels + kChannelBlock - 1) / kChannelBlock;
+}
+
+/**
+ * 布局传播在NCHW和NCHW8c区域的边界插入的转换节点，类型为jinfer.ToBlocked或jinfer.ToPlanar；
+ * 转成NCHW8c时末尾不满8个的通道补0
+ */
+class LayoutTransformLayer: public Layer
+{
+public:
+    explicit LayoutTransformLayer(bool to_blocked);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    /**
+     * NCHW转成NCHW8c
+     * @param input 形状为(C, H, W)的张量
+     * @param output 形状为(ceil(C / 8), H * 8, W)的张量
+     */
+    static void
+    to_blocked(const Tensor<float> &input, Tensor<float> &output);
+
+    /**
+     * NCHW8c转成NCHW，补齐的通道被丢弃
+     * @param input 形状为(ceil(C / 8), H * 8, W)的张量
+     * @param output 形状为(C, H, W)的张量
+     */
+    static void
+    to_planar(const Tensor<float> &input, Tensor<float> &output);
+
+    static ParseParameterAttrStatus
+    create_blocked_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &layout_layer);
+
+    static ParseParameterAttrStatus
+    create_planar_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &layout_layer);
+
+private:
+    bool to_blocked_;
+};
+
+}// namespace jinfer
+
+#endif//_LAYOUT_TRANSFORM_HPP_
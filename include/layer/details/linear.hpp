@@ -0,0 +1,74 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _LINEAR_HPP_
+#define _LINEAR_HPP_
+
+#include "layer/abstract/activation.hpp"
+#include "layer/abstract/param_layer.hpp"
+
+namespace jinfer
+{
+
+/**
+ * nn.Linear，y = x * W^T + b
+ * 权重在创建时按输出特征每kPanelWidth个打包成一个面板，面板内按输入特征交错存放，
+ * 只有一行输入时走GEMV，否则以kTileRows行为一块做GEMM，偏置和激活在写回时完成
+ */
+class LinearLayer: public ParamLayer
+{
+public:
+    static constexpr uint32_t kPanelWidth = 16;
+    static constexpr uint32_t kTileRows = 4;
+
+    LinearLayer(uint32_t in_features, uint32_t out_features, bool use_bias = true);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    /// 只保存打包后的权重，不保留原始的行主序权重
+    void
+    set_weights(const std::vector<float> &weights) override;
+
+    void
+    set_bias(const std::vector<float> &bias) override;
+
+    void
+    set_activation(ActivationType activation);
+
+    ActivationType
+    activation() const;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &linear_layer);
+
+private:
+    /// 一行输入及其输出的位置，stride是相邻特征之间的距离
+    struct Row {
+        const float *input;
+        float *output;
+        uint32_t input_stride;
+        uint32_t output_stride;
+    };
+
+    void
+    gemv(const Row &row) const;
+
+    void
+    gemm(const std::vector<Row> &rows) const;
+
+    void
+    store(const float *acc, uint32_t panel, const Row &row) const;
+
+    uint32_t in_features_;
+    uint32_t out_features_;
+    bool use_bias_;
+    ActivationType activation_ = ActivationType::kActivationNone;
+    std::vector<float> packed_weights_;
+};
+
+}// namespace jinfer
+
+#endif//_LINEAR_HPP_
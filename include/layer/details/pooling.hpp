@@ -0,0 +1,78 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _POOLING_HPP_
+#define _POOLING_HPP_
+
+#include "layer/abstract/layer.hpp"
+
+namespace jinfer
+{
+
+enum class PoolingType
+{
+    kMaxPooling = 0,
+    kAvgPooling = 1,
+};
+
+/**
+ * nn.MaxPool2d和nn.AvgPool2d，直接在张量的连续内存上计算
+ * 先把窗口覆盖的各个输入列逐元素归约成一列，再沿行方向归约，越界部分视为填充，不生成填充后的张量
+ */
+class PoolingLayer: public Layer
+{
+public:
+    PoolingLayer(PoolingType pooling_type,
+                 uint32_t kernel_h, uint32_t kernel_w,
+                 uint32_t stride_h, uint32_t stride_w,
+                 uint32_t padding_h, uint32_t padding_w,
+                 uint32_t dilation_h = 1, uint32_t dilation_w = 1,
+                 bool ceil_mode = false, bool count_include_pad = true);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    /**
+     * 输入输出按NCHW8c布局存放，此时每个位置的8个通道连续，归约时一并向量化
+     * @param blocked 是否为NCHW8c布局
+     */
+    void
+    set_blocked_layout(bool blocked);
+
+    static ParseParameterAttrStatus
+    create_max_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &pooling_layer);
+
+    static ParseParameterAttrStatus
+    create_avg_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &pooling_layer);
+
+private:
+    /**
+     * 计算单个通道(NCHW8c布局时为一组8个通道)的池化
+     * @param rows 逻辑行数
+     * @param column 长度为逻辑行数乘以lanes_的临时缓冲区，存放窗口内各输入列的归约结果
+     */
+    void
+    pooling_channel(const float *input, uint32_t rows, uint32_t cols,
+                    float *output, uint32_t output_rows, uint32_t output_cols,
+                    float *column) const;
+
+    uint32_t lanes_ = 1;/// 每个位置连续存放的通道数，NCHW为1，NCHW8c为8
+
+    PoolingType pooling_type_;
+    uint32_t kernel_h_;
+    uint32_t kernel_w_;
+    uint32_t stride_h_;
+    uint32_t stride_w_;
+    uint32_t padding_h_;
+    uint32_t padding_w_;
+    uint32_t dilation_h_;
+    uint32_t dilation_w_;
+    bool ceil_mode_;
+    bool count_include_pad_;
+};
+
+}// namespace jinfer
+
+#endif//_POOLING_HPP_
@@ -0,0 +1,64 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _REDUCE_HPP_
+#define _REDUCE_HPP_
+
+#include "layer/abstract/layer.hpp"
+#include <array>
+
+namespace jinfer
+{
+
+enum class ReduceType
+{
+    kReduceSum = 0,
+    kReduceMean = 1,
+    kReduceMax = 2,
+    kReduceMin = 3,
+};
+
+/**
+ * torch.sum / torch.mean / torch.amax / torch.amin，可以同时归约多个维度，不支持归约批次维度；
+ * 按内存顺序逐列读取输入，rows未被归约时整列向量化累加到结果中，否则先在列内做向量化的归约
+ */
+class ReduceLayer: public Layer
+{
+public:
+    /**
+     * @param type 归约方式
+     * @param dims 归约的逻辑维度，负数从末尾计数
+     * @param rank 带批次维度的输入逻辑形状的维数，2到4
+     * @param keepdim 是否保留被归约的维度
+     */
+    ReduceLayer(ReduceType type, const std::vector<int> &dims, int rank, bool keepdim);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    static ParseParameterAttrStatus
+    create_sum_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &reduce_layer);
+
+    static ParseParameterAttrStatus
+    create_mean_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &reduce_layer);
+
+    static ParseParameterAttrStatus
+    create_max_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &reduce_layer);
+
+    static ParseParameterAttrStatus
+    create_min_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &reduce_layer);
+
+private:
+    void
+    reduce_column(const float *input, uint32_t rows, float *acc) const;
+
+    ReduceType reduce_type_;
+    std::array<bool, 3> reduced_{};/// 张量的各个维度是否被归约
+    std::array<int, 3> output_axes_{};/// 未被归约的维度在输出张量中的维度，被归约或补齐的维度为-1
+};
+
+}// namespace jinfer
+
+#endif//_REDUCE_HPP_
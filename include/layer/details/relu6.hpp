@@ -0,0 +1,30 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _RELU6_HPP_
+#define _RELU6_HPP_
+
+#include "layer/abstract/layer.hpp"
+
+namespace jinfer
+{
+
+class Relu6Layer: public Layer
+{
+public:
+    Relu6Layer() : Layer("ReLU6")
+    {
+    }
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &relu6_layer);
+};
+
+}// namespace jinfer
+
+#endif//_RELU6_HPP_
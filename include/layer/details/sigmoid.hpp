@@ -0,0 +1,30 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _SIGMOID_HPP_
+#define _SIGMOID_HPP_
+
+#include "layer/abstract/layer.hpp"
+
+namespace jinfer
+{
+
+class SigmoidLayer: public Layer
+{
+public:
+    SigmoidLayer() : Layer("Sigmoid")
+    {
+    }
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &sigmoid_layer);
+};
+
+}// namespace jinfer
+
+#endif//_SIGMOID_HPP_
@@ -0,0 +1,62 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _SLICE_HPP_
+#define _SLICE_HPP_
+
+#include "layer/abstract/layer.hpp"
+#include <array>
+#include <climits>
+
+namespace jinfer
+{
+
+/// Tensor.slice在一个维度上的start、end、step，负数从末尾计数，超出范围时截断，与Python的切片规则相同
+struct SliceRange {
+    int start = 0;
+    int end = INT_MAX;
+    int step = 1;
+
+    /**
+     * 在长度为length的维度上切片
+     * @param offset 第一个元素的位置
+     * @param size 切出的长度
+     * @return step不是正数或切出的长度为0时返回false
+     */
+    bool
+    resolve(int length, int &offset, int &size) const;
+
+    /**
+     * 读取dims/starts/ends/steps，旧版本的pnnx只切一个维度，参数为dim/start/end/step
+     * @param dims 逻辑维度，与ranges一一对应
+     * @return 参数缺失、个数不一致，或start、end是输入操作数时返回false
+     */
+    static bool
+    parse(const std::shared_ptr<RuntimeOperator> &op, std::vector<int> &dims, std::vector<SliceRange> &ranges);
+};
+
+/**
+ * Tensor.slice，各维度的step都为1且切出的部分在输入中连续存放时，输出直接作为输入的视图，不复制数据；
+ * 其余情况逐列复制，张量只能表示连续的内存，step大于1时无法作为视图
+ */
+class SliceLayer: public Layer
+{
+public:
+    /// @param ranges 张量channels、rows、cols三个维度上的切片，不切的维度使用默认值
+    explicit SliceLayer(const std::array<SliceRange, 3> &ranges);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &slice_layer);
+
+private:
+    std::array<SliceRange, 3> ranges_;
+};
+
+}// namespace jinfer
+
+#endif//_SLICE_HPP_
@@ -0,0 +1,38 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _SOFTMAX_HPP_
+#define _SOFTMAX_HPP_
+
+#include "layer/abstract/layer.hpp"
+
+namespace jinfer
+{
+
+/**
+ * nn.Softmax / F.softmax，先求最大值，再在同一遍中求exp(x - max)并累加，最后乘以和的倒数；
+ * 归约的维度连续存放时逐行向量化，否则一次处理kTileWidth个交错的行，沿连续的方向向量化
+ */
+class SoftmaxLayer: public Layer
+{
+public:
+    static constexpr uint32_t kTileWidth = 64;
+
+    /// @param axis 张量的维度，0为channels，1为rows，2为cols
+    explicit SoftmaxLayer(int axis);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &softmax_layer);
+
+private:
+    int axis_;
+};
+
+}// namespace jinfer
+
+#endif//_SOFTMAX_HPP_
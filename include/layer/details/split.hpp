@@ -0,0 +1,67 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _SPLIT_HPP_
+#define _SPLIT_HPP_
+
+#include "layer/abstract/layer.hpp"
+
+namespace jinfer
+{
+
+/// torch.chunk按块数、torch.split按每段长度或各段长度切分一个维度，三者只有一个有效
+struct SplitSections {
+    int chunks = 0;
+    int split_size = 0;
+    std::vector<int> sizes;
+
+    /// 长度为length的维度能否按参数切分，各段长度之和必须等于length
+    bool
+    valid(int length) const;
+
+    /// 长度为length的维度切分出的段数，torch.chunk在不能整除时可能少于chunks
+    int
+    count(int length) const;
+
+    /// 第index段的起始位置和长度
+    void
+    piece(int index, int length, int &offset, int &size) const;
+
+    /**
+     * 从torch.chunk的chunks或torch.split的split_size_or_sections读取
+     * @return 参数缺失或不是正数时返回false
+     */
+    static bool
+    parse(const std::shared_ptr<RuntimeOperator> &op, SplitSections &sections);
+};
+
+/**
+ * torch.chunk / torch.split，每一段是一个输出操作数；
+ * 被切分的维度之外只有批次时，每一段在输入中连续存放，输出直接作为输入的视图，不复制数据
+ */
+class SplitLayer: public Layer
+{
+public:
+    /// @param axis 张量的维度，0为channels，1为rows，2为cols
+    SplitLayer(int axis, SplitSections sections);
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            const std::vector<std::vector<std::shared_ptr<Tensor<float>>> *> &outputs) override;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &split_layer);
+
+private:
+    int axis_;
+    SplitSections sections_;
+};
+
+}// namespace jinfer
+
+#endif//_SPLIT_HPP_
@@ -0,0 +1,111 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _UPSAMPLE_HPP_
+#define _UPSAMPLE_HPP_
+
+#include "layer/abstract/layer.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace jinfer
+{
+
+enum class ResizeMode {
+    kResizeNearest = 0,
+    kResizeBilinear = 1,
+};
+
+/// nn.Upsample和F.interpolate的参数，size和scale_factor只有一个生效
+struct ResizeParam {
+    ResizeMode mode = ResizeMode::kResizeNearest;
+    bool align_corners = false;
+    int output_h = -1;
+    int output_w = -1;
+    float scale_h = 0.f;
+    float scale_w = 0.f;
+
+    /**
+     * 由输入大小计算输出大小，与pytorch一致，给定scale_factor时输出为floor(in * scale_factor)
+     * @return 输出大小不是正数时返回false
+     */
+    bool
+    output_size(int input_h, int input_w, int &out_h, int &out_w) const;
+
+    /**
+     * 读取mode/align_corners/size/scale_factor，nn.UpsamplingNearest2d和nn.UpsamplingBilinear2d没有mode参数，由算子类型决定
+     */
+    static ParseParameterAttrStatus
+    parse(const std::shared_ptr<RuntimeOperator> &op, ResizeParam &param);
+};
+
+/**
+ * 一个维度上每个输出位置对应的输入位置，双线性插值时输出由index0和index1两处的输入按lambda加权，
+ * 最近邻插值只使用index0；表只与输入输出的大小有关，同一形状的所有通道共用
+ */
+struct ResizeTable {
+    uint32_t input_size = 0;
+    std::vector<uint32_t> index0;
+    std::vector<uint32_t> index1;
+    std::vector<float> lambda;
+
+    static ResizeTable
+    build(const ResizeParam &param, uint32_t input_size, uint32_t output_size, float scale);
+};
+
+/// 一组输入输出大小对应的行、列索引表，随内存规划缓存
+struct ResizePlan: public LayerPlan {
+    ResizeTable row_table;
+    ResizeTable col_table;
+};
+
+/**
+ * nn.Upsample / F.interpolate，支持nearest和bilinear；
+ * 索引表只与输入输出大小有关，所有通道共用；创建内存规划时按形状计算好，
+ * 通过plan传给forward，层本身不保存任何与形状有关的状态
+ */
+class UpsampleLayer: public Layer
+{
+public:
+    explicit UpsampleLayer(const ResizeParam &param);
+
+    /// 没有内存规划时调用，按实际形状临时计算索引表
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs) override;
+
+    /// plan与实际形状不符或为nullptr时临时计算索引表
+    InferStatus
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+            std::vector<std::shared_ptr<Tensor<float>>> &outputs,
+            const LayerPlan *plan) override;
+
+    /// 输入输出为四维时计算行、列的索引表
+    std::shared_ptr<const LayerPlan>
+    create_plan(const std::vector<std::vector<int>> &input_shapes,
+                const std::vector<std::vector<int>> &output_shapes) const override;
+
+    /// 计算给定输入输出大小的索引表
+    std::shared_ptr<const ResizePlan>
+    make_plan(uint32_t input_rows, uint32_t input_cols, uint32_t output_rows, uint32_t output_cols) const;
+
+    static ParseParameterAttrStatus
+    create_instance(const std::shared_ptr<RuntimeOperator> &op, std::shared_ptr<Layer> &upsample_layer);
+
+private:
+    void
+    resize_nearest(const ResizeTable &row_table, const ResizeTable &col_table,
+                   const float *input, float *output) const;
+
+    void
+    resize_bilinear(const ResizeTable &row_table, const ResizeTable &col_table,
+                    const float *input, float *output) const;
+
+    ResizeParam param_;
+};
+
+}// namespace jinfer
+
+#endif//_UPSAMPLE_HPP_
@@ -0,0 +1,62 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _GEMM_HPP_
+#define _GEMM_HPP_
+
+#include <cstdint>
+
+namespace jinfer
+{
+
+/// 矩阵乘法的微内核，运行时按cpu支持的指令集选择
+enum class GemmKernel {
+    kGemmScalar = 0,
+    kGemmAvx2 = 1,
+    kGemmAvx512 = 2,
+};
+
+/**
+ * 单精度矩阵乘法C = A * B，或者accumulate为true时C += A * B，所有矩阵均为列主序；
+ * 按BLIS的方式分块：B按KC x NC、A按MC x KC打包成连续的面板，再由寄存器分块的微内核计算每个MR x NR的小块，
+ * 小块之间用OpenMP并行，m或n很小的情况(例如后面几层卷积展开后的矩阵)同样可以并行
+ * @param m A和C的行数
+ * @param n B和C的列数
+ * @param k A的列数，B的行数
+ * @param a 矩阵A
+ * @param lda A的列间距，不小于m
+ * @param b 矩阵B
+ * @param ldb B的列间距，不小于k
+ * @param c 矩阵C
+ * @param ldc C的列间距，不小于m
+ * @param accumulate 是否累加到C原有的值上
+ */
+void
+sgemm(uint32_t m, uint32_t n, uint32_t k,
+      const float *a, uint32_t lda,
+      const float *b, uint32_t ldb,
+      float *c, uint32_t ldc,
+      bool accumulate = false);
+
+/**
+ * 当前cpu是否支持该微内核
+ */
+bool
+gemm_kernel_supported(GemmKernel kernel);
+
+/**
+ * 当前使用的微内核，默认为cpu支持的最宽的一个
+ */
+GemmKernel
+gemm_kernel();
+
+/**
+ * 指定使用的微内核，用于测试和性能对比，cpu不支持时返回false且不做修改
+ */
+bool
+set_gemm_kernel(GemmKernel kernel);
+
+}// namespace jinfer
+
+#endif//_GEMM_HPP_
@@ -0,0 +1,109 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _ARENA_HPP_
+#define _ARENA_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace jinfer
+{
+
+/**
+ * 单调增长的内存区域，按块向系统申请，分配时只移动指针，释放只在整个区域销毁时发生；
+ * 用于计算图初始化时创建的大量小对象，如操作数、参数和属性
+ */
+class Arena
+{
+public:
+    static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+    explicit Arena(size_t block_size = kDefaultBlockSize);
+
+    Arena(const Arena &) = delete;
+
+    Arena &
+    operator=(const Arena &) = delete;
+
+    void *
+    allocate(size_t size, size_t alignment);
+
+    /// 已向系统申请的字节数
+    size_t
+    reserved_bytes() const;
+
+    /// 已分配出去的字节数，包括对齐的填充
+    size_t
+    used_bytes() const;
+
+private:
+    mutable std::mutex mutex_;
+    size_t block_size_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char *cursor_ = nullptr;
+    char *end_ = nullptr;
+    size_t reserved_bytes_ = 0;
+    size_t used_bytes_ = 0;
+};
+
+/**
+ * 从Arena分配的标准库分配器，配合std::allocate_shared使用；
+ * 共享指针的控制块保存分配器的副本，因此区域在其中最后一个对象销毁后才会释放
+ */
+template<typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<Arena> arena) noexcept : arena_(std::move(arena))
+    {
+    }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena_(other.arena())
+    {
+    }
+
+    T *
+    allocate(size_t n)
+    {
+        return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void
+    deallocate(T *, size_t) noexcept
+    {
+    }
+
+    const std::shared_ptr<Arena> &
+    arena() const noexcept
+    {
+        return arena_;
+    }
+
+    template<typename U>
+    bool
+    operator==(const ArenaAllocator<U> &other) const noexcept
+    {
+        return arena_ == other.arena();
+    }
+
+    template<typename U>
+    bool
+    operator!=(const ArenaAllocator<U> &other) const noexcept
+    {
+        return arena_ != other.arena();
+    }
+
+private:
+    std::shared_ptr<Arena> arena_;
+};
+
+}// namespace jinfer
+
+#endif//_ARENA_HPP_
@@ -0,0 +1,120 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _BATCHING_SERVER_HPP_
+#define _BATCHING_SERVER_HPP_
+
+#include "mpmc_queue.hpp"
+#include "session.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jinfer
+{
+
+struct BatchingOptions {
+    /// 一次推理最多合并的请求数
+    uint32_t max_batch_size = 8;
+
+    /// 第一个请求到达后最多等待多久再开始推理
+    std::chrono::microseconds max_delay{1000};
+
+    /// 推理线程数，每个线程持有一个Session
+    uint32_t worker_num = 1;
+
+    /// 请求队列的容量，队列满时submit会自旋等待
+    size_t queue_capacity = 1024;
+};
+
+/**
+ * 进程内的动态批处理推理服务：多个线程通过submit提交单个样本，
+ * 推理线程把同一形状的请求合并成一个批次，批次满或者等待超时后执行一次推理，再通过future逐个返回结果
+ */
+class BatchingServer
+{
+public:
+    BatchingServer(std::shared_ptr<const CompiledModel> model, const BatchingOptions &options);
+
+    ~BatchingServer();
+
+    BatchingServer(const BatchingServer &) = delete;
+
+    BatchingServer &
+    operator=(const BatchingServer &) = delete;
+
+    /**
+     * 提交一个样本，可在多个线程中同时调用
+     * @param input 单个样本的输入张量，推理完成前不能修改
+     * @return 该样本的输出张量；输入不合法、服务已停止或这一批次推理失败时future中为异常
+     */
+    std::future<std::shared_ptr<Tensor<float>>>
+    submit(std::shared_ptr<Tensor<float>> input);
+
+    /**
+     * 处理完已提交的请求后停止推理线程，析构时自动调用
+     */
+    void
+    stop();
+
+    /**
+     * 已执行的推理次数
+     */
+    uint64_t
+    batches() const;
+
+    /**
+     * 已完成的请求数，与batches()的比值即平均批次大小
+     */
+    uint64_t
+    requests() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request {
+        std::shared_ptr<Tensor<float>> input;
+        std::promise<std::shared_ptr<Tensor<float>>> promise;
+        Clock::time_point arrival;
+    };
+
+    void
+    run();
+
+    /**
+     * 从队列中取出一个请求，队列为空时等待到deadline
+     * @return 超时或者服务已停止且队列为空时返回false
+     */
+    bool
+    pop_request(Request &request, const Clock::time_point *deadline);
+
+    void
+    forward_batch(Session &session, std::vector<Request> &batch);
+
+private:
+    std::shared_ptr<const CompiledModel> model_;
+    BatchingOptions options_;
+    MpmcQueue<Request> queue_;
+
+    /// 队列中的请求数以及正在等待的推理线程数，用于避免每次提交都唤醒
+    std::atomic<size_t> pending_{0};
+    std::atomic<uint32_t> waiting_{0};
+    /// 正在执行submit的线程数，停止后推理线程等它归零并取空队列才退出
+    std::atomic<size_t> submitting_{0};
+    std::atomic<bool> stopped_{false};
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cond_;
+
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::vector<std::thread> workers_;
+};
+
+}// namespace jinfer
+
+#endif//_BATCHING_SERVER_HPP_
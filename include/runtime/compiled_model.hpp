@@ -0,0 +1,110 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _COMPILED_MODEL_HPP_
+#define _COMPILED_MODEL_HPP_
+
+#include "runtime_ir.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace jinfer
+{
+
+/// 拓扑序列中的一个节点以及它的输入在拓扑序列中的位置
+struct CompiledOperator {
+    std::shared_ptr<RuntimeOperator> op;
+
+    /// 按input_operands_seq的顺序排列的输入在激活值中的下标
+    std::vector<size_t> input_indices;
+
+    /// 按output_operands的顺序排列的输出在激活值中的下标，第一个输出的下标即节点在拓扑序列中的位置
+    std::vector<size_t> output_indices;
+};
+
+/**
+ * 构建完成后不再修改的模型，持有权重、层、拓扑序列和按输入形状缓存的内存规划，
+ * 可以被多个线程中的Session共享，权重只保留一份；激活值由各个Session自己持有
+ */
+class CompiledModel
+{
+public:
+    /// 最多缓存的内存规划个数，超过后淘汰最久未使用的
+    static constexpr size_t kMaxMemoryPlans = 16;
+
+    /**
+     * 加载并构建计算图
+     * @param param_path 计算图的结构文件
+     * @param bin_path 计算图的权重文件
+     * @param input_name 输入节点名称
+     * @param output_name 输出节点名称，可以是中间节点，此时只保留计算它所需的节点
+     * @return 构建失败时返回nullptr
+     */
+    static std::shared_ptr<const CompiledModel>
+    compile(const std::string &param_path, const std::string &bin_path,
+            const std::string &input_name, const std::string &output_name);
+
+    const std::vector<CompiledOperator> &
+    operators() const;
+
+    /**
+     * 推理结果在激活值中的下标：pnnx.Output为它的输入，中间节点为它的第一个输出
+     */
+    size_t
+    output_index() const;
+
+    /**
+     * 会话需要的激活值个数：拓扑序列中每个节点的第一个输出依次占用前面的位置，多输出节点的其余输出排在之后
+     */
+    size_t
+    activation_count() const;
+
+    /**
+     * 由实际输入得到带批次维度的输入形状
+     * @param inputs 输入张量
+     * @param input_shape 输出的输入形状，复用其容量
+     * @return 输入为空或与模型的输入形状不符时返回false
+     */
+    bool
+    input_shape_of(const std::vector<std::shared_ptr<Tensor<float>>> &inputs, std::vector<int> &input_shape) const;
+
+    /**
+     * 获取输入形状对应的内存规划，不存在时推导并缓存，可在多个线程中同时调用
+     * @param input_shape 带批次维度的输入形状
+     * @return 内存规划，被淘汰后仍由持有者保持有效；形状推导失败时返回nullptr且不缓存
+     */
+    std::shared_ptr<const MemoryPlan>
+    memory_plan(const std::vector<int> &input_shape) const;
+
+    /**
+     * 会话分配激活张量所用的分配器，各会话共享，形状变化后释放的缓冲区可被其他会话复用
+     */
+    const std::shared_ptr<TensorAllocator> &
+    tensor_allocator() const;
+
+private:
+    explicit CompiledModel(std::unique_ptr<RuntimeGraph> graph);
+
+    std::unique_ptr<RuntimeGraph> graph_;
+    std::vector<CompiledOperator> operators_;
+    size_t output_index_ = 0;
+    size_t activation_count_ = 0;
+
+    struct CachedPlan {
+        std::shared_ptr<const MemoryPlan> plan;
+        uint64_t last_use = 0;
+    };
+
+    mutable std::mutex plan_mutex_;
+    mutable std::map<std::vector<int>, CachedPlan> memory_plans_;
+    mutable uint64_t plan_uses_ = 0;
+};
+
+}// namespace jinfer
+
+#endif//_COMPILED_MODEL_HPP_
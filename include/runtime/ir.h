@@ -214,8 +214,9 @@ public:
     Graph();
     ~Graph();
 
+    // load_weights为false时属性只读取类型和形状，数据留在bin文件中由使用者按需读取
     int
-    load(const std::string &parampath, const std::string &binpath);
+    load(const std::string &parampath, const std::string &binpath, bool load_weights = true);
     int
     save(const std::string &parampath, const std::string &binpath);
 
@@ -0,0 +1,43 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _MEMORY_PLAN_HPP_
+#define _MEMORY_PLAN_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace jinfer
+{
+
+struct LayerPlan;
+
+/// 节点的输出直接写入后继torch.cat输出中对应的一段，拼接时不再复制
+struct BufferAlias {
+    /// 拼接节点在拓扑序列中的下标，为-1时节点使用自己的缓冲区
+    int target = -1;
+
+    /// 在拼接节点每个批次张量中的起始位置，单位为float
+    size_t offset = 0;
+};
+
+/// 某一输入形状下计算图中各个输出操作数的形状，按输入形状缓存复用
+struct MemoryPlan {
+    /// 带批次维度的输入形状，同时也是缓存的键
+    std::vector<int> input_shape;
+
+    /// 与拓扑序列一一对应，每个节点按output_operands的顺序排列的输出操作数形状
+    std::vector<std::vector<std::vector<int>>> output_shapes;
+
+    /// 与拓扑序列一一对应，节点输出操作数的别名，只有单输出的节点才会被规划
+    std::vector<BufferAlias> aliases;
+
+    /// 与拓扑序列一一对应，层按这一形状预先计算的数据，不需要时为空，见Layer::create_plan
+    std::vector<std::shared_ptr<const LayerPlan>> layer_plans;
+};
+
+}// namespace jinfer
+
+#endif//_MEMORY_PLAN_HPP_
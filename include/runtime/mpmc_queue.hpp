@@ -0,0 +1,128 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _MPMC_QUEUE_HPP_
+#define _MPMC_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <glog/logging.h>
+#include <memory>
+
+namespace jinfer
+{
+
+/**
+ * 有界的多生产者多消费者无锁队列，每个槽位带一个序号，
+ * 生产者和消费者分别通过CAS抢占队尾和队头，不需要互斥锁
+ * @tparam T 元素类型，需要可默认构造和移动
+ */
+template<class T>
+class MpmcQueue
+{
+public:
+    /**
+     * @param capacity 队列容量，向上取整到2的幂
+     */
+    explicit MpmcQueue(size_t capacity)
+    {
+        CHECK(capacity > 0) << "the capacity of queue should be positive";
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        this->mask_ = size - 1;
+        this->cells_ = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; i++) {
+            this->cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue &) = delete;
+
+    MpmcQueue &
+    operator=(const MpmcQueue &) = delete;
+
+    /**
+     * 入队
+     * @return 队列已满时返回false，value保持不变
+     */
+    bool
+    try_push(T &value)
+    {
+        Cell *cell;
+        size_t pos = this->tail_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &this->cells_[pos & this->mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = intptr_t(sequence) - intptr_t(pos);
+            if (diff == 0) {
+                if (this->tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = this->tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * 出队
+     * @return 队列为空时返回false
+     */
+    bool
+    try_pop(T &value)
+    {
+        Cell *cell;
+        size_t pos = this->head_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &this->cells_[pos & this->mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = intptr_t(sequence) - intptr_t(pos + 1);
+            if (diff == 0) {
+                if (this->head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = this->head_.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(cell->data);
+        cell->sequence.store(pos + this->mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t
+    capacity() const
+    {
+        return this->mask_ + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+
+    /// 队头和队尾放在不同的缓存行，避免生产者和消费者之间的伪共享
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+}// namespace jinfer
+
+#endif//_MPMC_QUEUE_HPP_
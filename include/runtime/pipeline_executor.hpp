@@ -0,0 +1,140 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _PIPELINE_EXECUTOR_HPP_
+#define _PIPELINE_EXECUTOR_HPP_
+
+#include "mpmc_queue.hpp"
+#include "session.hpp"
+#include "spsc_ring.hpp"
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace jinfer
+{
+
+struct PipelineOptions {
+    /// 流水线的段数，每段一个线程
+    uint32_t stage_num = 2;
+
+    /// 每段内部算子使用的OpenMP线程数
+    uint32_t threads_per_stage = 1;
+
+    /// 每段绑定的cpu编号，为空时不绑定；非空时大小需与段数相同
+    std::vector<std::vector<int>> cpu_sets;
+
+    /// 同时在流水线中的请求数上限，也是段之间环形缓冲区的容量
+    size_t max_in_flight = 8;
+
+    /// 划分前测量各节点耗时的推理次数
+    uint32_t calibration_runs = 3;
+};
+
+/**
+ * 流水线并行的执行器：按实测耗时把拓扑序列切分成连续的若干段，每段由一个固定的线程(可绑定到一组核)执行，
+ * 段之间通过单生产者单消费者的环形缓冲区传递请求；
+ * 每个在途请求持有一个Session，后面的段可以直接读取前面任意一段的激活值
+ */
+class PipelineExecutor
+{
+public:
+    /**
+     * @param model 编译好的模型
+     * @param sample_inputs 用于测量各节点耗时的样例输入，形状应与实际请求一致
+     * @param options 流水线选项
+     */
+    PipelineExecutor(std::shared_ptr<const CompiledModel> model,
+                     const std::vector<std::shared_ptr<Tensor<float>>> &sample_inputs,
+                     const PipelineOptions &options);
+
+    ~PipelineExecutor();
+
+    PipelineExecutor(const PipelineExecutor &) = delete;
+
+    PipelineExecutor &
+    operator=(const PipelineExecutor &) = delete;
+
+    /**
+     * 提交一个请求，可在多个线程中同时调用，在途请求达到上限时等待
+     * @param inputs 输入张量，推理完成前不能修改
+     * @return 输出张量的拷贝；输入不合法、流水线已停止或某一段推理失败时future中为异常
+     */
+    std::future<std::vector<std::shared_ptr<Tensor<float>>>>
+    submit(std::vector<std::shared_ptr<Tensor<float>>> inputs);
+
+    /**
+     * 处理完已提交的请求后停止各段线程，析构时自动调用
+     */
+    void
+    stop();
+
+    /**
+     * 各段在拓扑序列中的边界，第i段为[boundaries[i], boundaries[i + 1])
+     */
+    const std::vector<size_t> &
+    stage_boundaries() const;
+
+    /**
+     * 把拓扑序列切分成连续的若干段，使耗时最大的一段尽量小
+     * @param costs 各节点的耗时
+     * @param stage_num 段数，大于节点数时按节点数切分
+     * @return 各段的边界
+     */
+    static std::vector<size_t>
+    partition_stages(const std::vector<double> &costs, uint32_t stage_num);
+
+    /**
+     * 逐个节点测量耗时，取多次推理的平均值
+     * @return 与拓扑序列一一对应的耗时，单位为微秒
+     */
+    static std::vector<double>
+    measure_costs(const std::shared_ptr<const CompiledModel> &model,
+                  const std::vector<std::shared_ptr<Tensor<float>>> &sample_inputs,
+                  uint32_t runs);
+
+private:
+    struct Frame {
+        explicit Frame(std::shared_ptr<const CompiledModel> model) : session(std::move(model))
+        {
+        }
+
+        Session session;
+        std::vector<std::shared_ptr<Tensor<float>>> inputs;
+        std::promise<std::vector<std::shared_ptr<Tensor<float>>>> promise;
+    };
+
+    void
+    run_stage(size_t stage);
+
+    bool
+    pop_frame(size_t stage, Frame *&frame);
+
+    /// 通过future返回异常并把帧放回空闲队列，这个请求不再经过后面的段
+    void
+    fail_frame(Frame *frame, const std::string &message);
+
+private:
+    std::shared_ptr<const CompiledModel> model_;
+    PipelineOptions options_;
+    std::vector<size_t> boundaries_;
+
+    std::vector<std::unique_ptr<Frame>> frames_;
+    MpmcQueue<Frame *> free_frames_;
+    MpmcQueue<Frame *> entry_;
+
+    /// rings_[i]连接第i段和第i + 1段
+    std::vector<std::unique_ptr<SpscRing<Frame *>>> rings_;
+
+    std::atomic<bool> stopped_{false};
+    std::atomic<size_t> submitting_{0};
+    std::unique_ptr<std::atomic<bool>[]> finished_;
+    std::vector<std::thread> stages_;
+};
+
+}// namespace jinfer
+
+#endif//_PIPELINE_EXECUTOR_HPP_
@@ -0,0 +1,133 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _PROFILER_HPP_
+#define _PROFILER_HPP_
+
+#include "runtime_operator.hpp"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jinfer
+{
+
+/// 单个节点在多次推理中的累计统计
+struct OperatorProfile {
+    std::string name;
+    std::string type;
+    uint64_t calls = 0;
+    double total_ms = 0.;
+    double min_ms = 0.;
+    double max_ms = 0.;
+
+    /// 以下为所有调用的累计值
+    uint64_t flops = 0;
+    uint64_t bytes_read = 0;
+    uint64_t bytes_written = 0;
+};
+
+/// chrome://tracing中的一个完整事件(ph为X)
+struct TraceEvent {
+    std::string name;
+    std::string type;
+    uint32_t run = 0;
+    double start_us = 0.;
+    double duration_us = 0.;
+    uint64_t flops = 0;
+    uint64_t bytes = 0;
+};
+
+/**
+ * 逐节点的性能分析器，通过RuntimeGraph::set_profiler挂到计算图上，未设置时推理循环中不做任何计时；
+ * 记录每个节点的耗时、按形状和参数估算的浮点运算数以及读写的字节数，
+ * 多次推理的结果会累计，最后输出按总耗时排序的表格和chrome trace
+ */
+class Profiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Profiler();
+
+    /**
+     * 开始一次推理，由RuntimeGraph::forward调用
+     */
+    void
+    begin_run();
+
+    /**
+     * 记录一个节点的一次执行，输入输出张量需已经是本次推理的数据
+     * @param op 计算图节点
+     * @param start 开始时间
+     * @param end 结束时间
+     */
+    void
+    record(const std::shared_ptr<RuntimeOperator> &op, Clock::time_point start, Clock::time_point end);
+
+    /**
+     * 已记录的推理次数
+     */
+    uint32_t
+    runs() const;
+
+    /**
+     * 按总耗时从大到小排序的节点统计
+     */
+    std::vector<OperatorProfile>
+    profiles() const;
+
+    const std::vector<TraceEvent> &
+    trace_events() const;
+
+    /**
+     * 生成按总耗时排序的表格，包含平均耗时、占比、GFLOP/s和GB/s
+     */
+    std::string
+    report() const;
+
+    /**
+     * 把所有事件写成chrome://tracing可以打开的json文件，每次推理占用一个线程轨道
+     * @param path 输出文件路径
+     * @return 是否写入成功
+     */
+    bool
+    dump_chrome_trace(const std::string &path) const;
+
+    void
+    clear();
+
+    /**
+     * 按节点类型、参数和实际张量形状估算一次执行的浮点运算数，
+     * 乘加记为两次运算，未知类型按输出元素数计
+     */
+    static uint64_t
+    estimate_flops(const std::shared_ptr<RuntimeOperator> &op);
+
+    /**
+     * 估算一次执行读取的字节数，包括全部输入张量和权重
+     */
+    static uint64_t
+    estimate_bytes_read(const std::shared_ptr<RuntimeOperator> &op);
+
+    /**
+     * 估算一次执行写入的字节数，即全部输出张量
+     */
+    static uint64_t
+    estimate_bytes_written(const std::shared_ptr<RuntimeOperator> &op);
+
+private:
+    Clock::time_point origin_;
+    uint32_t runs_ = 0;
+    std::vector<std::string> order_;/// 节点首次出现的顺序，排序时用于稳定输出
+    std::map<std::string, OperatorProfile> profiles_;
+    std::vector<TraceEvent> trace_events_;
+};
+
+}// namespace jinfer
+
+#endif//_PROFILER_HPP_
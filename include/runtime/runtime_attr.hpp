@@ -6,8 +6,12 @@
 #define _RUNTIME_ATTR_HPP_
 
 #include "runtime_datatype.hpp"
+#include "store_zip.hpp"
+#include <cstring>
 #include <glog/logging.h>
 #include <memory>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace jinfer
@@ -18,14 +22,94 @@ struct RuntimeAttribute {
     std::vector<char> weight_data;
     RuntimeDataType type = RuntimeDataType::kTypeUnknown;
 
+    /// 尚未读取的权重所在的模型文件和其中的条目名，读取或清空后置空
+    std::shared_ptr<pnnx::StoreZipReader> weight_source;
+    std::string weight_name;
+
+    /**
+     * 权重尚未读取时从模型文件中读取到weight_data，文件中没有该条目时weight_data保持为空
+     */
+    void
+    materialize();
+
+    /**
+     * 是否还有尚未读取的权重
+     */
+    bool
+    pending() const;
+
+    /// 读取权重，尚未读取时先从模型文件中读取
     template<class T>
     std::vector<T>
     get(bool need_clear_weight = true);
 
+    /**
+     * 替换权重数据，用于构建时对权重的变换，例如融合BatchNorm
+     * @param weights 新的权重
+     * @param shape 新权重的形状
+     */
+    template<class T>
+    void
+    set(const std::vector<T> &weights, const std::vector<int> &shape);
+
+    /// 释放权重数据，尚未读取的权重不再读取
     void
     clear_weight();
 };
 
+template<class T>
+void RuntimeAttribute::set(const std::vector<T> &weights, const std::vector<int> &shape)
+{
+    bool same_type = std::is_same<T, float>::value;
+    CHECK_EQ(same_type, true) << "only float32 weights are supported";
+
+    size_t size = 1;
+    for (int dim : shape) {
+        size *= dim;
+    }
+    CHECK_EQ(size, weights.size()) << "the weight size does not match the shape";
+
+    this->weight_source.reset();
+    this->weight_name.clear();
+    this->type = RuntimeDataType::kTypeFloat32;
+    this->shape = shape;
+    this->weight_data.resize(weights.size() * sizeof(T));
+    std::memcpy(this->weight_data.data(), weights.data(), this->weight_data.size());
+}
+
+template<class T>
+std::vector<T>
+RuntimeAttribute::get(bool need_clear_weight)
+{
+    this->materialize();
+    CHECK(!this->weight_data.empty());
+    CHECK(this->type != RuntimeDataType::kTypeUnknown);
+
+    std::vector<T> weights;
+    switch (this->type) {
+    case RuntimeDataType::kTypeFloat32: {
+        bool same_type = std::is_same<T, float>::value;
+        CHECK_EQ(same_type, true);
+        const uint32_t float_size = sizeof(float);
+        CHECK_EQ(this->weight_data.size() % float_size, 0);
+
+        const uint32_t weight_num = this->weight_data.size() / float_size;
+        weights.resize(weight_num);
+        std::memcpy(weights.data(), this->weight_data.data(), weight_num * float_size);
+        break;
+    }
+
+    default: {
+        LOG(FATAL) << "Unknown weight data type: " << int(type);
+    }
+    }
+
+    if (need_clear_weight) {
+        this->clear_weight();
+    }
+    return weights;
+}
+
 }// namespace jinfer
 
 #endif//_RUNTIME_ATTR_HPP_
@@ -35,6 +35,16 @@ enum class RuntimeParameterType
     kParameterStringArray = 7,
 };
 
+/// 操作数张量在内存中的布局
+enum class RuntimeDataLayout
+{
+    /// 通道、列、行依次嵌套，即Tensor的默认布局
+    kLayoutNCHW = 0,
+
+    /// 每8个通道为一组，组内8个通道的同一位置连续存放，形状为(ceil(C / 8), H * 8, W)
+    kLayoutNCHW8c = 1,
+};
+
 }// namespace jinfer
 
 #endif//_RUNTIME_DATATYPE_HPP_
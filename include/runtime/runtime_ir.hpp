@@ -5,9 +5,16 @@
 #ifndef _RUNTIME_IR_HPP_
 #define _RUNTIME_IR_HPP_
 
+#include "arena.hpp"
+#include "data/tensor.hpp"
 #include "ir.h"
+#include "memory_plan.hpp"
+#include "profiler.hpp"
 #include "runtime_operator.hpp"
+#include "status_code.hpp"
+#include <array>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -67,9 +74,145 @@ public:
     bool
     init();
 
+    /**
+     * 构建单输入单输出的计算图
+     * @param input_op_name 输入节点名称
+     * @param output_op_name 输出节点名称，可以是pnnx.Output，也可以是中间节点
+     * @return 是否构建成功
+     */
     bool
     build(std::string input_op_name, std::string output_op_name);
 
+    /**
+     * 构建计算图，只保留从输入节点可达且能到达输出节点的子图，其余节点不读取权重也不创建层
+     * @param input_op_names 输入节点名称，必须是pnnx.Input，子图依赖的输入节点都要列出
+     * @param output_op_names 输出节点名称，中间节点作为输出时返回它自己的输出，例如截断的主干网络的特征
+     * @return 是否构建成功
+     */
+    bool
+    build(const std::vector<std::string> &input_op_names, const std::vector<std::string> &output_op_names);
+
+    /**
+     * 计算图的推理，各操作数的形状由实际输入推导，支持动态批次和动态形状
+     * @param inputs 输入张量，数组大小即为本次推理的批次
+     * @return 第一个输出节点的结果，引用计算图内部的操作数，下一次forward时会被覆盖；推理失败时为空
+     */
+    const std::vector<std::shared_ptr<Tensor<float>>> &
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs);
+
+    /**
+     * 多输入多输出计算图的推理
+     * @param inputs 按build时输入节点的顺序排列的输入，各输入的批次必须相同
+     * @return 按build时输出节点的顺序排列的结果，推理失败时为空
+     */
+    std::vector<std::vector<std::shared_ptr<Tensor<float>>>>
+    forward(const std::vector<std::vector<std::shared_ptr<Tensor<float>>>> &inputs);
+
+    /// 按build时的顺序排列的输入节点
+    const std::vector<std::shared_ptr<RuntimeOperator>> &
+    input_operators() const;
+
+    /// 按build时的顺序排列的输出节点
+    const std::vector<std::shared_ptr<RuntimeOperator>> &
+    output_operators() const;
+
+    /**
+     * 输出节点的结果所在的操作数：pnnx.Output为它的输入操作数，其余节点为自己的输出操作数
+     * @param output_op 输出节点
+     * @return 结果所在的操作数
+     */
+    static const std::shared_ptr<RuntimeOperand> &
+    result_operand(const std::shared_ptr<RuntimeOperator> &output_op);
+
+    /**
+     * 返回按输入形状缓存的内存规划
+     * @return 输入形状到内存规划的映射
+     */
+    const std::map<std::vector<int>, MemoryPlan> &
+    memory_plans() const;
+
+    /**
+     * 设置逐节点的性能分析器，之后每次forward都会记录各节点的耗时；传入nullptr关闭分析
+     * @param profiler 性能分析器
+     */
+    void
+    set_profiler(std::shared_ptr<Profiler> profiler);
+
+    const std::shared_ptr<Profiler> &
+    profiler() const;
+
+    /**
+     * 设置操作数张量的分配器，默认是每个计算图各自的PoolAllocator；传入nullptr时由armadillo直接分配
+     * @param allocator 张量分配器
+     */
+    void
+    set_tensor_allocator(std::shared_ptr<TensorAllocator> allocator);
+
+    const std::shared_ptr<TensorAllocator> &
+    tensor_allocator() const;
+
+    /// 计算图中的节点、操作数、参数和属性所用的内存区域
+    const std::shared_ptr<Arena> &
+    arena() const;
+
+    /**
+     * 构建时是否启用NCHW8c布局传播，需在build之前设置，默认关闭
+     * 启用后卷积、池化和激活函数组成的区域按NCHW8c布局计算，区域边界自动插入布局转换节点
+     * @param blocked 是否启用
+     */
+    void
+    set_blocked_layout(bool blocked);
+
+    bool
+    blocked_layout() const;
+
+    /**
+     * 从输入形状推导拓扑序列中各个输出操作数的形状，不修改计算图
+     * @param input_shape 带批次维度的输入形状，多个输入时按输入节点的顺序首尾相接
+     * @param plan 内存规划
+     * @return 是否推导成功，某个节点的形状推导失败时返回false
+     */
+    bool
+    create_memory_plan(const std::vector<int> &input_shape, MemoryPlan &plan) const;
+
+    /**
+     * 由实际输入得到带批次维度的输入形状，并与模型文件中声明的形状校验
+     * @param input_op 输入节点
+     * @param inputs 输入张量
+     * @param input_shape 追加带批次维度的输入形状，复用其容量，推理时不必每次分配
+     * @return 输入为空、批次内形状不一致或与声明的形状不符时记录错误并返回false
+     */
+    bool
+    input_shape_of(const std::shared_ptr<RuntimeOperator> &input_op,
+                   const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                   std::vector<int> &input_shape) const;
+
+    /**
+     * 按形状准备操作数的数据，已有且形状相同的张量会被复用
+     * @param data 操作数的数据
+     * @param shape 带批次维度的逻辑形状，含有动态维度(-1)时不分配
+     * @param layout 数据布局，NCHW8c时四维形状(N, C, H, W)的张量为(ceil(C / 8), H * 8, W)
+     * @param allocator 新张量的分配器，为空时由armadillo分配
+     */
+    static void
+    init_data(std::vector<std::shared_ptr<Tensor<float>>> &data,
+              const std::vector<int> &shape,
+              RuntimeDataLayout layout = RuntimeDataLayout::kLayoutNCHW,
+              const std::shared_ptr<TensorAllocator> &allocator = nullptr);
+
+    /**
+     * 把操作数的数据准备为另一个操作数中的一段，不分配内存，已指向同一位置的张量会被复用
+     * @param data 操作数的数据，NCHW布局
+     * @param shape 带批次维度的逻辑形状，含有动态维度(-1)时不处理
+     * @param target 已准备好的目标数据，批次与shape相同，data中的张量持有对应的目标张量
+     * @param offset 在目标每个批次张量中的起始位置，单位为float
+     */
+    static void
+    init_alias(std::vector<std::shared_ptr<Tensor<float>>> &data,
+               const std::vector<int> &shape,
+               const std::vector<std::shared_ptr<Tensor<float>>> &target,
+               size_t offset);
+
     const std::vector<std::shared_ptr<RuntimeOperator>> &
     operators() const;
 
@@ -120,22 +263,150 @@ private:
     std::shared_ptr<RuntimeOperator>
     create_op(const std::string& name);
 
+    /// 在arena_中创建对象，arena_在其中所有对象销毁后才释放
+    template<typename T>
+    std::shared_ptr<T>
+    arena_make_shared()
+    {
+        return std::allocate_shared<T>(ArenaAllocator<T>(this->arena_));
+    }
+
+    /**
+     * 对子图中的节点做Kahn拓扑排序，就绪节点中优先选择执行后存活数据增加最少的，
+     * 相同时选择最近就绪的，使前一个节点的输出尽快被消费
+     * @return 子图中是否没有环
+     */
+    bool
+    init_topo_seq();
+
+    /**
+     * 计算从输入节点可达且能到达输出节点的子图，结果保存在subgraph_中
+     * @return 输出节点是否都可以从输入节点到达，子图依赖的输入节点是否都已列出
+     */
+    bool
+    collect_subgraph();
+
+    /// 节点是否属于子图且不是输出节点，即结果只在子图内部使用，只有这样的节点才能被融合或改变输出布局
+    bool
+    is_internal(const std::shared_ptr<RuntimeOperator> &op) const;
+
+    /**
+     * 读取子图中节点的权重，其余分支的权重留在模型文件中
+     */
     void
-    init_topo_seq(const std::shared_ptr<RuntimeOperator> &start);
+    materialize_weights();
 
+    /**
+     * 按拓扑序列执行子图
+     * @param inputs 各输入节点的输入，共input_count个
+     * @param input_count 输入的个数，与输入节点的个数相同
+     * @return 是否执行成功，输入不合法、无法推导出内存规划或某个层执行失败时返回false
+     */
+    bool
+    forward_graph(const std::vector<std::shared_ptr<Tensor<float>>> *inputs, size_t input_count);
+
+    /**
+     * 拼接节点的输入并执行它的层，输入和多输出层的输出数组使用计算图中的暂存数组
+     * @param layer_plan 内存规划中这个节点的预计算数据
+     */
+    InferStatus
+    forward_layer(const std::shared_ptr<RuntimeOperator> &op, const LayerPlan *layer_plan);
+
+    /**
+     * 按内存规划准备拓扑序列中第index个节点的输出，有别名时先准备拼接节点的输出
+     */
     void
-    reverse_topo(const std::shared_ptr<RuntimeOperator> &cur);
+    init_outputs(size_t index, const MemoryPlan &plan);
 
+    /**
+     * 为torch.cat的前驱节点规划别名，使它们的输出直接写入拼接结果中对应的一段；
+     * 只在拼接维度之外只有批次时规划，此时每一段在拼接结果中连续存放
+     */
     void
-    check_shape(const std::vector<int> &shape) const;
+    plan_aliases(MemoryPlan &plan) const;
+
+    /**
+     * 逻辑形状对应的张量形状(channels, rows, cols)，与init_data一致
+     * @return 含有动态维度时返回false
+     */
+    static bool
+    tensor_shape_of(const std::vector<int> &shape, RuntimeDataLayout layout, std::array<uint32_t, 3> &tensor_shape);
+
+    /**
+     * 为拓扑序列中的节点创建层
+     * @return 是否成功，有节点没有注册的层或参数解析失败时返回false
+     */
+    bool
+    create_layers();
+
+    /**
+     * 构建前的图优化：把BatchNorm折叠进前面的卷积或线性层并删除，再把线性层和卷积后面的激活函数融合进去
+     */
+    void
+    fuse_operators();
 
+    /**
+     * 从计算图中删除单输入的节点，它的后继节点改为直接连接到它的前驱节点
+     * @param op 待删除的节点
+     */
     void
-    init_data(std::vector<std::shared_ptr<Tensor<float>>> &data,
-              const std::vector<int> &shape);
+    remove_operator(const std::shared_ptr<RuntimeOperator> &removed_op);
+
+    /**
+     * 布局传播：groups为1的四维卷积总是使用NCHW8c布局，前驱为NCHW8c的池化和激活函数沿用该布局，
+     * 再在布局不同的前驱和后继之间插入jinfer.ToBlocked或jinfer.ToPlanar节点，需要在拓扑排序之后调用
+     * @return 是否修改了计算图
+     */
+    bool
+    propagate_layout();
+
+    /**
+     * 在节点和它的部分后继之间插入布局转换节点
+     * @param op 前驱节点
+     * @param next_ops 需要另一种布局的后继节点
+     * @param to_blocked 是否转换为NCHW8c布局
+     */
+    void
+    insert_layout_transform(const std::shared_ptr<RuntimeOperator> &op,
+                            const std::vector<std::shared_ptr<RuntimeOperator>> &next_ops,
+                            bool to_blocked);
+
+    /**
+     * 构建时从输入形状推导所有操作数的形状，与模型文件中的形状相互校验，并补全其中的动态维度
+     * @return 推导结果与模型文件是否一致
+     */
+    bool
+    infer_shapes();
+
+    void
+    check_shape(const std::vector<int> &shape) const;
+
+    /**
+     * 获取输入形状对应的内存规划，不存在时推导并缓存
+     * @param input_shape 带批次维度的输入形状
+     * @param plan 缓存中的内存规划
+     * @return 是否成功，形状推导失败时返回false且不缓存
+     */
+    bool
+    get_memory_plan(const std::vector<int> &input_shape, const MemoryPlan *&plan);
+
+    /**
+     * 推导节点所有输出的形状，没有形状推导函数的算子沿用模型文件中的形状
+     * @param output_shapes 与output_operands一一对应的带批次维度的形状
+     * @return 是否推导成功，失败时记录错误日志
+     */
+    bool
+    infer_output_shapes(const std::shared_ptr<RuntimeOperator> &op,
+                        const std::vector<std::vector<int>> &input_shapes,
+                        int batch,
+                        std::vector<std::vector<int>> &output_shapes) const;
 
 private:
-    std::string input_name_;
-    std::string output_name_;
+    std::vector<std::string> input_names_;
+    std::vector<std::string> output_names_;
+    std::vector<std::shared_ptr<RuntimeOperator>> input_ops_;
+    std::vector<std::shared_ptr<RuntimeOperator>> output_ops_;
+    std::set<const RuntimeOperator *> subgraph_;/// 构建时保留的节点
     std::string bin_path_;
     std::string param_path_;
 
@@ -143,7 +414,17 @@ private:
     std::vector<std::shared_ptr<RuntimeOperator>> operators_;
     std::vector<std::shared_ptr<RuntimeOperator>> topo_operators_;
     std::map<std::string, std::shared_ptr<RuntimeOperator>> operators_map_;
+    std::map<std::vector<int>, MemoryPlan> memory_plans_;
+    std::vector<int> input_shape_;/// 上一次推理的输入形状，复用容量
+    /// forward_layer拼接的输入和多输出层的输出，与Session一样由执行者持有，层本身不保存状态
+    std::vector<std::shared_ptr<Tensor<float>>> layer_inputs_;
+    std::vector<std::vector<std::shared_ptr<Tensor<float>>> *> layer_outputs_;
+    std::shared_ptr<Profiler> profiler_;
+    bool blocked_layout_ = false;
+    std::shared_ptr<Arena> arena_;
+    std::shared_ptr<TensorAllocator> tensor_allocator_;
     std::unique_ptr<pnnx::Graph> graph_;
+    std::shared_ptr<pnnx::StoreZipReader> weight_reader_;/// init时属性延迟读取的来源
 };
 
 }// namespace jinfer
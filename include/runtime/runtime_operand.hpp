@@ -17,7 +17,9 @@ namespace jinfer
 struct RuntimeOperand {
     std::string name;
     RuntimeDataType type = RuntimeDataType::kTypeUnknown;
-    std::vector<int> shape;
+    std::vector<int> shape;/// 逻辑形状，与布局无关
+    RuntimeDataLayout layout = RuntimeDataLayout::kLayoutNCHW;
+    uint32_t output_index = 0;/// 作为输入操作数时读取的是前驱节点的第几个输出，name为前驱节点名称
     std::vector<std::shared_ptr<Tensor<float>>> data;
 };
 
@@ -19,21 +19,36 @@ namespace jinfer
 class Layer;
 
 struct RuntimeOperator {
-
-    bool has_forward = false;
     std::string name;
     std::string type;
     std::shared_ptr<Layer> layer;
 
+    /// 按前驱节点名称索引，同一前驱的多个输出被同一节点使用时只记录第一个，完整的输入见input_operands_seq
     std::map<std::string, std::shared_ptr<RuntimeOperand>> input_operands;
     std::vector<std::shared_ptr<RuntimeOperand>> input_operands_seq;
 
-    std::shared_ptr<RuntimeOperand> output_operand;
+    std::shared_ptr<RuntimeOperand> output_operand;/// 第一个输出操作数，即output_operands.front()
+    std::vector<std::shared_ptr<RuntimeOperand>> output_operands;/// 全部输出操作数，如torch.chunk的各个分块
     std::vector<std::string> output_names;/// 输出节点名称
     std::map<std::string, std::shared_ptr<RuntimeOperator>> output_operators;
 
     std::map<std::string, std::shared_ptr<RuntimeParameter>> params;
     std::map<std::string, std::shared_ptr<RuntimeAttribute>> attrs;
+
+    /**
+     * 按名称和类型获取节点参数
+     * @return 参数不存在或类型不一致时返回nullptr
+     */
+    template<class T>
+    std::shared_ptr<T>
+    get_param(const std::string &param_name) const
+    {
+        auto iter = this->params.find(param_name);
+        if (iter == this->params.end()) {
+            return nullptr;
+        }
+        return std::dynamic_pointer_cast<T>(iter->second);
+    }
 };
 
 }// namespace jinfer
@@ -0,0 +1,75 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _SESSION_HPP_
+#define _SESSION_HPP_
+
+#include "compiled_model.hpp"
+#include <memory>
+#include <vector>
+
+namespace jinfer
+{
+
+/**
+ * 推理会话，只持有激活值，同一个CompiledModel可以创建任意多个会话；
+ * 一个会话同一时间只能被一个线程使用，每个工作线程使用自己的会话
+ */
+class Session
+{
+public:
+    explicit Session(std::shared_ptr<const CompiledModel> model);
+
+    /**
+     * 推理，激活值的张量在相同输入形状的多次推理之间复用
+     * @param inputs 输入张量，数组大小即为本次推理的批次
+     * @return 输出张量，在下一次推理前有效；输入不合法或某个层执行失败时为空
+     */
+    const std::vector<std::shared_ptr<Tensor<float>>> &
+    forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs);
+
+    /**
+     * 设置输入并确定本次推理的内存规划，与forward_operators配合可以分段执行拓扑序列
+     * @param inputs 输入张量
+     * @return 输入形状不合法或无法推导出内存规划时记录错误并返回false，此时不能执行节点
+     */
+    bool
+    set_inputs(const std::vector<std::shared_ptr<Tensor<float>>> &inputs);
+
+    /**
+     * 执行拓扑序列中[begin, end)范围内的节点，它们依赖的节点需已经执行
+     * @return 某个层执行失败时记录错误并返回false，其后的节点不再执行
+     */
+    bool
+    forward_operators(size_t begin, size_t end);
+
+    /**
+     * 输出节点的输入张量，在下一次推理前有效
+     */
+    const std::vector<std::shared_ptr<Tensor<float>>> &
+    outputs() const;
+
+    const std::shared_ptr<const CompiledModel> &
+    model() const;
+
+private:
+    /// 按内存规划准备第index个节点的输出激活值，有别名时先准备拼接节点的输出
+    void
+    init_outputs(size_t index);
+
+    std::shared_ptr<const CompiledModel> model_;
+
+    /// 输出激活值，下标见CompiledOperator::output_indices
+    std::vector<std::vector<std::shared_ptr<Tensor<float>>>> activations_;
+    std::vector<std::shared_ptr<Tensor<float>>> layer_inputs_;
+    std::vector<std::vector<std::shared_ptr<Tensor<float>>> *> layer_outputs_;
+    std::vector<int> input_shape_;
+
+    /// 上一次推理使用的内存规划，输入形状不变时跳过加锁查找；持有所有权，模型淘汰它后仍然有效
+    std::shared_ptr<const MemoryPlan> plan_;
+};
+
+}// namespace jinfer
+
+#endif//_SESSION_HPP_
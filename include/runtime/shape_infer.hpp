@@ -0,0 +1,104 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _SHAPE_INFER_HPP_
+#define _SHAPE_INFER_HPP_
+
+#include "runtime_operator.hpp"
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jinfer
+{
+
+/// 各类算子的形状推导函数，只根据输入形状和节点参数计算输出形状，不执行计算
+class ShapeInferRegisterer
+{
+public:
+    using ShapeFunc = std::function<bool(const std::shared_ptr<RuntimeOperator> &,
+                                         const std::vector<std::vector<int>> &,
+                                         std::vector<int> &)>;
+    using ShapeRegistry = std::map<std::string, ShapeFunc>;
+
+    /// 多输出算子的形状推导函数，按output_operands的顺序给出每个输出的形状
+    using MultiShapeFunc = std::function<bool(const std::shared_ptr<RuntimeOperator> &,
+                                              const std::vector<std::vector<int>> &,
+                                              std::vector<std::vector<int>> &)>;
+    using MultiShapeRegistry = std::map<std::string, MultiShapeFunc>;
+
+    static void
+    register_shape_func(const std::string &op_type, const ShapeFunc &func);
+
+    static void
+    register_multi_shape_func(const std::string &op_type, const MultiShapeFunc &func);
+
+    static bool
+    has_shape_func(const std::string &op_type);
+
+    /**
+     * 推导计算图节点的输出形状
+     * @param op 计算图节点
+     * @param input_shapes 带批次维度的输入形状，与input_operands_seq一一对应
+     * @param output_shape 推导得到的带批次维度的输出形状
+     * @return 节点参数缺失或与输入形状不匹配时返回false
+     */
+    static bool
+    infer_shape(const std::shared_ptr<RuntimeOperator> &op,
+                const std::vector<std::vector<int>> &input_shapes,
+                std::vector<int> &output_shape);
+
+    /**
+     * 推导计算图节点所有输出的形状，单输出算子的结果只有一个元素
+     * @param output_shapes 推导得到的带批次维度的输出形状，与output_operands一一对应
+     * @return 没有形状推导函数、节点参数缺失或与输入形状不匹配时返回false
+     */
+    static bool
+    infer_shapes(const std::shared_ptr<RuntimeOperator> &op,
+                 const std::vector<std::vector<int>> &input_shapes,
+                 std::vector<std::vector<int>> &output_shapes);
+
+    static ShapeRegistry &
+    registry();
+
+    static MultiShapeRegistry &
+    multi_registry();
+};
+
+/**
+ * 卷积和池化等滑动窗口算子在一个维度上的输出大小，即(in + 2 * padding - dilation * (kernel - 1) - 1) / stride + 1
+ * @param ceil_mode 是否向上取整，与pytorch一致时最后一个窗口必须从输入或左侧填充区域开始
+ * @return 参数不合法时返回-1
+ */
+int window_output_size(int in, int kernel, int stride, int padding, int dilation, bool ceil_mode);
+
+/**
+ * 转置卷积在一个维度上的输出大小，即(in - 1) * stride - 2 * padding + dilation * (kernel - 1) + output_padding + 1
+ * @return 参数不合法时返回-1
+ */
+int transposed_window_output_size(int in, int kernel, int stride, int padding, int dilation, int output_padding);
+
+class ShapeInferRegistererWrapper
+{
+public:
+    ShapeInferRegistererWrapper(const std::string &op_type, const ShapeInferRegisterer::ShapeFunc &func)
+    {
+        ShapeInferRegisterer::register_shape_func(op_type, func);
+    }
+};
+
+class MultiShapeInferRegistererWrapper
+{
+public:
+    MultiShapeInferRegistererWrapper(const std::string &op_type, const ShapeInferRegisterer::MultiShapeFunc &func)
+    {
+        ShapeInferRegisterer::register_multi_shape_func(op_type, func);
+    }
+};
+
+}// namespace jinfer
+
+#endif//_SHAPE_INFER_HPP_
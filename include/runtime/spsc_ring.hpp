@@ -0,0 +1,101 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _SPSC_RING_HPP_
+#define _SPSC_RING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <glog/logging.h>
+#include <memory>
+
+namespace jinfer
+{
+
+/**
+ * 单生产者单消费者的环形缓冲区，只有一个线程调用try_push，一个线程调用try_pop；
+ * 双方各自缓存对方的位置，只在缓存显示已满或已空时才读取对方的原子变量
+ * @tparam T 元素类型，需要可默认构造和移动
+ */
+template<class T>
+class SpscRing
+{
+public:
+    /**
+     * @param capacity 缓冲区容量，向上取整到2的幂
+     */
+    explicit SpscRing(size_t capacity)
+    {
+        CHECK(capacity > 0) << "the capacity of ring should be positive";
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        this->mask_ = size - 1;
+        this->slots_ = std::make_unique<T[]>(size);
+    }
+
+    SpscRing(const SpscRing &) = delete;
+
+    SpscRing &
+    operator=(const SpscRing &) = delete;
+
+    /**
+     * 入队，只能由生产者线程调用
+     * @return 缓冲区已满时返回false
+     */
+    bool
+    try_push(T &value)
+    {
+        const size_t tail = this->tail_.load(std::memory_order_relaxed);
+        if (tail - this->cached_head_ > this->mask_) {
+            this->cached_head_ = this->head_.load(std::memory_order_acquire);
+            if (tail - this->cached_head_ > this->mask_) {
+                return false;
+            }
+        }
+        this->slots_[tail & this->mask_] = std::move(value);
+        this->tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * 出队，只能由消费者线程调用
+     * @return 缓冲区为空时返回false
+     */
+    bool
+    try_pop(T &value)
+    {
+        const size_t head = this->head_.load(std::memory_order_relaxed);
+        if (head == this->cached_tail_) {
+            this->cached_tail_ = this->tail_.load(std::memory_order_acquire);
+            if (head == this->cached_tail_) {
+                return false;
+            }
+        }
+        value = std::move(this->slots_[head & this->mask_]);
+        this->head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t
+    capacity() const
+    {
+        return this->mask_ + 1;
+    }
+
+private:
+    std::unique_ptr<T[]> slots_;
+    size_t mask_ = 0;
+
+    /// 消费者写head_，生产者写tail_，各自和自己缓存的对方位置放在同一缓存行
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+};
+
+}// namespace jinfer
+
+#endif//_SPSC_RING_HPP_
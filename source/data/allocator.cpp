@@ -0,0 +1,130 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "data/allocator.hpp"
+#include <glog/logging.h>
+#include <new>
+
+namespace jinfer
+{
+
+static float *
+aligned_new(size_t size)
+{
+    return static_cast<float *>(::operator new(size * sizeof(float), std::align_val_t(PoolAllocator::kAlignment)));
+}
+
+static void
+aligned_delete(float *ptr)
+{
+    ::operator delete(ptr, std::align_val_t(PoolAllocator::kAlignment));
+}
+
+PoolAllocator::PoolAllocator(size_t max_cached_size) : max_cached_size_(max_cached_size)
+{
+}
+
+PoolAllocator::~PoolAllocator()
+{
+    this->release();
+    LOG_IF(WARNING, this->reserved_size_ != 0)
+        << "pool allocator is destroyed with " << this->reserved_size_ << " floats in use";
+}
+
+size_t PoolAllocator::block_size_of(size_t size)
+{
+    if (size <= kMinBlockSize) {
+        return kMinBlockSize;
+    }
+
+    size_t step = kMinBlockSize;
+    while ((step << 3) < size) {
+        step <<= 1;
+    }
+    return (size + step - 1) / step * step;
+}
+
+float *PoolAllocator::allocate(size_t size)
+{
+    const size_t block_size = block_size_of(size);
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        auto iter = this->free_blocks_.find(block_size);
+        if (iter != this->free_blocks_.end() && !iter->second.empty()) {
+            float *ptr = iter->second.back();
+            iter->second.pop_back();
+            this->cached_size_ -= block_size;
+            return ptr;
+        }
+    }
+
+    /// 申请成功后才计入，申请失败抛出异常时统计不变
+    float *ptr = aligned_new(block_size);
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->reserved_size_ += block_size;
+    return ptr;
+}
+
+void PoolAllocator::deallocate(float *ptr, size_t size)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+
+    const size_t block_size = block_size_of(size);
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->free_blocks_[block_size].push_back(ptr);
+    this->cached_size_ += block_size;
+    if (this->cached_size_ > this->max_cached_size_) {
+        this->trim_locked();
+    }
+}
+
+void PoolAllocator::trim_locked()
+{
+    /// 先归还大的缓冲区，用较少的系统调用腾出最多的内存，小缓冲区复用更频繁
+    auto iter = this->free_blocks_.end();
+    while (this->cached_size_ > this->max_cached_size_ && iter != this->free_blocks_.begin()) {
+        --iter;
+        auto &[block_size, blocks] = *iter;
+        while (!blocks.empty() && this->cached_size_ > this->max_cached_size_) {
+            aligned_delete(blocks.back());
+            blocks.pop_back();
+            this->cached_size_ -= block_size;
+            this->reserved_size_ -= block_size;
+        }
+    }
+}
+
+void PoolAllocator::release()
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    for (auto &[block_size, blocks] : this->free_blocks_) {
+        for (float *ptr : blocks) {
+            aligned_delete(ptr);
+        }
+        this->reserved_size_ -= block_size * blocks.size();
+    }
+    this->free_blocks_.clear();
+    this->cached_size_ = 0;
+}
+
+size_t PoolAllocator::reserved_size() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->reserved_size_;
+}
+
+size_t PoolAllocator::cached_size() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->cached_size_;
+}
+
+size_t PoolAllocator::max_cached_size() const
+{
+    return this->max_cached_size_;
+}
+
+}// namespace jinfer
@@ -59,6 +59,33 @@ Tensor<float>::Tensor(const std::vector<uint32_t> &shapes)
     }
 }
 
+Tensor<float>::Tensor(uint32_t channels, uint32_t rows, uint32_t cols,
+                      const std::shared_ptr<TensorAllocator> &allocator)
+{
+    if (!allocator) {
+        *this = Tensor<float>(channels, rows, cols);
+        return;
+    }
+
+    const size_t size = size_t(channels) * rows * cols;
+    float *data = allocator->allocate(size);
+    std::shared_ptr<float> owner(data, [allocator, size](float *ptr) { allocator->deallocate(ptr, size); });
+    *this = Tensor<float>(data, channels, rows, cols, std::move(owner));
+}
+
+Tensor<float>::Tensor(float *data, uint32_t channels, uint32_t rows, uint32_t cols, std::shared_ptr<void> owner)
+    : data_(data, rows, cols, channels, false, false), external_(data), owner_(std::move(owner))
+{
+    CHECK(data != nullptr) << "the external memory of tensor is empty";
+    if (channels == 1 && rows == 1) {
+        raw_shape_ = std::vector<uint32_t>{cols};
+    } else if (channels == 1) {
+        raw_shape_ = std::vector<uint32_t>{rows, cols};
+    } else {
+        raw_shape_ = std::vector<uint32_t>{channels, rows, cols};
+    }
+}
+
 Tensor<float>::Tensor(const Tensor &tensor)
 {
     if (this != &tensor) {
@@ -69,18 +96,28 @@ Tensor<float>::Tensor(const Tensor &tensor)
 
 Tensor<float>::Tensor(Tensor &&tensor) noexcept
 {
-    if (this != &tensor) {
-        this->data_ = std::move(tensor.data_);
-        this->raw_shape_ = tensor.raw_shape_;
-    }
+    *this = std::move(tensor);
 }
 
 Tensor<float> &
 Tensor<float>::operator=(Tensor &&tensor) noexcept
 {
     if (this != &tensor) {
+        float *external = tensor.external_;
+        std::shared_ptr<void> owner = std::move(tensor.owner_);
+        tensor.external_ = nullptr;
+
+        /// armadillo在移动时接管外部内存，此时连同持有者一起转移；否则数据已被复制，持有者留给原张量
         this->data_ = std::move(tensor.data_);
         this->raw_shape_ = tensor.raw_shape_;
+        if (external != nullptr && this->data_.memptr() == external) {
+            this->external_ = external;
+            this->owner_ = std::move(owner);
+        } else {
+            tensor.external_ = external;
+            tensor.owner_ = std::move(owner);
+            this->release_external();
+        }
     }
 
     return *this;
@@ -92,11 +129,20 @@ Tensor<float>::operator=(const Tensor &tensor)
     if (this != &tensor) {
         this->data_ = tensor.data_;
         this->raw_shape_ = tensor.raw_shape_;
+        this->release_external();
     }
 
     return *this;
 }
 
+void Tensor<float>::release_external()
+{
+    if (this->external_ != nullptr && (this->data_.empty() || this->data_.memptr() != this->external_)) {
+        this->external_ = nullptr;
+        this->owner_.reset();
+    }
+}
+
 uint32_t
 Tensor<float>::rows() const
 {
@@ -204,6 +250,7 @@ void Tensor<float>::reshape(const std::vector<uint32_t> &shapes, bool row_major)
     assign_each_shape(shapes, rows, cols, channels);
 
     this->data_ = arma::fcube(rows, cols, channels);
+    this->release_external();
     if (channels > 1) {
         this->raw_shape_ = {channels, rows, cols};
     } else if (rows > 1) {
@@ -277,6 +324,13 @@ Tensor<float>::raw_ptr() const
     return this->data_.memptr();
 }
 
+float *
+Tensor<float>::raw_ptr()
+{
+    CHECK(!this->data_.empty());
+    return this->data_.memptr();
+}
+
 void Tensor<float>::flatten(bool row_major)
 {
     CHECK(!this->data_.empty());
@@ -305,6 +359,7 @@ void Tensor<float>::padding(const std::vector<uint32_t> &pads, float padding_val
     data.subcube(up, left, 0,
                  rows - down - 1, cols - right - 1, channels - 1) = this->data_;
     this->data_ = std::move(data);
+    this->release_external();
 
     if (channels > 1 && rows > 1) {
         this->raw_shape_ = {channels, rows, cols};
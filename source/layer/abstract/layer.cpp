@@ -0,0 +1,82 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/abstract/layer.hpp"
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+Layer::Layer(std::string layer_name) : layer_name_(std::move(layer_name))
+{
+}
+
+InferStatus Layer::forward()
+{
+    const auto runtime_operator = this->runtime_operator_.lock();
+    CHECK(runtime_operator != nullptr)
+        << "runtime operator of layer " << this->layer_name_ << " has expired";
+
+    /// 多个输入操作数时按输入顺序依次拼接，例如Expression的@0、@1
+    std::vector<std::shared_ptr<Tensor<float>>> inputs;
+    for (const auto &input_operand : runtime_operator->input_operands_seq) {
+        CHECK(input_operand != nullptr);
+        inputs.insert(inputs.end(), input_operand->data.begin(), input_operand->data.end());
+    }
+
+    CHECK(runtime_operator->output_operand != nullptr)
+        << "layer " << this->layer_name_ << " has no output operand";
+    if (runtime_operator->output_operands.size() > 1) {
+        std::vector<std::vector<std::shared_ptr<Tensor<float>>> *> outputs;
+        for (const auto &output_operand : runtime_operator->output_operands) {
+            outputs.push_back(&output_operand->data);
+        }
+        return this->forward(inputs, outputs);
+    }
+
+    std::vector<std::shared_ptr<Tensor<float>>> &outputs = runtime_operator->output_operand->data;
+    return this->forward(inputs, outputs);
+}
+
+InferStatus Layer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                           std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    LOG(FATAL) << "layer " << this->layer_name_ << " does not implement forward";
+    return InferStatus::kInferUnknown;
+}
+
+InferStatus Layer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                           std::vector<std::shared_ptr<Tensor<float>>> &outputs,
+                           const LayerPlan *plan)
+{
+    return this->forward(inputs, outputs);
+}
+
+std::shared_ptr<const LayerPlan>
+Layer::create_plan(const std::vector<std::vector<int>> &input_shapes,
+                   const std::vector<std::vector<int>> &output_shapes) const
+{
+    return nullptr;
+}
+
+InferStatus Layer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                           const std::vector<std::vector<std::shared_ptr<Tensor<float>>> *> &outputs)
+{
+    LOG(FATAL) << "layer " << this->layer_name_ << " does not support " << outputs.size() << " outputs";
+    return InferStatus::kInferUnknown;
+}
+
+const std::string &
+Layer::layer_name() const
+{
+    return this->layer_name_;
+}
+
+void Layer::set_runtime_operator(const std::shared_ptr<RuntimeOperator> &runtime_operator)
+{
+    CHECK(runtime_operator != nullptr);
+    this->runtime_operator_ = runtime_operator;
+}
+
+}// namespace jinfer
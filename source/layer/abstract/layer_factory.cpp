@@ -0,0 +1,55 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/abstract/layer_factory.hpp"
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+LayerRegisterer::CreateRegistry &
+LayerRegisterer::registry()
+{
+    /// 局部静态变量，避免各个注册对象静态初始化顺序的问题
+    static CreateRegistry *registry = new CreateRegistry();
+    return *registry;
+}
+
+void LayerRegisterer::register_creator(const std::string &layer_type, const Creator &creator)
+{
+    CHECK(creator != nullptr) << "layer creator of " << layer_type << " is empty";
+    CreateRegistry &registry = LayerRegisterer::registry();
+    CHECK_EQ(registry.count(layer_type), 0)
+        << "layer type " << layer_type << " has been registered";
+    registry.insert({layer_type, creator});
+}
+
+std::shared_ptr<Layer>
+LayerRegisterer::create_layer(const std::shared_ptr<RuntimeOperator> &op, ParseParameterAttrStatus &status)
+{
+    CHECK(op != nullptr);
+    CreateRegistry &registry = LayerRegisterer::registry();
+    auto iter = registry.find(op->type);
+    if (iter == registry.end()) {
+        status = ParseParameterAttrStatus::kParameterMissingUnknown;
+        return nullptr;
+    }
+
+    std::shared_ptr<Layer> layer;
+    status = iter->second(op, layer);
+    if (status != ParseParameterAttrStatus::kParameterAttrParseSuccess) {
+        return nullptr;
+    }
+    if (layer == nullptr) {
+        status = ParseParameterAttrStatus::kParameterMissingUnknown;
+    }
+    return layer;
+}
+
+bool LayerRegisterer::has_creator(const std::string &layer_type)
+{
+    return LayerRegisterer::registry().count(layer_type) > 0;
+}
+
+}// namespace jinfer
@@ -0,0 +1,38 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/abstract/param_layer.hpp"
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+ParamLayer::ParamLayer(std::string layer_name) : Layer(std::move(layer_name))
+{
+}
+
+void ParamLayer::set_weights(const std::vector<float> &weights)
+{
+    CHECK(!weights.empty()) << "the weights of layer " << this->layer_name_ << " are empty";
+    this->weights_ = weights;
+}
+
+void ParamLayer::set_bias(const std::vector<float> &bias)
+{
+    this->bias_ = bias;
+}
+
+const std::vector<float> &
+ParamLayer::weights() const
+{
+    return this->weights_;
+}
+
+const std::vector<float> &
+ParamLayer::bias() const
+{
+    return this->bias_;
+}
+
+}// namespace jinfer
@@ -0,0 +1,126 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/adaptive_avgpooling.hpp"
+#include "data/workspace.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include <algorithm>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+struct AdaptivePoolingColumnWorkspace;
+
+AdaptiveAvgPoolingLayer::AdaptiveAvgPoolingLayer(uint32_t output_h, uint32_t output_w)
+    : Layer("AdaptiveAvgPooling"), output_h_(output_h), output_w_(output_w)
+{
+}
+
+InferStatus AdaptiveAvgPoolingLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                             std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the adaptive pooling layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the adaptive pooling layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty()) {
+            LOG(ERROR) << "The input tensor in the adaptive pooling layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        if (output == nullptr || output->empty()) {
+            LOG(ERROR) << "The output tensor in the adaptive pooling layer is empty";
+            return InferStatus::kInferFailedOutputEmpty;
+        }
+
+        const uint32_t output_h = output_h_ > 0 ? output_h_ : input->rows();
+        const uint32_t output_w = output_w_ > 0 ? output_w_ : input->cols();
+        if (output->rows() != output_h || output->cols() != output_w
+            || output->channels() != input->channels()) {
+            LOG(ERROR) << "The output tensor shape of the adaptive pooling layer is wrong";
+            return InferStatus::kInferFailedOutputSizeError;
+        }
+    }
+
+    const uint32_t channels = inputs.front()->channels();
+    const uint32_t rows = inputs.front()->rows();
+    const uint32_t cols = inputs.front()->cols();
+    const uint32_t output_rows = outputs.front()->rows();
+    const uint32_t output_cols = outputs.front()->cols();
+
+#pragma omp parallel
+    {
+        float *column_ptr = thread_workspace<AdaptivePoolingColumnWorkspace>(rows);
+#pragma omp for schedule(static)
+        for (uint32_t index = 0; index < batch_size * channels; index++) {
+            const uint32_t b = index / channels;
+            const uint32_t c = index % channels;
+            const float *input = inputs.at(b)->raw_ptr() + size_t(c) * rows * cols;
+            float *output = outputs.at(b)->raw_ptr() + size_t(c) * output_rows * output_cols;
+
+            for (uint32_t ow = 0; ow < output_cols; ow++) {
+                /// 第ow个窗口覆盖[floor(ow * cols / output_cols), ceil((ow + 1) * cols / output_cols))
+                const uint32_t w_start = ow * cols / output_cols;
+                const uint32_t w_end = ((ow + 1) * cols + output_cols - 1) / output_cols;
+
+                std::fill(column_ptr, column_ptr + rows, 0.f);
+                for (uint32_t iw = w_start; iw < w_end; iw++) {
+                    const float *input_col = input + size_t(iw) * rows;
+#pragma omp simd
+                    for (uint32_t r = 0; r < rows; r++) {
+                        column_ptr[r] += input_col[r];
+                    }
+                }
+
+                float *output_col = output + size_t(ow) * output_rows;
+                for (uint32_t oh = 0; oh < output_rows; oh++) {
+                    const uint32_t h_start = oh * rows / output_rows;
+                    const uint32_t h_end = ((oh + 1) * rows + output_rows - 1) / output_rows;
+
+                    float sum = 0.f;
+#pragma omp simd reduction(+ : sum)
+                    for (uint32_t ih = h_start; ih < h_end; ih++) {
+                        sum += column_ptr[ih];
+                    }
+                    output_col[oh] = sum / float((h_end - h_start) * (w_end - w_start));
+                }
+            }
+        }
+    }
+
+    return InferStatus::kInferSuccess;
+}
+
+ParseParameterAttrStatus AdaptiveAvgPoolingLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                                  std::shared_ptr<Layer> &avgpooling_layer)
+{
+    CHECK(op != nullptr) << "adaptive pooling operator is empty";
+
+    auto output_size = op->get_param<RuntimeParameterIntArray>("output_size");
+    if (!output_size || output_size->value.empty() || output_size->value.size() > 2) {
+        LOG(ERROR) << "Can not find the output size parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingOutHW;
+    }
+
+    const int output_h = output_size->value.front();
+    const int output_w = output_size->value.back();
+    avgpooling_layer = std::make_shared<AdaptiveAvgPoolingLayer>(std::max(output_h, 0), std::max(output_w, 0));
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper adaptive_avgpooling_create_instance("nn.AdaptiveAvgPool2d",
+                                                           AdaptiveAvgPoolingLayer::create_instance);
+
+}// namespace jinfer
@@ -0,0 +1,166 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/batchnorm.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include "layer/abstract/reduction.hpp"
+#include <cmath>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+BatchNormLayer::BatchNormLayer(uint32_t num_features, int channel_axis)
+    : ParamLayer("BatchNorm"), num_features_(num_features), channel_axis_(channel_axis)
+{
+    CHECK(channel_axis_ >= 0 && channel_axis_ < 3) << "the channel axis of batchnorm is wrong: " << channel_axis_;
+}
+
+InferStatus BatchNormLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                    std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the batchnorm layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the batchnorm layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    if (this->weights_.size() != num_features_ || this->bias_.size() != num_features_) {
+        LOG(ERROR) << "The scale and shift of the batchnorm layer are wrong";
+        return InferStatus::kInferFailedWeightParameterError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty() || output == nullptr || output->empty()) {
+            LOG(ERROR) << "The input or output tensor in the batchnorm layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        if (input->size() != output->size()) {
+            LOG(ERROR) << "The input and output tensor shapes of the batchnorm layer do not match";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+
+        const AxisSplit split = split_axis(input->channels(), input->rows(), input->cols(), channel_axis_);
+        if (split.length != num_features_) {
+            LOG(ERROR) << "The input channels of the batchnorm layer do not match";
+            return InferStatus::kInferFailedChannelParameterError;
+        }
+
+        const float *in = input->raw_ptr();
+        float *out = output->raw_ptr();
+#pragma omp parallel for collapse(2) if (input->size() > 4096)
+        for (uint32_t o = 0; o < split.outer; o++) {
+            for (uint32_t c = 0; c < split.length; c++) {
+                const float scale = this->weights_[c];
+                const float shift = this->bias_[c];
+                const size_t offset = (size_t(o) * split.length + c) * split.inner;
+#pragma omp simd
+                for (uint32_t j = 0; j < split.inner; j++) {
+                    out[offset + j] = in[offset + j] * scale + shift;
+                }
+            }
+        }
+    }
+
+    return InferStatus::kInferSuccess;
+}
+
+ParseParameterAttrStatus BatchNormLayer::scale_shift(const std::shared_ptr<RuntimeOperator> &op,
+                                                     std::vector<float> &scale, std::vector<float> &shift,
+                                                     bool need_clear_weight)
+{
+    auto eps = op->get_param<RuntimeParameterFloat>("eps");
+    if (!eps) {
+        return ParseParameterAttrStatus::kParameterMissingEps;
+    }
+
+    auto num_features = op->get_param<RuntimeParameterInt>("num_features");
+    if (!num_features) {
+        return ParseParameterAttrStatus::kParameterMissingNumFeatures;
+    }
+
+    auto running_mean = op->attrs.find("running_mean");
+    if (running_mean == op->attrs.end() || running_mean->second->weight_data.empty()) {
+        return ParseParameterAttrStatus::kAttrMissingRunningMean;
+    }
+
+    auto running_var = op->attrs.find("running_var");
+    if (running_var == op->attrs.end() || running_var->second->weight_data.empty()) {
+        return ParseParameterAttrStatus::kAttrMissingRunningVar;
+    }
+
+    const uint32_t channels = num_features->value;
+    const std::vector<float> mean = running_mean->second->get<float>(need_clear_weight);
+    const std::vector<float> var = running_var->second->get<float>(need_clear_weight);
+    if (channels == 0 || mean.size() != channels || var.size() != channels) {
+        return ParseParameterAttrStatus::kParameterMissingNumFeatures;
+    }
+
+    /// affine为False时没有gamma和beta
+    std::vector<float> gamma(channels, 1.f);
+    std::vector<float> beta(channels, 0.f);
+    auto weight = op->attrs.find("weight");
+    if (weight != op->attrs.end() && !weight->second->weight_data.empty()) {
+        gamma = weight->second->get<float>(need_clear_weight);
+    }
+    auto bias = op->attrs.find("bias");
+    if (bias != op->attrs.end() && !bias->second->weight_data.empty()) {
+        beta = bias->second->get<float>(need_clear_weight);
+    }
+    if (gamma.size() != channels || beta.size() != channels) {
+        return ParseParameterAttrStatus::kParameterMissingNumFeatures;
+    }
+
+    scale.resize(channels);
+    shift.resize(channels);
+    for (uint32_t c = 0; c < channels; c++) {
+        scale.at(c) = gamma.at(c) / std::sqrt(var.at(c) + eps->value);
+        shift.at(c) = beta.at(c) - mean.at(c) * scale.at(c);
+    }
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+ParseParameterAttrStatus BatchNormLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                         std::shared_ptr<Layer> &batchnorm_layer)
+{
+    CHECK(op != nullptr) << "batchnorm operator is empty";
+
+    std::vector<float> scale;
+    std::vector<float> shift;
+    const ParseParameterAttrStatus status = scale_shift(op, scale, shift);
+    if (status != ParseParameterAttrStatus::kParameterAttrParseSuccess) {
+        LOG(ERROR) << "Can not read the parameters and attributes of " << op->name << ", status: " << int(status);
+        return status;
+    }
+
+    /// 通道是逻辑维度1，BatchNorm1d的输入可以是(N, C)或(N, C, L)
+    int rank = input_rank_of(op);
+    if (rank == 0) {
+        rank = op->type == "nn.BatchNorm2d" ? 4 : 2;
+    }
+    const int channel_axis = tensor_axis_of(1, rank);
+    if (channel_axis < 0) {
+        LOG(ERROR) << "The input rank " << rank << " of " << op->name << " is not supported";
+        return ParseParameterAttrStatus::kParameterMissingDim;
+    }
+
+    auto batchnorm = std::make_shared<BatchNormLayer>(uint32_t(scale.size()), channel_axis);
+    batchnorm->set_weights(scale);
+    batchnorm->set_bias(shift);
+    batchnorm_layer = batchnorm;
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper batchnorm1d_create_instance("nn.BatchNorm1d", BatchNormLayer::create_instance);
+LayerRegistererWrapper batchnorm2d_create_instance("nn.BatchNorm2d", BatchNormLayer::create_instance);
+
+}// namespace jinfer
@@ -0,0 +1,108 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/concat.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include "layer/abstract/reduction.hpp"
+#include <algorithm>
+#include <array>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+ConcatLayer::ConcatLayer(int axis) : Layer("Concat"), axis_(axis)
+{
+    CHECK(axis_ >= 0 && axis_ < 3) << "the axis of concat layer is invalid: " << axis_;
+}
+
+InferStatus ConcatLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                 std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the concat layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    const uint32_t batch_size = outputs.size();
+    if (batch_size == 0 || inputs.size() % batch_size != 0) {
+        LOG(ERROR) << "The input and output tensor array size of the concat layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+    const uint32_t input_count = inputs.size() / batch_size;
+
+    for (uint32_t b = 0; b < batch_size; b++) {
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(b);
+        if (output == nullptr || output->empty()) {
+            LOG(ERROR) << "The output tensor in the concat layer is empty";
+            return InferStatus::kInferFailedOutputEmpty;
+        }
+
+        const std::array<uint32_t, 3> output_shape = {output->channels(), output->rows(), output->cols()};
+        const AxisSplit split = split_axis(output_shape[0], output_shape[1], output_shape[2], axis_);
+        float *output_data = output->raw_ptr();
+
+        uint32_t offset = 0;
+        for (uint32_t j = 0; j < input_count; j++) {
+            const std::shared_ptr<Tensor<float>> &input = inputs.at(j * batch_size + b);
+            if (input == nullptr || input->empty()) {
+                LOG(ERROR) << "The input tensor in the concat layer is empty";
+                return InferStatus::kInferFailedInputEmpty;
+            }
+
+            std::array<uint32_t, 3> input_shape = {input->channels(), input->rows(), input->cols()};
+            const uint32_t length = input_shape[axis_];
+            input_shape[axis_] = output_shape[axis_];
+            if (input_shape != output_shape || offset + length > split.length) {
+                LOG(ERROR) << "The input tensor shapes of the concat layer do not match the output";
+                return InferStatus::kInferFailedInputOutSizeMatchError;
+            }
+
+            float *piece_data = output_data + size_t(offset) * split.inner;
+            offset += length;
+            /// 前驱节点已直接写入输出中对应的一段
+            if (split.outer == 1 && input->raw_ptr() == piece_data) {
+                continue;
+            }
+
+            const float *input_data = input->raw_ptr();
+            const size_t block = size_t(length) * split.inner;
+            const size_t stride = size_t(split.length) * split.inner;
+            for (uint32_t o = 0; o < split.outer; o++) {
+                std::copy(input_data + o * block, input_data + (o + 1) * block, piece_data + o * stride);
+            }
+        }
+
+        if (offset != split.length) {
+            LOG(ERROR) << "The input tensor shapes of the concat layer do not match the output";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+    }
+    return InferStatus::kInferSuccess;
+}
+
+ParseParameterAttrStatus ConcatLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                      std::shared_ptr<Layer> &concat_layer)
+{
+    CHECK(op != nullptr) << "concat operator is empty";
+
+    auto dim = op->get_param<RuntimeParameterInt>("dim");
+    if (!dim) {
+        LOG(ERROR) << "Can not find the dim parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingDim;
+    }
+
+    const int axis = tensor_axis_of(dim->value, input_rank_of(op));
+    if (axis < 0) {
+        LOG(ERROR) << "The dim " << dim->value << " of " << op->name << " is not supported";
+        return ParseParameterAttrStatus::kParameterMissingDim;
+    }
+
+    concat_layer = std::make_shared<ConcatLayer>(axis);
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper concat_create_instance("torch.cat", ConcatLayer::create_instance);
+
+}// namespace jinfer
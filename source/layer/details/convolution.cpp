@@ -0,0 +1,583 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/convolution.hpp"
+#include "data/workspace.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include "layer/details/layout_transform.hpp"
+#include "math/gemm.hpp"
+#include "runtime/shape_infer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+struct Im2colWorkspace;
+
+ConvolutionLayer::ConvolutionLayer(uint32_t in_channels, uint32_t out_channels,
+                                   uint32_t kernel_h, uint32_t kernel_w,
+                                   uint32_t stride_h, uint32_t stride_w,
+                                   uint32_t padding_h, uint32_t padding_w,
+                                   uint32_t dilation_h, uint32_t dilation_w,
+                                   uint32_t groups, bool use_bias)
+    : ParamLayer("Convolution"),
+      in_channels_(in_channels), out_channels_(out_channels),
+      kernel_h_(kernel_h), kernel_w_(kernel_w),
+      stride_h_(stride_h), stride_w_(stride_w),
+      padding_h_(padding_h), padding_w_(padding_w),
+      dilation_h_(dilation_h), dilation_w_(dilation_w),
+      groups_(groups), use_bias_(use_bias)
+{
+    CHECK(groups_ > 0 && in_channels_ % groups_ == 0 && out_channels_ % groups_ == 0)
+        << "the channels of convolution can not be divided by groups: " << groups_;
+}
+
+void ConvolutionLayer::set_weights(const std::vector<float> &weights)
+{
+    const size_t weight_size = size_t(out_channels_) * (in_channels_ / groups_) * kernel_h_ * kernel_w_;
+    CHECK_EQ(weights.size(), weight_size) << "the weight size of convolution is wrong";
+    ParamLayer::set_weights(weights);
+    this->pack_blocked_weights();
+}
+
+void ConvolutionLayer::set_bias(const std::vector<float> &bias)
+{
+    CHECK(bias.empty() || bias.size() == out_channels_) << "the bias size of convolution is wrong";
+    ParamLayer::set_bias(bias);
+    this->pack_blocked_weights();
+}
+
+void ConvolutionLayer::set_activation(ActivationType activation)
+{
+    this->activation_ = activation;
+}
+
+ActivationType ConvolutionLayer::activation() const
+{
+    return this->activation_;
+}
+
+void ConvolutionLayer::set_blocked_layout(bool blocked)
+{
+    CHECK(!blocked || groups_ == 1) << "the blocked layout only supports the convolution with one group";
+    this->blocked_ = blocked;
+    this->pack_blocked_weights();
+}
+
+void ConvolutionLayer::pack_blocked_weights()
+{
+    this->blocked_weights_.clear();
+    this->blocked_bias_.clear();
+    if (!this->blocked_ || this->weights_.empty()) {
+        return;
+    }
+
+    const uint32_t out_blocks = channel_blocks(out_channels_);
+    const uint32_t kernel_size = kernel_h_ * kernel_w_;
+    this->blocked_weights_.assign(size_t(out_blocks) * in_channels_ * kernel_size * kChannelBlock, 0.f);
+    for (uint32_t o = 0; o < out_channels_; o++) {
+        const uint32_t out_block = o / kChannelBlock;
+        const uint32_t lane = o % kChannelBlock;
+        for (uint32_t i = 0; i < in_channels_; i++) {
+            for (uint32_t k = 0; k < kernel_size; k++) {
+                const size_t src = (size_t(o) * in_channels_ + i) * kernel_size + k;
+                const size_t dst = ((size_t(out_block) * in_channels_ + i) * kernel_size + k) * kChannelBlock + lane;
+                this->blocked_weights_.at(dst) = this->weights_.at(src);
+            }
+        }
+    }
+
+    this->blocked_bias_.assign(size_t(out_blocks) * kChannelBlock, 0.f);
+    if (use_bias_ && this->bias_.size() == out_channels_) {
+        std::copy(this->bias_.begin(), this->bias_.end(), this->blocked_bias_.begin());
+    }
+}
+
+bool ConvolutionLayer::is_pointwise() const
+{
+    return kernel_h_ == 1 && kernel_w_ == 1 && stride_h_ == 1 && stride_w_ == 1
+           && padding_h_ == 0 && padding_w_ == 0;
+}
+
+bool ConvolutionLayer::is_depthwise() const
+{
+    return groups_ > 1 && groups_ == in_channels_;
+}
+
+/// 输入行oh * stride + offset落在[0, rows)内的输出行是[begin, end)
+static void
+valid_output_rows(int offset, uint32_t rows, uint32_t output_rows, uint32_t stride, int &begin, int &end)
+{
+    begin = offset >= 0 ? 0 : std::min(int(output_rows), (-offset + int(stride) - 1) / int(stride));
+    end = int(rows) - 1 - offset < 0 ? 0 : std::min(int(output_rows), (int(rows) - 1 - offset) / int(stride) + 1);
+}
+
+InferStatus ConvolutionLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                      std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the convolution layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the convolution layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    if (this->weights_.empty()) {
+        LOG(ERROR) << "The weights of the convolution layer are empty";
+        return InferStatus::kInferFailedWeightParameterError;
+    }
+
+    if (use_bias_ && this->bias_.size() != out_channels_) {
+        LOG(ERROR) << "The bias of the convolution layer is wrong";
+        return InferStatus::kInferFailedBiasParameterError;
+    }
+
+    if (stride_h_ == 0 || stride_w_ == 0 || dilation_h_ == 0 || dilation_w_ == 0) {
+        LOG(ERROR) << "The stride or dilation parameter of the convolution layer is zero";
+        return InferStatus::kInferFailedStrideParameterError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty()) {
+            LOG(ERROR) << "The input tensor in the convolution layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        /// NCHW8c布局时张量的通道数为组数，行数为逻辑行数乘以8
+        const uint32_t lanes = blocked_ ? kChannelBlock : 1;
+        const uint32_t physical_in_channels = blocked_ ? channel_blocks(in_channels_) : in_channels_;
+        const uint32_t physical_out_channels = blocked_ ? channel_blocks(out_channels_) : out_channels_;
+        if (input->channels() != physical_in_channels || input->rows() % lanes != 0) {
+            LOG(ERROR) << "The input channels of the convolution layer do not match";
+            return InferStatus::kInferFailedChannelParameterError;
+        }
+
+        if (output == nullptr || output->empty()) {
+            LOG(ERROR) << "The output tensor in the convolution layer is empty";
+            return InferStatus::kInferFailedOutputEmpty;
+        }
+
+        const int output_rows = window_output_size(int(input->rows() / lanes), int(kernel_h_), int(stride_h_),
+                                                   int(padding_h_), int(dilation_h_), false);
+        const int output_cols = window_output_size(int(input->cols()), int(kernel_w_), int(stride_w_),
+                                                   int(padding_w_), int(dilation_w_), false);
+        if (output_rows <= 0 || output_cols <= 0 || output->rows() != uint32_t(output_rows) * lanes
+            || output->cols() != uint32_t(output_cols) || output->channels() != physical_out_channels) {
+            LOG(ERROR) << "The output tensor shape of the convolution layer is wrong";
+            return InferStatus::kInferFailedOutputSizeError;
+        }
+    }
+
+    if (blocked_) {
+        return this->forward_blocked(inputs, outputs);
+    }
+    if (this->is_depthwise()) {
+        return this->forward_depthwise(inputs, outputs);
+    }
+
+    const uint32_t rows = inputs.front()->rows();
+    const uint32_t cols = inputs.front()->cols();
+    const uint32_t output_rows = outputs.front()->rows();
+    const uint32_t output_cols = outputs.front()->cols();
+    const uint32_t output_size = output_rows * output_cols;
+
+    const uint32_t in_channels_per_group = in_channels_ / groups_;
+    const uint32_t out_channels_per_group = out_channels_ / groups_;
+    const uint32_t col_len = in_channels_per_group * kernel_h_ * kernel_w_;
+
+    /// 展开矩阵放在线程私有的缓冲区中，同一线程后续的推理直接复用
+    const bool pointwise = this->is_pointwise();
+    float *col = pointwise ? nullptr : thread_workspace<Im2colWorkspace>(size_t(output_size) * col_len);
+
+    for (uint32_t b = 0; b < batch_size; b++) {
+        const float *input = inputs.at(b)->raw_ptr();
+        float *output = outputs.at(b)->raw_ptr();
+
+        for (uint32_t g = 0; g < groups_; g++) {
+            const float *input_group = input + size_t(g) * in_channels_per_group * rows * cols;
+
+            /// 输入的每个通道在内存中恰好是展开矩阵的一列
+            const float *col_ptr = input_group;
+            if (!pointwise) {
+                this->im2col(input_group, rows, cols, output_rows, output_cols, col);
+                col_ptr = col;
+            }
+
+            /// 行主序的权重(out_channels, col_len)即列主序的col_len x out_channels矩阵，
+            /// 乘积的每一列恰好是一个输出通道的连续内存
+            sgemm(output_size, out_channels_per_group, col_len,
+                  col_ptr, output_size,
+                  this->weights_.data() + size_t(g) * out_channels_per_group * col_len, col_len,
+                  output + size_t(g) * out_channels_per_group * output_size, output_size);
+        }
+
+        if (use_bias_ || activation_ != ActivationType::kActivationNone) {
+#pragma omp parallel for if (out_channels_ * output_size > 65536)
+            for (uint32_t o = 0; o < out_channels_; o++) {
+                float *output_channel = output + size_t(o) * output_size;
+                if (use_bias_) {
+                    const float bias = this->bias_.at(o);
+#pragma omp simd
+                    for (uint32_t p = 0; p < output_size; p++) {
+                        output_channel[p] += bias;
+                    }
+                }
+                apply_activation(activation_, output_channel, output_size);
+            }
+        }
+    }
+
+    return InferStatus::kInferSuccess;
+}
+
+InferStatus ConvolutionLayer::forward_depthwise(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                                std::vector<std::shared_ptr<Tensor<float>>> &outputs) const
+{
+    const uint32_t rows = inputs.front()->rows();
+    const uint32_t cols = inputs.front()->cols();
+    const uint32_t output_rows = outputs.front()->rows();
+    const uint32_t output_cols = outputs.front()->cols();
+    const uint32_t multiplier = out_channels_ / in_channels_;
+    const uint32_t kernel_size = kernel_h_ * kernel_w_;
+
+    for (uint32_t b = 0; b < inputs.size(); b++) {
+        const float *input = inputs.at(b)->raw_ptr();
+        float *output = outputs.at(b)->raw_ptr();
+
+#pragma omp parallel for schedule(static)
+        for (uint32_t o = 0; o < out_channels_; o++) {
+            const float *input_channel = input + size_t(o / multiplier) * rows * cols;
+            const float *weights = this->weights_.data() + size_t(o) * kernel_size;
+            const float bias = use_bias_ ? this->bias_.at(o) : 0.f;
+            float *output_channel = output + size_t(o) * output_rows * output_cols;
+            if (kernel_h_ == 3 && kernel_w_ == 3) {
+                this->depthwise_channel<3>(input_channel, rows, cols, weights, bias, output_channel, output_rows,
+                                           output_cols);
+            } else if (kernel_h_ == 5 && kernel_w_ == 5) {
+                this->depthwise_channel<5>(input_channel, rows, cols, weights, bias, output_channel, output_rows,
+                                           output_cols);
+            } else {
+                this->depthwise_channel<0>(input_channel, rows, cols, weights, bias, output_channel, output_rows,
+                                           output_cols);
+            }
+        }
+    }
+    return InferStatus::kInferSuccess;
+}
+
+template<uint32_t kernel>
+void ConvolutionLayer::depthwise_channel(const float *input, uint32_t rows, uint32_t cols,
+                                         const float *weights, float bias,
+                                         float *output, uint32_t output_rows, uint32_t output_cols) const
+{
+    const uint32_t kernel_h = kernel != 0 ? kernel : kernel_h_;
+    const uint32_t kernel_w = kernel != 0 ? kernel : kernel_w_;
+    const int stride_h = int(stride_h_);
+
+    for (uint32_t ow = 0; ow < output_cols; ow++) {
+        float *output_col = output + size_t(ow) * output_rows;
+        std::fill(output_col, output_col + output_rows, bias);
+
+        for (uint32_t kw = 0; kw < kernel_w; kw++) {
+            const int iw = int(ow * stride_w_) - int(padding_w_) + int(kw * dilation_w_);
+            if (iw < 0 || iw >= int(cols)) {
+                continue;
+            }
+
+            const float *input_col = input + size_t(iw) * rows;
+            for (uint32_t kh = 0; kh < kernel_h; kh++) {
+                const int offset_h = int(kh * dilation_h_) - int(padding_h_);
+                int oh_begin = 0;
+                int oh_end = 0;
+                valid_output_rows(offset_h, rows, output_rows, stride_h_, oh_begin, oh_end);
+
+                const float w = weights[kh * kernel_w + kw];
+                if (stride_h == 1) {
+#pragma omp simd
+                    for (int oh = oh_begin; oh < oh_end; oh++) {
+                        output_col[oh] += w * input_col[oh + offset_h];
+                    }
+                } else {
+#pragma omp simd
+                    for (int oh = oh_begin; oh < oh_end; oh++) {
+                        output_col[oh] += w * input_col[oh * stride_h + offset_h];
+                    }
+                }
+            }
+        }
+        apply_activation(activation_, output_col, output_rows);
+    }
+}
+
+InferStatus ConvolutionLayer::forward_blocked(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                              std::vector<std::shared_ptr<Tensor<float>>> &outputs) const
+{
+    if (this->blocked_weights_.empty()) {
+        LOG(ERROR) << "The blocked weights of the convolution layer are empty";
+        return InferStatus::kInferFailedWeightParameterError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    const uint32_t rows = inputs.front()->rows() / kChannelBlock;
+    const uint32_t cols = inputs.front()->cols();
+    const uint32_t output_rows = outputs.front()->rows() / kChannelBlock;
+    const uint32_t output_cols = outputs.front()->cols();
+    const uint32_t out_blocks = channel_blocks(out_channels_);
+
+    for (uint32_t b = 0; b < batch_size; b++) {
+        const float *input = inputs.at(b)->raw_ptr();
+        float *output = outputs.at(b)->raw_ptr();
+
+#pragma omp parallel for collapse(2) schedule(static)
+        for (uint32_t ob = 0; ob < out_blocks; ob++) {
+            for (uint32_t ow = 0; ow < output_cols; ow++) {
+                float *output_col = output + (size_t(ob) * output_cols + ow) * output_rows * kChannelBlock;
+                this->conv_blocked_column(input, rows, cols, ob, ow, output_col, output_rows);
+            }
+        }
+    }
+    return InferStatus::kInferSuccess;
+}
+
+void ConvolutionLayer::conv_blocked_column(const float *input, uint32_t rows, uint32_t cols,
+                                           uint32_t out_block, uint32_t ow,
+                                           float *output, uint32_t output_rows) const
+{
+    /// 一次计算tile个输出行，累加器为tile x 8，可以全部放在向量寄存器中
+    constexpr uint32_t tile = 8;
+    const uint32_t kernel_size = kernel_h_ * kernel_w_;
+    const size_t plane_size = size_t(rows) * cols * kChannelBlock;
+    const float *weights = this->blocked_weights_.data() + size_t(out_block) * in_channels_ * kernel_size * kChannelBlock;
+    const float *bias = this->blocked_bias_.data() + size_t(out_block) * kChannelBlock;
+
+    for (uint32_t oh_begin = 0; oh_begin < output_rows; oh_begin += tile) {
+        const uint32_t tile_rows = std::min(tile, output_rows - oh_begin);
+        float acc[tile][kChannelBlock];
+        for (uint32_t t = 0; t < tile; t++) {
+#pragma omp simd
+            for (uint32_t l = 0; l < kChannelBlock; l++) {
+                acc[t][l] = bias[l];
+            }
+        }
+
+        for (uint32_t kw = 0; kw < kernel_w_; kw++) {
+            const int iw = int(ow * stride_w_) - int(padding_w_) + int(kw * dilation_w_);
+            if (iw < 0 || iw >= int(cols)) {
+                continue;
+            }
+
+            for (uint32_t kh = 0; kh < kernel_h_; kh++) {
+                /// 与im2col相同，输入行落在[0, rows)内的是tile中的[t_begin, t_end)
+                const int offset_h = int(kh * dilation_h_) - int(padding_h_) + int(oh_begin * stride_h_);
+                int t_begin = 0;
+                while (t_begin < int(tile_rows) && t_begin * int(stride_h_) + offset_h < 0) {
+                    t_begin += 1;
+                }
+                int t_end = int(tile_rows);
+                while (t_end > t_begin && (t_end - 1) * int(stride_h_) + offset_h >= int(rows)) {
+                    t_end -= 1;
+                }
+                if (t_begin >= t_end) {
+                    continue;
+                }
+
+                const size_t column_offset = size_t(iw) * rows * kChannelBlock;
+                const float *weight_k = weights + size_t(kh * kernel_w_ + kw) * kChannelBlock;
+                for (uint32_t ic = 0; ic < in_channels_; ic++) {
+                    const float *input_col = input + size_t(ic / kChannelBlock) * plane_size + column_offset
+                                             + ic % kChannelBlock;
+                    const float *w = weight_k + size_t(ic) * kernel_size * kChannelBlock;
+                    for (int t = t_begin; t < t_end; t++) {
+                        const float x = input_col[size_t(t * int(stride_h_) + offset_h) * kChannelBlock];
+#pragma omp simd
+                        for (uint32_t l = 0; l < kChannelBlock; l++) {
+                            acc[t][l] += x * w[l];
+                        }
+                    }
+                }
+            }
+        }
+
+        for (uint32_t t = 0; t < tile_rows; t++) {
+            apply_activation(activation_, acc[t], kChannelBlock);
+            std::copy(acc[t], acc[t] + kChannelBlock, output + size_t(oh_begin + t) * kChannelBlock);
+        }
+    }
+}
+
+void ConvolutionLayer::im2col(const float *input, uint32_t rows, uint32_t cols,
+                              uint32_t output_rows, uint32_t output_cols, float *col) const
+{
+    const uint32_t in_channels_per_group = in_channels_ / groups_;
+    const uint32_t col_len = in_channels_per_group * kernel_h_ * kernel_w_;
+    const uint32_t output_size = output_rows * output_cols;
+
+#pragma omp parallel for schedule(static)
+    for (uint32_t k = 0; k < col_len; k++) {
+        const uint32_t ic = k / (kernel_h_ * kernel_w_);
+        const uint32_t kh = (k / kernel_w_) % kernel_h_;
+        const uint32_t kw = k % kernel_w_;
+
+        const float *input_channel = input + size_t(ic) * rows * cols;
+        float *col_k = col + size_t(k) * output_size;
+
+        /// ih = oh * stride_h - padding_h + kh * dilation_h落在[0, rows)内的输出行是[oh_begin, oh_end)
+        const int offset_h = int(kh * dilation_h_) - int(padding_h_);
+        int oh_begin = 0;
+        int oh_end = 0;
+        valid_output_rows(offset_h, rows, output_rows, stride_h_, oh_begin, oh_end);
+
+        for (uint32_t ow = 0; ow < output_cols; ow++) {
+            float *dst = col_k + size_t(ow) * output_rows;
+            const int iw = int(ow * stride_w_) - int(padding_w_) + int(kw * dilation_w_);
+            if (iw < 0 || iw >= int(cols) || oh_begin >= oh_end) {
+                std::fill(dst, dst + output_rows, 0.f);
+                continue;
+            }
+
+            const float *input_col = input_channel + size_t(iw) * rows;
+            std::fill(dst, dst + oh_begin, 0.f);
+            if (stride_h_ == 1) {
+                std::memcpy(dst + oh_begin, input_col + oh_begin + offset_h, (oh_end - oh_begin) * sizeof(float));
+            } else {
+                for (int oh = oh_begin; oh < oh_end; oh++) {
+                    dst[oh] = input_col[oh * int(stride_h_) + offset_h];
+                }
+            }
+            std::fill(dst + oh_end, dst + output_rows, 0.f);
+        }
+    }
+}
+
+ParseParameterAttrStatus ConvolutionLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                           std::shared_ptr<Layer> &conv_layer)
+{
+    CHECK(op != nullptr) << "convolution operator is empty";
+
+    auto in_channels = op->get_param<RuntimeParameterInt>("in_channels");
+    if (!in_channels) {
+        LOG(ERROR) << "Can not find the in channel parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingInChannel;
+    }
+
+    auto out_channels = op->get_param<RuntimeParameterInt>("out_channels");
+    if (!out_channels) {
+        LOG(ERROR) << "Can not find the out channel parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingOutChannel;
+    }
+
+    auto kernel_size = op->get_param<RuntimeParameterIntArray>("kernel_size");
+    if (!kernel_size || kernel_size->value.size() != 2) {
+        LOG(ERROR) << "Can not find the kernel size parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingKernel;
+    }
+
+    auto stride = op->get_param<RuntimeParameterIntArray>("stride");
+    if (!stride || stride->value.size() != 2) {
+        LOG(ERROR) << "Can not find the stride parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingStride;
+    }
+
+    auto dilation = op->get_param<RuntimeParameterIntArray>("dilation");
+    if (!dilation || dilation->value.size() != 2) {
+        LOG(ERROR) << "Can not find the dilation parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingDilation;
+    }
+
+    auto groups = op->get_param<RuntimeParameterInt>("groups");
+    if (!groups) {
+        LOG(ERROR) << "Can not find the groups parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingGroups;
+    }
+
+    auto use_bias = op->get_param<RuntimeParameterBool>("bias");
+    if (!use_bias) {
+        LOG(ERROR) << "Can not find the bias parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingUseBias;
+    }
+
+    auto padding_mode = op->get_param<RuntimeParameterString>("padding_mode");
+    if (padding_mode && padding_mode->value != "zeros") {
+        LOG(ERROR) << "Unsupported padding mode " << padding_mode->value << " of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingPaddingMode;
+    }
+
+    const uint32_t kernel_h = kernel_size->value.at(0);
+    const uint32_t kernel_w = kernel_size->value.at(1);
+    const uint32_t dilation_h = dilation->value.at(0);
+    const uint32_t dilation_w = dilation->value.at(1);
+
+    uint32_t padding_h = 0;
+    uint32_t padding_w = 0;
+    auto padding = op->get_param<RuntimeParameterIntArray>("padding");
+    auto padding_str = op->get_param<RuntimeParameterString>("padding");
+    if (padding && padding->value.size() == 2) {
+        padding_h = padding->value.at(0);
+        padding_w = padding->value.at(1);
+    } else if (padding_str && padding_str->value == "same") {
+        /// 只支持两侧对称的same填充
+        const uint32_t total_h = dilation_h * (kernel_h - 1);
+        const uint32_t total_w = dilation_w * (kernel_w - 1);
+        if (total_h % 2 != 0 || total_w % 2 != 0) {
+            LOG(ERROR) << "Unsupported asymmetric same padding of " << op->name;
+            return ParseParameterAttrStatus::kParameterMissingPadding;
+        }
+        padding_h = total_h / 2;
+        padding_w = total_w / 2;
+    } else if (!padding_str || padding_str->value != "valid") {
+        LOG(ERROR) << "Can not find the padding parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingPadding;
+    }
+
+    auto conv = std::make_shared<ConvolutionLayer>(
+        in_channels->value, out_channels->value,
+        kernel_h, kernel_w,
+        stride->value.at(0), stride->value.at(1),
+        padding_h, padding_w,
+        dilation_h, dilation_w,
+        groups->value, use_bias->value);
+
+    /// 布局需在设置权重之前确定，权重只重排一次
+    auto layout = op->get_param<RuntimeParameterString>("layout");
+    if (layout && layout->value == kBlockedLayoutName) {
+        conv->set_blocked_layout(true);
+    }
+
+    auto weight = op->attrs.find("weight");
+    if (weight == op->attrs.end() || weight->second->weight_data.empty()) {
+        LOG(ERROR) << "Can not find the weight attribute of " << op->name;
+        return ParseParameterAttrStatus::kAttrMissingWeight;
+    }
+    conv->set_weights(weight->second->get<float>());
+
+    if (use_bias->value) {
+        auto bias = op->attrs.find("bias");
+        if (bias == op->attrs.end() || bias->second->weight_data.empty()) {
+            LOG(ERROR) << "Can not find the bias attribute of " << op->name;
+            return ParseParameterAttrStatus::kAttrMissingBias;
+        }
+        conv->set_bias(bias->second->get<float>());
+    }
+
+    /// 构建计算图时融合进来的激活函数
+    auto activation = op->get_param<RuntimeParameterString>("activation");
+    if (activation) {
+        conv->set_activation(activation_type_of(activation->value));
+    }
+
+    conv_layer = conv;
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper conv_create_instance("nn.Conv2d", ConvolutionLayer::create_instance);
+
+}// namespace jinfer
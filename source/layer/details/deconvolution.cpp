@@ -0,0 +1,304 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/deconvolution.hpp"
+#include "data/workspace.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include "math/gemm.hpp"
+#include "runtime/shape_infer.hpp"
+#include <algorithm>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+struct Col2imWorkspace;
+
+DeconvolutionLayer::DeconvolutionLayer(uint32_t in_channels, uint32_t out_channels,
+                                       uint32_t kernel_h, uint32_t kernel_w,
+                                       uint32_t stride_h, uint32_t stride_w,
+                                       uint32_t padding_h, uint32_t padding_w,
+                                       uint32_t output_padding_h, uint32_t output_padding_w,
+                                       uint32_t dilation_h, uint32_t dilation_w,
+                                       uint32_t groups, bool use_bias)
+    : ParamLayer("Deconvolution"),
+      in_channels_(in_channels), out_channels_(out_channels),
+      kernel_h_(kernel_h), kernel_w_(kernel_w),
+      stride_h_(stride_h), stride_w_(stride_w),
+      padding_h_(padding_h), padding_w_(padding_w),
+      output_padding_h_(output_padding_h), output_padding_w_(output_padding_w),
+      dilation_h_(dilation_h), dilation_w_(dilation_w),
+      groups_(groups), use_bias_(use_bias)
+{
+    CHECK(groups_ > 0 && in_channels_ % groups_ == 0 && out_channels_ % groups_ == 0)
+        << "the channels of deconvolution can not be divided by groups: " << groups_;
+}
+
+void DeconvolutionLayer::set_weights(const std::vector<float> &weights)
+{
+    const uint32_t in_channels_per_group = in_channels_ / groups_;
+    const uint32_t col_len = out_channels_ / groups_ * kernel_h_ * kernel_w_;
+    CHECK_EQ(weights.size(), size_t(in_channels_) * col_len) << "the weight size of deconvolution is wrong";
+
+    /// packed[g][j][i] = W[g * in_channels_per_group + i][j]，即每组的列主序in_channels_per_group x col_len矩阵
+    this->packed_weights_.resize(weights.size());
+    for (uint32_t g = 0; g < groups_; g++) {
+        const float *weight_group = weights.data() + size_t(g) * in_channels_per_group * col_len;
+        float *packed_group = this->packed_weights_.data() + size_t(g) * in_channels_per_group * col_len;
+        for (uint32_t i = 0; i < in_channels_per_group; i++) {
+            for (uint32_t j = 0; j < col_len; j++) {
+                packed_group[size_t(j) * in_channels_per_group + i] = weight_group[size_t(i) * col_len + j];
+            }
+        }
+    }
+}
+
+void DeconvolutionLayer::set_bias(const std::vector<float> &bias)
+{
+    CHECK(bias.empty() || bias.size() == out_channels_) << "the bias size of deconvolution is wrong";
+    ParamLayer::set_bias(bias);
+}
+
+InferStatus DeconvolutionLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                        std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the deconvolution layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the deconvolution layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    if (this->packed_weights_.empty()) {
+        LOG(ERROR) << "The weights of the deconvolution layer are empty";
+        return InferStatus::kInferFailedWeightParameterError;
+    }
+
+    if (use_bias_ && this->bias_.size() != out_channels_) {
+        LOG(ERROR) << "The bias of the deconvolution layer is wrong";
+        return InferStatus::kInferFailedBiasParameterError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty()) {
+            LOG(ERROR) << "The input tensor in the deconvolution layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+        if (input->channels() != in_channels_ || input->rows() != inputs.front()->rows()
+            || input->cols() != inputs.front()->cols()) {
+            LOG(ERROR) << "The input channels of the deconvolution layer do not match";
+            return InferStatus::kInferFailedChannelParameterError;
+        }
+
+        if (output == nullptr || output->empty()) {
+            LOG(ERROR) << "The output tensor in the deconvolution layer is empty";
+            return InferStatus::kInferFailedOutputEmpty;
+        }
+
+        const int output_rows = transposed_window_output_size(int(input->rows()), int(kernel_h_), int(stride_h_),
+                                                              int(padding_h_), int(dilation_h_),
+                                                              int(output_padding_h_));
+        const int output_cols = transposed_window_output_size(int(input->cols()), int(kernel_w_), int(stride_w_),
+                                                              int(padding_w_), int(dilation_w_),
+                                                              int(output_padding_w_));
+        if (output_rows <= 0 || output_cols <= 0 || output->rows() != uint32_t(output_rows)
+            || output->cols() != uint32_t(output_cols) || output->channels() != out_channels_) {
+            LOG(ERROR) << "The output tensor shape of the deconvolution layer is wrong";
+            return InferStatus::kInferFailedOutputSizeError;
+        }
+    }
+
+    const uint32_t rows = inputs.front()->rows();
+    const uint32_t cols = inputs.front()->cols();
+    const uint32_t input_size = rows * cols;
+    const uint32_t output_rows = outputs.front()->rows();
+    const uint32_t output_cols = outputs.front()->cols();
+    const uint32_t output_size = output_rows * output_cols;
+
+    const uint32_t in_channels_per_group = in_channels_ / groups_;
+    const uint32_t kernel_size = kernel_h_ * kernel_w_;
+    const uint32_t col_len = out_channels_ / groups_ * kernel_size;
+
+    /// 所有组的列缓冲区依次排列，第o个输出通道的kernel_size列从o * kernel_size列开始
+    float *col = thread_workspace<Col2imWorkspace>(size_t(input_size) * out_channels_ * kernel_size);
+
+    for (uint32_t b = 0; b < batch_size; b++) {
+        const float *input = inputs.at(b)->raw_ptr();
+        float *output = outputs.at(b)->raw_ptr();
+
+        /// 输入的每个通道在内存中恰好是列主序input_size x in_channels_per_group矩阵的一列，
+        /// 乘积的每一列是所有输入位置对一个(输出通道, kh, kw)的贡献
+        for (uint32_t g = 0; g < groups_; g++) {
+            sgemm(input_size, col_len, in_channels_per_group,
+                  input + size_t(g) * in_channels_per_group * input_size, input_size,
+                  this->packed_weights_.data() + size_t(g) * in_channels_per_group * col_len, in_channels_per_group,
+                  col + size_t(g) * col_len * input_size, input_size);
+        }
+
+#pragma omp parallel for schedule(static)
+        for (uint32_t o = 0; o < out_channels_; o++) {
+            const float bias = use_bias_ ? this->bias_.at(o) : 0.f;
+            this->col2im(col + size_t(o) * kernel_size * input_size, rows, cols, bias,
+                         output + size_t(o) * output_size, output_rows, output_cols);
+        }
+    }
+
+    return InferStatus::kInferSuccess;
+}
+
+void DeconvolutionLayer::col2im(const float *col, uint32_t rows, uint32_t cols, float bias,
+                                float *output, uint32_t output_rows, uint32_t output_cols) const
+{
+    const uint32_t input_size = rows * cols;
+    const int stride_h = int(stride_h_);
+    std::fill(output, output + size_t(output_rows) * output_cols, bias);
+
+    for (uint32_t kh = 0; kh < kernel_h_; kh++) {
+        /// oh = ih * stride_h - padding_h + kh * dilation_h落在[0, output_rows)内的输入行是[ih_begin, ih_end)
+        const int offset_h = int(kh * dilation_h_) - int(padding_h_);
+        const int ih_begin = offset_h >= 0 ? 0 : std::min(int(rows), (-offset_h + stride_h - 1) / stride_h);
+        const int ih_end = int(output_rows) - 1 - offset_h < 0
+                               ? 0
+                               : std::min(int(rows), (int(output_rows) - 1 - offset_h) / stride_h + 1);
+        if (ih_begin >= ih_end) {
+            continue;
+        }
+
+        for (uint32_t kw = 0; kw < kernel_w_; kw++) {
+            const float *col_k = col + size_t(kh * kernel_w_ + kw) * input_size;
+            for (uint32_t iw = 0; iw < cols; iw++) {
+                const int ow = int(iw * stride_w_) - int(padding_w_) + int(kw * dilation_w_);
+                if (ow < 0 || ow >= int(output_cols)) {
+                    continue;
+                }
+
+                const float *src = col_k + size_t(iw) * rows;
+                float *dst = output + size_t(ow) * output_rows;
+                if (stride_h == 1) {
+#pragma omp simd
+                    for (int ih = ih_begin; ih < ih_end; ih++) {
+                        dst[ih + offset_h] += src[ih];
+                    }
+                } else {
+#pragma omp simd
+                    for (int ih = ih_begin; ih < ih_end; ih++) {
+                        dst[ih * stride_h + offset_h] += src[ih];
+                    }
+                }
+            }
+        }
+    }
+}
+
+ParseParameterAttrStatus DeconvolutionLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                             std::shared_ptr<Layer> &deconv_layer)
+{
+    CHECK(op != nullptr) << "deconvolution operator is empty";
+
+    auto in_channels = op->get_param<RuntimeParameterInt>("in_channels");
+    if (!in_channels) {
+        LOG(ERROR) << "Can not find the in channel parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingInChannel;
+    }
+
+    auto out_channels = op->get_param<RuntimeParameterInt>("out_channels");
+    if (!out_channels) {
+        LOG(ERROR) << "Can not find the out channel parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingOutChannel;
+    }
+
+    auto kernel_size = op->get_param<RuntimeParameterIntArray>("kernel_size");
+    if (!kernel_size || kernel_size->value.size() != 2) {
+        LOG(ERROR) << "Can not find the kernel size parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingKernel;
+    }
+
+    auto stride = op->get_param<RuntimeParameterIntArray>("stride");
+    if (!stride || stride->value.size() != 2) {
+        LOG(ERROR) << "Can not find the stride parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingStride;
+    }
+
+    auto padding = op->get_param<RuntimeParameterIntArray>("padding");
+    if (!padding || padding->value.size() != 2) {
+        LOG(ERROR) << "Can not find the padding parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingPadding;
+    }
+
+    auto dilation = op->get_param<RuntimeParameterIntArray>("dilation");
+    if (!dilation || dilation->value.size() != 2) {
+        LOG(ERROR) << "Can not find the dilation parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingDilation;
+    }
+
+    auto groups = op->get_param<RuntimeParameterInt>("groups");
+    if (!groups) {
+        LOG(ERROR) << "Can not find the groups parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingGroups;
+    }
+
+    auto use_bias = op->get_param<RuntimeParameterBool>("bias");
+    if (!use_bias) {
+        LOG(ERROR) << "Can not find the bias parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingUseBias;
+    }
+
+    auto padding_mode = op->get_param<RuntimeParameterString>("padding_mode");
+    if (padding_mode && padding_mode->value != "zeros") {
+        LOG(ERROR) << "Unsupported padding mode " << padding_mode->value << " of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingPaddingMode;
+    }
+
+    /// 旧版本导出的模型可能没有output_padding，此时为0
+    uint32_t output_padding_h = 0;
+    uint32_t output_padding_w = 0;
+    auto output_padding = op->get_param<RuntimeParameterIntArray>("output_padding");
+    if (output_padding) {
+        if (output_padding->value.size() != 2) {
+            LOG(ERROR) << "The output padding parameter of " << op->name << " is wrong";
+            return ParseParameterAttrStatus::kParameterMissingPadding;
+        }
+        output_padding_h = output_padding->value.at(0);
+        output_padding_w = output_padding->value.at(1);
+    }
+
+    auto deconv = std::make_shared<DeconvolutionLayer>(
+        in_channels->value, out_channels->value,
+        kernel_size->value.at(0), kernel_size->value.at(1),
+        stride->value.at(0), stride->value.at(1),
+        padding->value.at(0), padding->value.at(1),
+        output_padding_h, output_padding_w,
+        dilation->value.at(0), dilation->value.at(1),
+        groups->value, use_bias->value);
+
+    /// 构建时读取权重并重排，原始权重在读取后释放
+    auto weight = op->attrs.find("weight");
+    if (weight == op->attrs.end() || weight->second->weight_data.empty()) {
+        LOG(ERROR) << "Can not find the weight attribute of " << op->name;
+        return ParseParameterAttrStatus::kAttrMissingWeight;
+    }
+    deconv->set_weights(weight->second->get<float>());
+
+    if (use_bias->value) {
+        auto bias = op->attrs.find("bias");
+        if (bias == op->attrs.end() || bias->second->weight_data.empty()) {
+            LOG(ERROR) << "Can not find the bias attribute of " << op->name;
+            return ParseParameterAttrStatus::kAttrMissingBias;
+        }
+        deconv->set_bias(bias->second->get<float>());
+    }
+
+    deconv_layer = deconv;
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper deconv_create_instance("nn.ConvTranspose2d", DeconvolutionLayer::create_instance);
+
+}// namespace jinfer
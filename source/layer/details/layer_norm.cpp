@@ -0,0 +1,298 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/layer_norm.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include "layer/abstract/reduction.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+/// 合并两组Welford统计量(Chan et al.)，结果写入第一组
+static void
+merge_moments(float &count, float &mean, float &m2, float other_count, float other_mean, float other_m2)
+{
+    const float total = count + other_count;
+    if (total == 0.f) {
+        return;
+    }
+    const float delta = other_mean - mean;
+    mean += delta * other_count / total;
+    m2 += other_m2 + delta * delta * count * other_count / total;
+    count = total;
+}
+
+/// 连续存放的一行，gamma和beta为空时不做缩放和偏移
+static void
+layer_norm_row(const float *input, float *output, uint32_t length, float eps,
+               const float *gamma, const float *beta)
+{
+    constexpr uint32_t lanes = LayerNormLayer::kLanes;
+    float means[lanes] = {0.f};
+    float m2s[lanes] = {0.f};
+
+    /// 每一路处理下标模lanes相同的元素，各路的计数相同
+    const uint32_t steps = length / lanes;
+    for (uint32_t s = 0; s < steps; s++) {
+        const float *x = input + size_t(s) * lanes;
+        const float inv_count = 1.f / float(s + 1);
+#pragma omp simd
+        for (uint32_t j = 0; j < lanes; j++) {
+            const float delta = x[j] - means[j];
+            means[j] += delta * inv_count;
+            m2s[j] += delta * (x[j] - means[j]);
+        }
+    }
+
+    float count = 0.f, mean = 0.f, m2 = 0.f;
+    for (uint32_t j = 0; j < lanes && steps > 0; j++) {
+        merge_moments(count, mean, m2, float(steps), means[j], m2s[j]);
+    }
+    for (uint32_t l = steps * lanes; l < length; l++) {
+        count += 1.f;
+        const float delta = input[l] - mean;
+        mean += delta / count;
+        m2 += delta * (input[l] - mean);
+    }
+
+    const float rstd = 1.f / std::sqrt(m2 / float(length) + eps);
+    if (gamma && beta) {
+#pragma omp simd
+        for (uint32_t l = 0; l < length; l++) {
+            output[l] = (input[l] - mean) * rstd * gamma[l] + beta[l];
+        }
+    } else if (gamma) {
+#pragma omp simd
+        for (uint32_t l = 0; l < length; l++) {
+            output[l] = (input[l] - mean) * rstd * gamma[l];
+        }
+    } else {
+#pragma omp simd
+        for (uint32_t l = 0; l < length; l++) {
+            output[l] = (input[l] - mean) * rstd;
+        }
+    }
+}
+
+/// width个交错存放的行，第l个元素位于l * stride，每一行各自做Welford累加
+static void
+layer_norm_tile(const float *input, float *output, uint32_t length, uint32_t stride, uint32_t width,
+                float eps, const float *gamma, const float *beta)
+{
+    float means[LayerNormLayer::kTileWidth];
+    float rstds[LayerNormLayer::kTileWidth];
+    std::fill(means, means + width, 0.f);
+    std::fill(rstds, rstds + width, 0.f);
+
+    for (uint32_t l = 0; l < length; l++) {
+        const float *x = input + size_t(l) * stride;
+        const float inv_count = 1.f / float(l + 1);
+#pragma omp simd
+        for (uint32_t j = 0; j < width; j++) {
+            const float delta = x[j] - means[j];
+            means[j] += delta * inv_count;
+            rstds[j] += delta * (x[j] - means[j]);
+        }
+    }
+
+    for (uint32_t j = 0; j < width; j++) {
+        rstds[j] = 1.f / std::sqrt(rstds[j] / float(length) + eps);
+    }
+
+    for (uint32_t l = 0; l < length; l++) {
+        const float *x = input + size_t(l) * stride;
+        float *y = output + size_t(l) * stride;
+        const float scale = gamma ? gamma[l] : 1.f;
+        const float shift = beta ? beta[l] : 0.f;
+#pragma omp simd
+        for (uint32_t j = 0; j < width; j++) {
+            y[j] = (x[j] - means[j]) * rstds[j] * scale + shift;
+        }
+    }
+}
+
+LayerNormLayer::LayerNormLayer(std::vector<uint32_t> normalized_shape, float eps, bool elementwise_affine)
+    : ParamLayer("LayerNorm"), normalized_shape_(std::move(normalized_shape)), normalized_dims_(0),
+      normalized_size_(1), eps_(eps), elementwise_affine_(elementwise_affine)
+{
+    CHECK(!normalized_shape_.empty() && normalized_shape_.size() <= 3)
+        << "the normalized shape of layer norm should have 1 to 3 dims";
+    for (uint32_t dim : normalized_shape_) {
+        CHECK(dim > 0) << "the normalized shape of layer norm is empty";
+        normalized_size_ *= dim;
+    }
+    /// 前面补1，便于与张量的(channels, rows, cols)对应
+    normalized_dims_ = normalized_shape_.size();
+    normalized_shape_.insert(normalized_shape_.begin(), 3 - normalized_shape_.size(), 1);
+}
+
+size_t LayerNormLayer::physical_index(size_t index) const
+{
+    const size_t rows = normalized_shape_.at(1);
+    const size_t cols = normalized_shape_.at(2);
+    const size_t c = index / (rows * cols);
+    const size_t r = index / cols % rows;
+    const size_t w = index % cols;
+    return (c * cols + w) * rows + r;
+}
+
+std::vector<float> LayerNormLayer::to_physical(const std::vector<float> &values) const
+{
+    std::vector<float> physical(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        physical.at(this->physical_index(i)) = values.at(i);
+    }
+    return physical;
+}
+
+void LayerNormLayer::set_weights(const std::vector<float> &weights)
+{
+    CHECK_EQ(weights.size(), normalized_size_) << "the weight size of layer norm is wrong";
+    ParamLayer::set_weights(this->to_physical(weights));
+}
+
+void LayerNormLayer::set_bias(const std::vector<float> &bias)
+{
+    CHECK(bias.empty() || bias.size() == normalized_size_) << "the bias size of layer norm is wrong";
+    ParamLayer::set_bias(this->to_physical(bias));
+}
+
+InferStatus LayerNormLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                    std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the layer norm layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the layer norm layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    if (elementwise_affine_ && this->weights_.size() != normalized_size_) {
+        LOG(ERROR) << "The weights of the layer norm layer are wrong";
+        return InferStatus::kInferFailedWeightParameterError;
+    }
+
+    if (!this->bias_.empty() && this->bias_.size() != normalized_size_) {
+        LOG(ERROR) << "The bias of the layer norm layer is wrong";
+        return InferStatus::kInferFailedBiasParameterError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty() || output == nullptr || output->empty()) {
+            LOG(ERROR) << "The input or output tensor in the layer norm layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        if (input->raw_shapes() != inputs.front()->raw_shapes() || output->raw_shapes() != input->raw_shapes()) {
+            LOG(ERROR) << "The input and output tensor shapes of the layer norm layer do not match";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+
+        const uint32_t dims[3] = {input->channels(), input->rows(), input->cols()};
+        for (uint32_t d = 3 - normalized_dims_; d < 3; d++) {
+            if (dims[d] != normalized_shape_.at(d)) {
+                LOG(ERROR) << "The input shape of the layer norm layer does not match the normalized shape";
+                return InferStatus::kInferFailedShapeParameterError;
+            }
+        }
+    }
+
+    /// 只归一化cols时沿该维度的间隔为rows，归一化多个维度时它们在内存中是连续的一块
+    const uint32_t channels = inputs.front()->channels();
+    const uint32_t rows = inputs.front()->rows();
+    const uint32_t cols = inputs.front()->cols();
+    AxisSplit split = split_axis(channels, rows, cols, 2);
+    if (normalized_dims_ > 1) {
+        split.outer = normalized_dims_ == 2 ? channels : 1;
+        split.length = normalized_size_;
+        split.inner = 1;
+    }
+
+    const size_t block_size = size_t(split.length) * split.inner;
+    const uint32_t tiles = (split.inner + kTileWidth - 1) / kTileWidth;
+    const uint32_t jobs = split.outer * tiles;
+    const float *gamma = elementwise_affine_ ? this->weights_.data() : nullptr;
+    const float *beta = this->bias_.empty() ? nullptr : this->bias_.data();
+
+#pragma omp parallel for schedule(static) if (size_t(batch_size) * split.outer * block_size > 4096)
+    for (uint32_t index = 0; index < batch_size * jobs; index++) {
+        const uint32_t b = index / jobs;
+        const uint32_t o = index % jobs / tiles;
+        const uint32_t t = index % tiles;
+        const size_t offset = size_t(o) * block_size + size_t(t) * kTileWidth;
+        const float *input = inputs.at(b)->raw_ptr() + offset;
+        float *output = outputs.at(b)->raw_ptr() + offset;
+        if (split.inner == 1) {
+            layer_norm_row(input, output, split.length, eps_, gamma, beta);
+        } else {
+            const uint32_t width = std::min(kTileWidth, split.inner - t * kTileWidth);
+            layer_norm_tile(input, output, split.length, split.inner, width, eps_, gamma, beta);
+        }
+    }
+
+    return InferStatus::kInferSuccess;
+}
+
+ParseParameterAttrStatus LayerNormLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                         std::shared_ptr<Layer> &layer_norm_layer)
+{
+    CHECK(op != nullptr) << "layer norm operator is empty";
+
+    std::vector<int> normalized_shape;
+    if (!get_int_list(op, "normalized_shape", normalized_shape) || normalized_shape.size() > 3
+        || int(normalized_shape.size()) >= input_rank_of(op)) {
+        LOG(ERROR) << "Can not find the normalized shape parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingShape;
+    }
+
+    auto eps = op->get_param<RuntimeParameterFloat>("eps");
+    if (!eps) {
+        LOG(ERROR) << "Can not find the eps parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingEps;
+    }
+
+    auto elementwise_affine = op->get_param<RuntimeParameterBool>("elementwise_affine");
+    const bool affine = !elementwise_affine || elementwise_affine->value;
+
+    std::vector<uint32_t> shape;
+    for (int dim : normalized_shape) {
+        if (dim <= 0) {
+            LOG(ERROR) << "The normalized shape of " << op->name << " is wrong";
+            return ParseParameterAttrStatus::kParameterMissingShape;
+        }
+        shape.push_back(uint32_t(dim));
+    }
+    auto layer_norm = std::make_shared<LayerNormLayer>(shape, eps->value, affine);
+
+    if (affine) {
+        auto weight = op->attrs.find("weight");
+        if (weight == op->attrs.end() || weight->second->weight_data.empty()) {
+            LOG(ERROR) << "Can not find the weight attribute of " << op->name;
+            return ParseParameterAttrStatus::kAttrMissingWeight;
+        }
+        layer_norm->set_weights(weight->second->get<float>());
+
+        /// nn.LayerNorm(bias=False)时没有偏置
+        auto bias = op->attrs.find("bias");
+        if (bias != op->attrs.end() && !bias->second->weight_data.empty()) {
+            layer_norm->set_bias(bias->second->get<float>());
+        }
+    }
+
+    layer_norm_layer = layer_norm;
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper layer_norm_create_instance("nn.LayerNorm", LayerNormLayer::create_instance);
+
+}// namespace jinfer
@@ -0,0 +1,121 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/layout_transform.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+LayoutTransformLayer::LayoutTransformLayer(bool to_blocked)
+    : Layer(to_blocked ? "ToBlocked" : "ToPlanar"), to_blocked_(to_blocked)
+{
+}
+
+InferStatus LayoutTransformLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                          std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the layout transform layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the layout transform layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty() || output == nullptr || output->empty()) {
+            LOG(ERROR) << "The input or output tensor in the layout transform layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        const Tensor<float> &planar = this->to_blocked_ ? *input : *output;
+        const Tensor<float> &blocked = this->to_blocked_ ? *output : *input;
+        if (blocked.channels() != channel_blocks(planar.channels())
+            || blocked.rows() != planar.rows() * kChannelBlock || blocked.cols() != planar.cols()) {
+            LOG(ERROR) << "The output tensor shape of the layout transform layer is wrong";
+            return InferStatus::kInferFailedOutputSizeError;
+        }
+
+        if (this->to_blocked_) {
+            to_blocked(*input, *output);
+        } else {
+            to_planar(*input, *output);
+        }
+    }
+    return InferStatus::kInferSuccess;
+}
+
+void LayoutTransformLayer::to_blocked(const Tensor<float> &input, Tensor<float> &output)
+{
+    const uint32_t channels = input.channels();
+    const uint32_t plane_size = input.rows() * input.cols();
+    const uint32_t blocks = channel_blocks(channels);
+    const float *src = input.raw_ptr();
+    float *dst = output.raw_ptr();
+
+#pragma omp parallel for if (size_t(channels) * plane_size > 65536)
+    for (uint32_t block = 0; block < blocks; block++) {
+        float *dst_block = dst + size_t(block) * plane_size * kChannelBlock;
+        for (uint32_t c = 0; c < kChannelBlock; c++) {
+            const uint32_t channel = block * kChannelBlock + c;
+            if (channel >= channels) {
+                for (uint32_t p = 0; p < plane_size; p++) {
+                    dst_block[size_t(p) * kChannelBlock + c] = 0.f;
+                }
+                continue;
+            }
+
+            const float *src_channel = src + size_t(channel) * plane_size;
+            for (uint32_t p = 0; p < plane_size; p++) {
+                dst_block[size_t(p) * kChannelBlock + c] = src_channel[p];
+            }
+        }
+    }
+}
+
+void LayoutTransformLayer::to_planar(const Tensor<float> &input, Tensor<float> &output)
+{
+    const uint32_t channels = output.channels();
+    const uint32_t plane_size = output.rows() * output.cols();
+    const float *src = input.raw_ptr();
+    float *dst = output.raw_ptr();
+
+#pragma omp parallel for if (size_t(channels) * plane_size > 65536)
+    for (uint32_t channel = 0; channel < channels; channel++) {
+        const float *src_block = src + size_t(channel / kChannelBlock) * plane_size * kChannelBlock
+                                 + channel % kChannelBlock;
+        float *dst_channel = dst + size_t(channel) * plane_size;
+        for (uint32_t p = 0; p < plane_size; p++) {
+            dst_channel[p] = src_block[size_t(p) * kChannelBlock];
+        }
+    }
+}
+
+ParseParameterAttrStatus LayoutTransformLayer::create_blocked_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                                       std::shared_ptr<Layer> &layout_layer)
+{
+    CHECK(op != nullptr) << "layout transform operator is empty";
+    layout_layer = std::make_shared<LayoutTransformLayer>(true);
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+ParseParameterAttrStatus LayoutTransformLayer::create_planar_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                                      std::shared_ptr<Layer> &layout_layer)
+{
+    CHECK(op != nullptr) << "layout transform operator is empty";
+    layout_layer = std::make_shared<LayoutTransformLayer>(false);
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper to_blocked_create_instance("jinfer.ToBlocked", LayoutTransformLayer::create_blocked_instance);
+LayerRegistererWrapper to_planar_create_instance("jinfer.ToPlanar", LayoutTransformLayer::create_planar_instance);
+
+}// namespace jinfer
@@ -0,0 +1,239 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/linear.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include <algorithm>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+LinearLayer::LinearLayer(uint32_t in_features, uint32_t out_features, bool use_bias)
+    : ParamLayer("Linear"), in_features_(in_features), out_features_(out_features), use_bias_(use_bias)
+{
+    CHECK(in_features_ > 0 && out_features_ > 0) << "the features of linear layer are empty";
+}
+
+void LinearLayer::set_weights(const std::vector<float> &weights)
+{
+    CHECK_EQ(weights.size(), size_t(in_features_) * out_features_) << "the weight size of linear is wrong";
+
+    /// packed[panel][k][j] = W[panel * kPanelWidth + j][k]，最后一个面板不足的部分补0
+    const uint32_t panels = (out_features_ + kPanelWidth - 1) / kPanelWidth;
+    this->packed_weights_.assign(size_t(panels) * in_features_ * kPanelWidth, 0.f);
+    for (uint32_t p = 0; p < panels; p++) {
+        float *panel = this->packed_weights_.data() + size_t(p) * in_features_ * kPanelWidth;
+        const uint32_t width = std::min(kPanelWidth, out_features_ - p * kPanelWidth);
+        for (uint32_t j = 0; j < width; j++) {
+            const float *weight_row = weights.data() + size_t(p * kPanelWidth + j) * in_features_;
+            for (uint32_t k = 0; k < in_features_; k++) {
+                panel[k * kPanelWidth + j] = weight_row[k];
+            }
+        }
+    }
+}
+
+void LinearLayer::set_bias(const std::vector<float> &bias)
+{
+    CHECK(bias.empty() || bias.size() == out_features_) << "the bias size of linear is wrong";
+    ParamLayer::set_bias(bias);
+}
+
+void LinearLayer::set_activation(ActivationType activation)
+{
+    this->activation_ = activation;
+}
+
+ActivationType LinearLayer::activation() const
+{
+    return this->activation_;
+}
+
+InferStatus LinearLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                 std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the linear layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the linear layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    if (this->packed_weights_.empty()) {
+        LOG(ERROR) << "The weights of the linear layer are empty";
+        return InferStatus::kInferFailedWeightParameterError;
+    }
+
+    if (use_bias_ && this->bias_.size() != out_features_) {
+        LOG(ERROR) << "The bias of the linear layer is wrong";
+        return InferStatus::kInferFailedBiasParameterError;
+    }
+
+    /// 行列表属于调用线程，容量只增不减
+    thread_local std::vector<Row> rows;
+    rows.clear();
+    for (uint32_t i = 0; i < inputs.size(); i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty()) {
+            LOG(ERROR) << "The input tensor in the linear layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        if (input->cols() != in_features_) {
+            LOG(ERROR) << "The input features of the linear layer do not match";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+
+        if (output == nullptr || output->empty()) {
+            LOG(ERROR) << "The output tensor in the linear layer is empty";
+            return InferStatus::kInferFailedOutputEmpty;
+        }
+
+        if (output->cols() != out_features_ || output->rows() != input->rows()
+            || output->channels() != input->channels()) {
+            LOG(ERROR) << "The output tensor shape of the linear layer is wrong";
+            return InferStatus::kInferFailedOutputSizeError;
+        }
+
+        /// 每个通道是列主序的rows x features矩阵，其中的一行即一次线性变换的输入
+        const uint32_t input_rows = input->rows();
+        for (uint32_t c = 0; c < input->channels(); c++) {
+            const float *input_channel = input->raw_ptr() + size_t(c) * input_rows * in_features_;
+            float *output_channel = output->raw_ptr() + size_t(c) * input_rows * out_features_;
+            for (uint32_t r = 0; r < input_rows; r++) {
+                rows.push_back({input_channel + r, output_channel + r, input_rows, input_rows});
+            }
+        }
+    }
+
+    if (rows.size() == 1) {
+        this->gemv(rows.front());
+    } else {
+        this->gemm(rows);
+    }
+    return InferStatus::kInferSuccess;
+}
+
+void LinearLayer::gemv(const Row &row) const
+{
+    const uint32_t panels = (out_features_ + kPanelWidth - 1) / kPanelWidth;
+
+#pragma omp parallel for schedule(static) if (size_t(out_features_) * in_features_ > 65536)
+    for (uint32_t p = 0; p < panels; p++) {
+        const float *panel = this->packed_weights_.data() + size_t(p) * in_features_ * kPanelWidth;
+        float acc[kPanelWidth] = {0.f};
+        for (uint32_t k = 0; k < in_features_; k++) {
+            const float x = row.input[size_t(k) * row.input_stride];
+            const float *w = panel + size_t(k) * kPanelWidth;
+#pragma omp simd
+            for (uint32_t j = 0; j < kPanelWidth; j++) {
+                acc[j] += x * w[j];
+            }
+        }
+        this->store(acc, p, row);
+    }
+}
+
+void LinearLayer::gemm(const std::vector<Row> &rows) const
+{
+    const uint32_t panels = (out_features_ + kPanelWidth - 1) / kPanelWidth;
+    const uint32_t row_num = rows.size();
+
+    /// 每个面板在k方向上连续读取，kTileRows行输入共享同一次面板读取
+#pragma omp parallel for schedule(static)
+    for (uint32_t p = 0; p < panels; p++) {
+        const float *panel = this->packed_weights_.data() + size_t(p) * in_features_ * kPanelWidth;
+        for (uint32_t m = 0; m < row_num; m += kTileRows) {
+            const uint32_t tile_rows = std::min(kTileRows, row_num - m);
+            float acc[kTileRows][kPanelWidth] = {{0.f}};
+            for (uint32_t k = 0; k < in_features_; k++) {
+                const float *w = panel + size_t(k) * kPanelWidth;
+                for (uint32_t i = 0; i < tile_rows; i++) {
+                    const float x = rows[m + i].input[size_t(k) * rows[m + i].input_stride];
+#pragma omp simd
+                    for (uint32_t j = 0; j < kPanelWidth; j++) {
+                        acc[i][j] += x * w[j];
+                    }
+                }
+            }
+
+            for (uint32_t i = 0; i < tile_rows; i++) {
+                this->store(acc[i], p, rows[m + i]);
+            }
+        }
+    }
+}
+
+void LinearLayer::store(const float *acc, uint32_t panel, const Row &row) const
+{
+    const uint32_t begin = panel * kPanelWidth;
+    const uint32_t width = std::min(kPanelWidth, out_features_ - begin);
+    for (uint32_t j = 0; j < width; j++) {
+        float value = acc[j];
+        if (use_bias_) {
+            value += this->bias_[begin + j];
+        }
+        row.output[size_t(begin + j) * row.output_stride] = apply_activation(this->activation_, value);
+    }
+}
+
+ParseParameterAttrStatus LinearLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                      std::shared_ptr<Layer> &linear_layer)
+{
+    CHECK(op != nullptr) << "linear operator is empty";
+
+    auto in_features = op->get_param<RuntimeParameterInt>("in_features");
+    if (!in_features) {
+        LOG(ERROR) << "Can not find the in features parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingInChannel;
+    }
+
+    auto out_features = op->get_param<RuntimeParameterInt>("out_features");
+    if (!out_features) {
+        LOG(ERROR) << "Can not find the out features parameter of " << op->name;
+        return ParseParameterAttrStatus::kAttrMissingOutFeatures;
+    }
+
+    auto use_bias = op->get_param<RuntimeParameterBool>("bias");
+    if (!use_bias) {
+        LOG(ERROR) << "Can not find the bias parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingUseBias;
+    }
+
+    auto linear = std::make_shared<LinearLayer>(in_features->value, out_features->value, use_bias->value);
+
+    auto weight = op->attrs.find("weight");
+    if (weight == op->attrs.end() || weight->second->weight_data.empty()) {
+        LOG(ERROR) << "Can not find the weight attribute of " << op->name;
+        return ParseParameterAttrStatus::kAttrMissingWeight;
+    }
+    linear->set_weights(weight->second->get<float>());
+
+    if (use_bias->value) {
+        auto bias = op->attrs.find("bias");
+        if (bias == op->attrs.end() || bias->second->weight_data.empty()) {
+            LOG(ERROR) << "Can not find the bias attribute of " << op->name;
+            return ParseParameterAttrStatus::kAttrMissingBias;
+        }
+        linear->set_bias(bias->second->get<float>());
+    }
+
+    /// 构建计算图时融合进来的激活函数
+    auto activation = op->get_param<RuntimeParameterString>("activation");
+    if (activation) {
+        linear->set_activation(activation_type_of(activation->value));
+    }
+
+    linear_layer = linear;
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper linear_create_instance("nn.Linear", LinearLayer::create_instance);
+
+}// namespace jinfer
@@ -0,0 +1,262 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/pooling.hpp"
+#include "data/workspace.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include "layer/details/layout_transform.hpp"
+#include "runtime/shape_infer.hpp"
+#include <algorithm>
+#include <glog/logging.h>
+#include <limits>
+
+namespace jinfer
+{
+
+struct PoolingColumnWorkspace;
+
+PoolingLayer::PoolingLayer(PoolingType pooling_type,
+                           uint32_t kernel_h, uint32_t kernel_w,
+                           uint32_t stride_h, uint32_t stride_w,
+                           uint32_t padding_h, uint32_t padding_w,
+                           uint32_t dilation_h, uint32_t dilation_w,
+                           bool ceil_mode, bool count_include_pad)
+    : Layer(pooling_type == PoolingType::kMaxPooling ? "MaxPooling" : "AvgPooling"),
+      pooling_type_(pooling_type),
+      kernel_h_(kernel_h), kernel_w_(kernel_w),
+      stride_h_(stride_h), stride_w_(stride_w),
+      padding_h_(padding_h), padding_w_(padding_w),
+      dilation_h_(dilation_h), dilation_w_(dilation_w),
+      ceil_mode_(ceil_mode), count_include_pad_(count_include_pad)
+{
+}
+
+void PoolingLayer::set_blocked_layout(bool blocked)
+{
+    this->lanes_ = blocked ? kChannelBlock : 1;
+}
+
+InferStatus PoolingLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                  std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the pooling layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the pooling layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    if (kernel_h_ == 0 || kernel_w_ == 0 || stride_h_ == 0 || stride_w_ == 0
+        || dilation_h_ == 0 || dilation_w_ == 0) {
+        LOG(ERROR) << "The kernel, stride or dilation parameter of the pooling layer is zero";
+        return InferStatus::kInferFailedStrideParameterError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty()) {
+            LOG(ERROR) << "The input tensor in the pooling layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        if (output == nullptr || output->empty()) {
+            LOG(ERROR) << "The output tensor in the pooling layer is empty";
+            return InferStatus::kInferFailedOutputEmpty;
+        }
+
+        if (input->rows() % lanes_ != 0 || output->rows() % lanes_ != 0) {
+            LOG(ERROR) << "The input or output tensor of the pooling layer is not in NCHW8c layout";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+
+        const int output_rows = window_output_size(int(input->rows() / lanes_), int(kernel_h_), int(stride_h_),
+                                                   int(padding_h_), int(dilation_h_), ceil_mode_);
+        const int output_cols = window_output_size(int(input->cols()), int(kernel_w_), int(stride_w_),
+                                                   int(padding_w_), int(dilation_w_), ceil_mode_);
+        if (output_rows <= 0 || output_cols <= 0 || output->rows() / lanes_ != uint32_t(output_rows)
+            || output->cols() != uint32_t(output_cols) || output->channels() != input->channels()) {
+            LOG(ERROR) << "The output tensor shape of the pooling layer is wrong";
+            return InferStatus::kInferFailedOutputSizeError;
+        }
+    }
+
+    const uint32_t channels = inputs.front()->channels();
+    const uint32_t rows = inputs.front()->rows() / lanes_;
+    const uint32_t cols = inputs.front()->cols();
+    const uint32_t output_rows = outputs.front()->rows() / lanes_;
+    const uint32_t output_cols = outputs.front()->cols();
+
+    /// 批次和通道展开成一维后并行，每个线程各自持有一列临时缓冲区
+#pragma omp parallel
+    {
+        float *column = thread_workspace<PoolingColumnWorkspace>(size_t(rows) * lanes_);
+#pragma omp for schedule(static)
+        for (uint32_t index = 0; index < batch_size * channels; index++) {
+            const uint32_t b = index / channels;
+            const uint32_t c = index % channels;
+            const float *input = inputs.at(b)->raw_ptr() + size_t(c) * rows * cols * lanes_;
+            float *output = outputs.at(b)->raw_ptr() + size_t(c) * output_rows * output_cols * lanes_;
+            this->pooling_channel(input, rows, cols, output, output_rows, output_cols, column);
+        }
+    }
+
+    return InferStatus::kInferSuccess;
+}
+
+void PoolingLayer::pooling_channel(const float *input, uint32_t rows, uint32_t cols,
+                                   float *output, uint32_t output_rows, uint32_t output_cols,
+                                   float *column) const
+{
+    const bool max_pooling = this->pooling_type_ == PoolingType::kMaxPooling;
+    const float init_value = max_pooling ? std::numeric_limits<float>::lowest() : 0.f;
+    const uint32_t lanes = this->lanes_;
+    const uint32_t column_size = rows * lanes;
+
+    for (uint32_t ow = 0; ow < output_cols; ow++) {
+        const int w_start = int(ow * stride_w_) - int(padding_w_);
+
+        /// 窗口覆盖的输入列是连续内存，逐元素归约可以向量化
+        std::fill(column, column + column_size, init_value);
+        for (uint32_t kw = 0; kw < kernel_w_; kw++) {
+            const int iw = w_start + int(kw * dilation_w_);
+            if (iw < 0 || iw >= int(cols)) {
+                continue;
+            }
+
+            const float *input_col = input + size_t(iw) * column_size;
+            if (max_pooling) {
+#pragma omp simd
+                for (uint32_t r = 0; r < column_size; r++) {
+                    column[r] = std::max(column[r], input_col[r]);
+                }
+            } else {
+#pragma omp simd
+                for (uint32_t r = 0; r < column_size; r++) {
+                    column[r] += input_col[r];
+                }
+            }
+        }
+
+        float *output_col = output + size_t(ow) * output_rows * lanes;
+        if (max_pooling) {
+            for (uint32_t oh = 0; oh < output_rows; oh++) {
+                const int h_start = int(oh * stride_h_) - int(padding_h_);
+                float *value = output_col + size_t(oh) * lanes;
+                std::fill(value, value + lanes, init_value);
+                for (uint32_t kh = 0; kh < kernel_h_; kh++) {
+                    const int ih = h_start + int(kh * dilation_h_);
+                    if (ih < 0 || ih >= int(rows)) {
+                        continue;
+                    }
+                    const float *column_row = column + size_t(ih) * lanes;
+                    for (uint32_t c = 0; c < lanes; c++) {
+                        value[c] = std::max(value[c], column_row[c]);
+                    }
+                }
+            }
+            continue;
+        }
+
+        /// 与pytorch一致：count_include_pad时除数包含窗口中的填充部分，但不超过填充后的边界
+        const int w_end = std::min(w_start + int(kernel_w_), int(cols + padding_w_));
+        const int pool_w = w_end - w_start;
+        const int valid_w = std::min(w_end, int(cols)) - std::max(w_start, 0);
+        for (uint32_t oh = 0; oh < output_rows; oh++) {
+            const int h_start = int(oh * stride_h_) - int(padding_h_);
+            const int h_end = std::min(h_start + int(kernel_h_), int(rows + padding_h_));
+            const int valid_h_start = std::max(h_start, 0);
+            const int valid_h_end = std::min(h_end, int(rows));
+
+            const int pool_size = count_include_pad_ ? (h_end - h_start) * pool_w
+                                                     : (valid_h_end - valid_h_start) * valid_w;
+            float *value = output_col + size_t(oh) * lanes;
+            for (uint32_t c = 0; c < lanes; c++) {
+                float sum = 0.f;
+                for (int ih = valid_h_start; ih < valid_h_end; ih++) {
+                    sum += column[size_t(ih) * lanes + c];
+                }
+                value[c] = pool_size > 0 ? sum / float(pool_size) : 0.f;
+            }
+        }
+    }
+}
+
+static ParseParameterAttrStatus
+parse_pooling_params(const std::shared_ptr<RuntimeOperator> &op, PoolingType pooling_type,
+                     std::shared_ptr<Layer> &pooling_layer)
+{
+    CHECK(op != nullptr) << "pooling operator is empty";
+
+    auto kernel_size = op->get_param<RuntimeParameterIntArray>("kernel_size");
+    if (!kernel_size || kernel_size->value.size() != 2) {
+        LOG(ERROR) << "Can not find the kernel size parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingKernel;
+    }
+
+    auto padding = op->get_param<RuntimeParameterIntArray>("padding");
+    if (!padding || padding->value.size() != 2) {
+        LOG(ERROR) << "Can not find the padding parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingPadding;
+    }
+
+    /// pytorch中stride缺省时与kernel_size相同，导出后为空数组
+    std::vector<int> strides = kernel_size->value;
+    auto stride = op->get_param<RuntimeParameterIntArray>("stride");
+    if (stride && stride->value.size() == 2) {
+        strides = stride->value;
+    } else if (stride && !stride->value.empty()) {
+        LOG(ERROR) << "Can not find the stride parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingStride;
+    }
+
+    std::vector<int> dilations = {1, 1};
+    auto dilation = op->get_param<RuntimeParameterIntArray>("dilation");
+    if (dilation) {
+        if (dilation->value.size() != 2) {
+            LOG(ERROR) << "Can not find the dilation parameter of " << op->name;
+            return ParseParameterAttrStatus::kParameterMissingDilation;
+        }
+        dilations = dilation->value;
+    }
+
+    auto ceil_mode = op->get_param<RuntimeParameterBool>("ceil_mode");
+    auto count_include_pad = op->get_param<RuntimeParameterBool>("count_include_pad");
+
+    pooling_layer = std::make_shared<PoolingLayer>(
+        pooling_type,
+        kernel_size->value.at(0), kernel_size->value.at(1),
+        strides.at(0), strides.at(1),
+        padding->value.at(0), padding->value.at(1),
+        dilations.at(0), dilations.at(1),
+        ceil_mode && ceil_mode->value,
+        !count_include_pad || count_include_pad->value);
+
+    auto layout = op->get_param<RuntimeParameterString>("layout");
+    if (layout && layout->value == kBlockedLayoutName) {
+        std::dynamic_pointer_cast<PoolingLayer>(pooling_layer)->set_blocked_layout(true);
+    }
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+ParseParameterAttrStatus PoolingLayer::create_max_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                           std::shared_ptr<Layer> &pooling_layer)
+{
+    return parse_pooling_params(op, PoolingType::kMaxPooling, pooling_layer);
+}
+
+ParseParameterAttrStatus PoolingLayer::create_avg_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                           std::shared_ptr<Layer> &pooling_layer)
+{
+    return parse_pooling_params(op, PoolingType::kAvgPooling, pooling_layer);
+}
+
+LayerRegistererWrapper maxpooling_create_instance("nn.MaxPool2d", PoolingLayer::create_max_instance);
+LayerRegistererWrapper avgpooling_create_instance("nn.AvgPool2d", PoolingLayer::create_avg_instance);
+
+}// namespace jinfer
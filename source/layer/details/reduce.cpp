@@ -0,0 +1,286 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/reduce.hpp"
+#include "data/workspace.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include "layer/abstract/reduction.hpp"
+#include <algorithm>
+#include <glog/logging.h>
+#include <limits>
+
+namespace jinfer
+{
+
+struct ReduceAccWorkspace;
+
+static float
+initial_value(ReduceType type)
+{
+    switch (type) {
+    case ReduceType::kReduceMax: return std::numeric_limits<float>::lowest();
+    case ReduceType::kReduceMin: return std::numeric_limits<float>::max();
+    default: return 0.f;
+    }
+}
+
+ReduceLayer::ReduceLayer(ReduceType type, const std::vector<int> &dims, int rank, bool keepdim)
+    : Layer("Reduce"), reduce_type_(type)
+{
+    CHECK(!dims.empty()) << "the dims of reduce layer are empty";
+    for (int dim : dims) {
+        const int axis = tensor_axis_of(dim, rank);
+        CHECK(axis >= 0) << "the dim " << dim << " of reduce layer is not supported for rank " << rank;
+        reduced_.at(axis) = true;
+    }
+
+    /// 输入的第一个逻辑维度对应张量的第4 - rank个维度，之前的维度是补齐的1
+    std::vector<int> kept_axes;
+    for (int axis = 4 - rank; axis < 3; axis++) {
+        if (!reduced_.at(axis)) {
+            kept_axes.push_back(axis);
+        }
+    }
+    CHECK(keepdim || !kept_axes.empty()) << "the reduce layer can not reduce all dims except batch without keepdim";
+
+    /// 不保留维度时输出的逻辑维数变少，张量前面补齐的1随之增多
+    output_axes_.fill(-1);
+    for (size_t i = 0; i < kept_axes.size(); i++) {
+        const int axis = kept_axes.at(i);
+        output_axes_.at(axis) = keepdim ? axis : int(3 - kept_axes.size() + i);
+    }
+}
+
+void ReduceLayer::reduce_column(const float *input, uint32_t rows, float *acc) const
+{
+    if (!reduced_.at(1)) {
+        switch (reduce_type_) {
+        case ReduceType::kReduceMax:
+#pragma omp simd
+            for (uint32_t r = 0; r < rows; r++) {
+                acc[r] = std::max(acc[r], input[r]);
+            }
+            break;
+        case ReduceType::kReduceMin:
+#pragma omp simd
+            for (uint32_t r = 0; r < rows; r++) {
+                acc[r] = std::min(acc[r], input[r]);
+            }
+            break;
+        default:
+#pragma omp simd
+            for (uint32_t r = 0; r < rows; r++) {
+                acc[r] += input[r];
+            }
+            break;
+        }
+        return;
+    }
+
+    float value = *acc;
+    switch (reduce_type_) {
+    case ReduceType::kReduceMax:
+#pragma omp simd reduction(max : value)
+        for (uint32_t r = 0; r < rows; r++) {
+            value = std::max(value, input[r]);
+        }
+        break;
+    case ReduceType::kReduceMin:
+#pragma omp simd reduction(min : value)
+        for (uint32_t r = 0; r < rows; r++) {
+            value = std::min(value, input[r]);
+        }
+        break;
+    default:
+#pragma omp simd reduction(+ : value)
+        for (uint32_t r = 0; r < rows; r++) {
+            value += input[r];
+        }
+        break;
+    }
+    *acc = value;
+}
+
+InferStatus ReduceLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                 std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the reduce layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the reduce layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty() || output == nullptr || output->empty()) {
+            LOG(ERROR) << "The input or output tensor in the reduce layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        if (input->raw_shapes() != inputs.front()->raw_shapes()) {
+            LOG(ERROR) << "The input tensor shapes of the reduce layer in a batch do not match";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+
+        const uint32_t input_dims[3] = {input->channels(), input->rows(), input->cols()};
+        uint32_t expected_dims[3] = {1, 1, 1};
+        for (int axis = 0; axis < 3; axis++) {
+            if (output_axes_.at(axis) >= 0) {
+                expected_dims[output_axes_.at(axis)] = input_dims[axis];
+            } else if (!reduced_.at(axis) && input_dims[axis] != 1) {
+                LOG(ERROR) << "The input tensor of the reduce layer has more dims than expected";
+                return InferStatus::kInferFailedInputOutSizeMatchError;
+            }
+        }
+        if (output->channels() != expected_dims[0] || output->rows() != expected_dims[1]
+            || output->cols() != expected_dims[2]) {
+            LOG(ERROR) << "The output tensor shape of the reduce layer is wrong";
+            return InferStatus::kInferFailedOutputSizeError;
+        }
+    }
+
+    const uint32_t channels = inputs.front()->channels();
+    const uint32_t rows = inputs.front()->rows();
+    const uint32_t cols = inputs.front()->cols();
+    const uint32_t acc_channels = reduced_.at(0) ? 1 : channels;
+    const uint32_t acc_rows = reduced_.at(1) ? 1 : rows;
+    const uint32_t acc_cols = reduced_.at(2) ? 1 : cols;
+    const uint32_t count = (channels / acc_channels) * (rows / acc_rows) * (cols / acc_cols);
+    const float scale = reduce_type_ == ReduceType::kReduceMean ? 1.f / float(count) : 1.f;
+
+    /// 结果先按保留维度的张量内存顺序累加，归约的维度大小为1
+    const size_t acc_size = size_t(acc_channels) * acc_cols * acc_rows;
+    float *acc = thread_workspace<ReduceAccWorkspace>(acc_size);
+    for (uint32_t b = 0; b < batch_size; b++) {
+        const float *input = inputs.at(b)->raw_ptr();
+        std::fill(acc, acc + acc_size, initial_value(reduce_type_));
+
+        auto reduce_channel_column = [&](uint32_t c, uint32_t w) {
+            const float *input_col = input + (size_t(c) * cols + w) * rows;
+            const uint32_t acc_c = reduced_.at(0) ? 0 : c;
+            const uint32_t acc_w = reduced_.at(2) ? 0 : w;
+            float *acc_col = acc + (size_t(acc_c) * acc_cols + acc_w) * acc_rows;
+            this->reduce_column(input_col, rows, acc_col);
+        };
+
+        /// 按未被归约的外层维度并行，各个线程写入不同的结果
+        if (!reduced_.at(0)) {
+#pragma omp parallel for schedule(static) if (size_t(channels) * rows * cols > 65536)
+            for (uint32_t c = 0; c < channels; c++) {
+                for (uint32_t w = 0; w < cols; w++) {
+                    reduce_channel_column(c, w);
+                }
+            }
+        } else if (!reduced_.at(2)) {
+#pragma omp parallel for schedule(static) if (size_t(channels) * rows * cols > 65536)
+            for (uint32_t w = 0; w < cols; w++) {
+                for (uint32_t c = 0; c < channels; c++) {
+                    reduce_channel_column(c, w);
+                }
+            }
+        } else {
+            for (uint32_t c = 0; c < channels; c++) {
+                for (uint32_t w = 0; w < cols; w++) {
+                    reduce_channel_column(c, w);
+                }
+            }
+        }
+
+        /// 按输出张量的内存布局写回，张量的单个通道是列主序矩阵
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(b);
+        const size_t output_strides[3] = {size_t(output->rows()) * output->cols(), 1, output->rows()};
+        size_t strides[3] = {0, 0, 0};
+        for (int axis = 0; axis < 3; axis++) {
+            if (output_axes_.at(axis) >= 0) {
+                strides[axis] = output_strides[output_axes_.at(axis)];
+            }
+        }
+
+        float *output_ptr = output->raw_ptr();
+        const float *acc_ptr = acc;
+        for (uint32_t c = 0; c < acc_channels; c++) {
+            for (uint32_t w = 0; w < acc_cols; w++) {
+                float *output_col = output_ptr + c * strides[0] + w * strides[2];
+                for (uint32_t r = 0; r < acc_rows; r++) {
+                    output_col[r * strides[1]] = *acc_ptr++ * scale;
+                }
+            }
+        }
+    }
+
+    return InferStatus::kInferSuccess;
+}
+
+static ParseParameterAttrStatus
+create_reduce_instance(const std::shared_ptr<RuntimeOperator> &op, ReduceType reduce_type,
+                       std::shared_ptr<Layer> &reduce_layer)
+{
+    CHECK(op != nullptr) << "reduce operator is empty";
+
+    std::vector<int> dims;
+    if (!get_int_list(op, "dim", dims)) {
+        LOG(ERROR) << "Can not find the dim parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingDim;
+    }
+
+    auto keepdim = op->get_param<RuntimeParameterBool>("keepdim");
+    const bool keep = keepdim && keepdim->value;
+
+    const int rank = input_rank_of(op);
+    std::vector<bool> reduced(3, false);
+    for (int dim : dims) {
+        const int axis = tensor_axis_of(dim, rank);
+        if (axis < 0) {
+            LOG(ERROR) << "The dim " << dim << " of " << op->name << " is not supported";
+            return ParseParameterAttrStatus::kParameterMissingDim;
+        }
+        reduced.at(axis) = true;
+    }
+
+    /// 只剩批次维度时输出为一维，计算图中不支持
+    if (!keep && rank >= 2 && std::all_of(reduced.begin() + (4 - rank), reduced.end(), [](bool r) { return r; })) {
+        LOG(ERROR) << "The reduce operator " << op->name << " can not reduce all dims except batch without keepdim";
+        return ParseParameterAttrStatus::kParameterMissingDim;
+    }
+
+    reduce_layer = std::make_shared<ReduceLayer>(reduce_type, dims, rank, keep);
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+ParseParameterAttrStatus ReduceLayer::create_sum_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                          std::shared_ptr<Layer> &reduce_layer)
+{
+    return create_reduce_instance(op, ReduceType::kReduceSum, reduce_layer);
+}
+
+ParseParameterAttrStatus ReduceLayer::create_mean_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                           std::shared_ptr<Layer> &reduce_layer)
+{
+    return create_reduce_instance(op, ReduceType::kReduceMean, reduce_layer);
+}
+
+ParseParameterAttrStatus ReduceLayer::create_max_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                          std::shared_ptr<Layer> &reduce_layer)
+{
+    return create_reduce_instance(op, ReduceType::kReduceMax, reduce_layer);
+}
+
+ParseParameterAttrStatus ReduceLayer::create_min_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                          std::shared_ptr<Layer> &reduce_layer)
+{
+    return create_reduce_instance(op, ReduceType::kReduceMin, reduce_layer);
+}
+
+LayerRegistererWrapper sum_create_instance("torch.sum", ReduceLayer::create_sum_instance);
+LayerRegistererWrapper mean_create_instance("torch.mean", ReduceLayer::create_mean_instance);
+LayerRegistererWrapper amax_create_instance("torch.amax", ReduceLayer::create_max_instance);
+LayerRegistererWrapper amin_create_instance("torch.amin", ReduceLayer::create_min_instance);
+
+}// namespace jinfer
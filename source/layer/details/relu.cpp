@@ -0,0 +1,62 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/relu.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+InferStatus ReluLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                               std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the relu layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the relu layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty() || output == nullptr || output->empty()) {
+            LOG(ERROR) << "The input or output tensor in the relu layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        if (input->size() != output->size()) {
+            LOG(ERROR) << "The input and output tensor shapes of the relu layer do not match";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+
+        const uint32_t size = input->size();
+        const float *in = input->raw_ptr();
+        float *out = output->raw_ptr();
+#pragma omp parallel for if (size > 4096)
+        for (uint32_t j = 0; j < size; j++) {
+            out[j] = in[j] > 0.f ? in[j] : 0.f;
+        }
+    }
+
+    return InferStatus::kInferSuccess;
+}
+
+ParseParameterAttrStatus ReluLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                    std::shared_ptr<Layer> &relu_layer)
+{
+    CHECK(op != nullptr) << "relu operator is empty";
+    relu_layer = std::make_shared<ReluLayer>();
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper relu_create_instance("nn.ReLU", ReluLayer::create_instance);
+LayerRegistererWrapper relu_func_create_instance("F.relu", ReluLayer::create_instance);
+
+}// namespace jinfer
@@ -0,0 +1,63 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/sigmoid.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include <cmath>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+InferStatus SigmoidLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                  std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the sigmoid layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the sigmoid layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty() || output == nullptr || output->empty()) {
+            LOG(ERROR) << "The input or output tensor in the sigmoid layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        if (input->size() != output->size()) {
+            LOG(ERROR) << "The input and output tensor shapes of the sigmoid layer do not match";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+
+        const uint32_t size = input->size();
+        const float *in = input->raw_ptr();
+        float *out = output->raw_ptr();
+#pragma omp parallel for if (size > 4096)
+        for (uint32_t j = 0; j < size; j++) {
+            out[j] = 1.f / (1.f + std::exp(-in[j]));
+        }
+    }
+
+    return InferStatus::kInferSuccess;
+}
+
+ParseParameterAttrStatus SigmoidLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                       std::shared_ptr<Layer> &sigmoid_layer)
+{
+    CHECK(op != nullptr) << "sigmoid operator is empty";
+    sigmoid_layer = std::make_shared<SigmoidLayer>();
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper sigmoid_create_instance("nn.Sigmoid", SigmoidLayer::create_instance);
+LayerRegistererWrapper sigmoid_func_create_instance("F.sigmoid", SigmoidLayer::create_instance);
+
+}// namespace jinfer
@@ -0,0 +1,182 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/slice.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include "layer/abstract/reduction.hpp"
+#include <algorithm>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+bool SliceRange::resolve(int length, int &offset, int &size) const
+{
+    if (this->step <= 0) {
+        return false;
+    }
+    const int start = std::clamp(this->start < 0 ? this->start + length : this->start, 0, length);
+    const int end = std::clamp(this->end < 0 ? this->end + length : this->end, 0, length);
+    offset = start;
+    size = end > start ? (end - start + this->step - 1) / this->step : 0;
+    return size > 0;
+}
+
+bool SliceRange::parse(const std::shared_ptr<RuntimeOperator> &op, std::vector<int> &dims,
+                       std::vector<SliceRange> &ranges)
+{
+    std::vector<int> starts;
+    std::vector<int> ends;
+    std::vector<int> steps;
+    if ((!get_int_list(op, "dims", dims) && !get_int_list(op, "dim", dims))
+        || (!get_int_list(op, "starts", starts) && !get_int_list(op, "start", starts))
+        || (!get_int_list(op, "ends", ends) && !get_int_list(op, "end", ends))) {
+        return false;
+    }
+    if (!get_int_list(op, "steps", steps) && !get_int_list(op, "step", steps)) {
+        steps.assign(dims.size(), 1);
+    }
+    if (starts.size() != dims.size() || ends.size() != dims.size() || steps.size() != dims.size()) {
+        return false;
+    }
+
+    ranges.clear();
+    for (size_t i = 0; i < dims.size(); i++) {
+        ranges.push_back({starts.at(i), ends.at(i), steps.at(i)});
+    }
+    return true;
+}
+
+SliceLayer::SliceLayer(const std::array<SliceRange, 3> &ranges) : Layer("Slice"), ranges_(ranges)
+{
+}
+
+InferStatus SliceLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the slice layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the slice layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    for (uint32_t b = 0; b < inputs.size(); b++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(b);
+        if (input == nullptr || input->empty()) {
+            LOG(ERROR) << "The input tensor in the slice layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        const std::array<uint32_t, 3> input_shape = {input->channels(), input->rows(), input->cols()};
+        std::array<uint32_t, 3> offsets{};
+        std::array<uint32_t, 3> shape{};
+        int sliced_axis = -1;
+        int sliced_count = 0;
+        bool unit_step = true;
+        for (int axis = 0; axis < 3; axis++) {
+            int offset = 0;
+            int size = 0;
+            if (!ranges_.at(axis).resolve(int(input_shape[axis]), offset, size)) {
+                LOG(ERROR) << "The slice layer slices nothing from axis " << axis;
+                return InferStatus::kInferFailedOutputSizeError;
+            }
+            offsets[axis] = uint32_t(offset);
+            shape[axis] = uint32_t(size);
+            unit_step = unit_step && ranges_.at(axis).step == 1;
+            if (shape[axis] != input_shape[axis]) {
+                sliced_axis = axis;
+                sliced_count += 1;
+            }
+        }
+
+        std::shared_ptr<Tensor<float>> &output = outputs.at(b);
+        const bool matched = output != nullptr && output->channels() == shape[0] && output->rows() == shape[1]
+                             && output->cols() == shape[2];
+
+        /// 只在一个维度上切且该维度之外只有批次时，切出的部分连续存放，输出是持有输入的视图
+        if (unit_step && sliced_count <= 1) {
+            size_t view_offset = 0;
+            bool contiguous = true;
+            if (sliced_axis >= 0) {
+                const AxisSplit split = split_axis(input_shape[0], input_shape[1], input_shape[2], sliced_axis);
+                contiguous = split.outer == 1;
+                view_offset = size_t(offsets[sliced_axis]) * split.inner;
+            }
+            if (contiguous) {
+                float *view_data = input->raw_ptr() + view_offset;
+                if (!matched || output->raw_ptr() != view_data) {
+                    output = std::make_shared<ftensor>(view_data, shape[0], shape[1], shape[2], input);
+                }
+                continue;
+            }
+        }
+
+        if (!matched) {
+            LOG(ERROR) << "The output tensor shape of the slice layer is wrong";
+            return InferStatus::kInferFailedOutputSizeError;
+        }
+
+        const int channel_step = ranges_.at(0).step;
+        const int row_step = ranges_.at(1).step;
+        const int col_step = ranges_.at(2).step;
+        const float *input_data = input->raw_ptr();
+        float *output_data = output->raw_ptr();
+        for (uint32_t c = 0; c < shape[0]; c++) {
+            const float *input_channel =
+                input_data + size_t(offsets[0] + c * channel_step) * input_shape[1] * input_shape[2];
+            for (uint32_t w = 0; w < shape[2]; w++) {
+                const float *input_col = input_channel + size_t(offsets[2] + w * col_step) * input_shape[1] + offsets[1];
+                float *output_col = output_data + (size_t(c) * shape[2] + w) * shape[1];
+                if (row_step == 1) {
+                    std::copy(input_col, input_col + shape[1], output_col);
+                    continue;
+                }
+                for (uint32_t r = 0; r < shape[1]; r++) {
+                    output_col[r] = input_col[size_t(r) * row_step];
+                }
+            }
+        }
+    }
+    return InferStatus::kInferSuccess;
+}
+
+ParseParameterAttrStatus SliceLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                     std::shared_ptr<Layer> &slice_layer)
+{
+    CHECK(op != nullptr) << "slice operator is empty";
+
+    std::vector<int> dims;
+    std::vector<SliceRange> ranges;
+    if (!SliceRange::parse(op, dims, ranges)) {
+        LOG(ERROR) << "Can not find the dims, starts, ends and steps parameters of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingShape;
+    }
+
+    const int rank = input_rank_of(op);
+    std::array<SliceRange, 3> tensor_ranges;
+    std::array<bool, 3> sliced = {false, false, false};
+    for (size_t i = 0; i < dims.size(); i++) {
+        const int axis = tensor_axis_of(dims.at(i), rank);
+        if (axis < 0 || sliced.at(axis)) {
+            LOG(ERROR) << "The dim " << dims.at(i) << " of " << op->name << " is not supported";
+            return ParseParameterAttrStatus::kParameterMissingDim;
+        }
+        if (ranges.at(i).step <= 0) {
+            LOG(ERROR) << "The step of " << op->name << " must be positive";
+            return ParseParameterAttrStatus::kParameterMissingStride;
+        }
+        sliced.at(axis) = true;
+        tensor_ranges.at(axis) = ranges.at(i);
+    }
+
+    slice_layer = std::make_shared<SliceLayer>(tensor_ranges);
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper slice_create_instance("Tensor.slice", SliceLayer::create_instance);
+
+}// namespace jinfer
@@ -0,0 +1,164 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/softmax.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include "layer/abstract/reduction.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glog/logging.h>
+#include <limits>
+
+namespace jinfer
+{
+
+/// 连续存放的一行
+static void
+softmax_row(const float *input, float *output, uint32_t length)
+{
+    float max_value = std::numeric_limits<float>::lowest();
+#pragma omp simd reduction(max : max_value)
+    for (uint32_t l = 0; l < length; l++) {
+        max_value = std::max(max_value, input[l]);
+    }
+
+    float sum = 0.f;
+#pragma omp simd reduction(+ : sum)
+    for (uint32_t l = 0; l < length; l++) {
+        const float value = std::exp(input[l] - max_value);
+        output[l] = value;
+        sum += value;
+    }
+
+    const float scale = 1.f / sum;
+#pragma omp simd
+    for (uint32_t l = 0; l < length; l++) {
+        output[l] *= scale;
+    }
+}
+
+/// width个交错存放的行，第l个元素位于l * stride，同一位置的width个元素连续
+static void
+softmax_tile(const float *input, float *output, uint32_t length, uint32_t stride, uint32_t width)
+{
+    float max_values[SoftmaxLayer::kTileWidth];
+    float sums[SoftmaxLayer::kTileWidth];
+    std::fill(max_values, max_values + width, std::numeric_limits<float>::lowest());
+    std::fill(sums, sums + width, 0.f);
+
+    for (uint32_t l = 0; l < length; l++) {
+        const float *x = input + size_t(l) * stride;
+#pragma omp simd
+        for (uint32_t j = 0; j < width; j++) {
+            max_values[j] = std::max(max_values[j], x[j]);
+        }
+    }
+
+    for (uint32_t l = 0; l < length; l++) {
+        const float *x = input + size_t(l) * stride;
+        float *y = output + size_t(l) * stride;
+#pragma omp simd
+        for (uint32_t j = 0; j < width; j++) {
+            const float value = std::exp(x[j] - max_values[j]);
+            y[j] = value;
+            sums[j] += value;
+        }
+    }
+
+    for (uint32_t j = 0; j < width; j++) {
+        sums[j] = 1.f / sums[j];
+    }
+    for (uint32_t l = 0; l < length; l++) {
+        float *y = output + size_t(l) * stride;
+#pragma omp simd
+        for (uint32_t j = 0; j < width; j++) {
+            y[j] *= sums[j];
+        }
+    }
+}
+
+SoftmaxLayer::SoftmaxLayer(int axis) : Layer("Softmax"), axis_(axis)
+{
+    CHECK(axis_ >= 0 && axis_ < 3) << "the axis of softmax layer is wrong: " << axis_;
+}
+
+InferStatus SoftmaxLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                  std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the softmax layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the softmax layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty() || output == nullptr || output->empty()) {
+            LOG(ERROR) << "The input or output tensor in the softmax layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        if (input->raw_shapes() != inputs.front()->raw_shapes() || output->raw_shapes() != input->raw_shapes()) {
+            LOG(ERROR) << "The input and output tensor shapes of the softmax layer do not match";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+    }
+
+    const AxisSplit split = split_axis(inputs.front()->channels(), inputs.front()->rows(),
+                                       inputs.front()->cols(), axis_);
+    const size_t block_size = size_t(split.length) * split.inner;
+    const uint32_t tiles = (split.inner + kTileWidth - 1) / kTileWidth;
+    const uint32_t jobs = split.outer * tiles;
+
+    /// 批次、outer和inner方向的分块展开成一维后并行
+#pragma omp parallel for schedule(static) if (size_t(batch_size) * split.outer * block_size > 4096)
+    for (uint32_t index = 0; index < batch_size * jobs; index++) {
+        const uint32_t b = index / jobs;
+        const uint32_t o = index % jobs / tiles;
+        const uint32_t t = index % tiles;
+        const size_t offset = size_t(o) * block_size + size_t(t) * kTileWidth;
+        const float *input = inputs.at(b)->raw_ptr() + offset;
+        float *output = outputs.at(b)->raw_ptr() + offset;
+        if (split.inner == 1) {
+            softmax_row(input, output, split.length);
+        } else {
+            const uint32_t width = std::min(kTileWidth, split.inner - t * kTileWidth);
+            softmax_tile(input, output, split.length, split.inner, width);
+        }
+    }
+
+    return InferStatus::kInferSuccess;
+}
+
+ParseParameterAttrStatus SoftmaxLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                       std::shared_ptr<Layer> &softmax_layer)
+{
+    CHECK(op != nullptr) << "softmax operator is empty";
+
+    auto dim = op->get_param<RuntimeParameterInt>("dim");
+    if (!dim) {
+        LOG(ERROR) << "Can not find the dim parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingDim;
+    }
+
+    const int axis = tensor_axis_of(dim->value, input_rank_of(op));
+    if (axis < 0) {
+        LOG(ERROR) << "The dim " << dim->value << " of " << op->name << " is not supported";
+        return ParseParameterAttrStatus::kParameterMissingDim;
+    }
+
+    softmax_layer = std::make_shared<SoftmaxLayer>(axis);
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper softmax_create_instance("nn.Softmax", SoftmaxLayer::create_instance);
+LayerRegistererWrapper softmax_func_create_instance("F.softmax", SoftmaxLayer::create_instance);
+
+}// namespace jinfer
@@ -0,0 +1,193 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/split.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include "layer/abstract/reduction.hpp"
+#include <algorithm>
+#include <array>
+#include <glog/logging.h>
+#include <numeric>
+
+namespace jinfer
+{
+
+bool SplitSections::valid(int length) const
+{
+    if (length <= 0) {
+        return false;
+    }
+    if (!this->sizes.empty()) {
+        return std::accumulate(this->sizes.begin(), this->sizes.end(), 0) == length;
+    }
+    return this->chunks > 0 || this->split_size > 0;
+}
+
+/// torch.chunk每块的长度向上取整，与torch.split按长度切分相同
+static int
+piece_size(const SplitSections &sections, int length)
+{
+    return sections.chunks > 0 ? (length + sections.chunks - 1) / sections.chunks : sections.split_size;
+}
+
+int SplitSections::count(int length) const
+{
+    if (!this->sizes.empty()) {
+        return int(this->sizes.size());
+    }
+    const int size = piece_size(*this, length);
+    return (length + size - 1) / size;
+}
+
+void SplitSections::piece(int index, int length, int &offset, int &size) const
+{
+    if (!this->sizes.empty()) {
+        offset = std::accumulate(this->sizes.begin(), this->sizes.begin() + index, 0);
+        size = this->sizes.at(index);
+        return;
+    }
+    const int step = piece_size(*this, length);
+    offset = index * step;
+    size = std::min(step, length - offset);
+}
+
+bool SplitSections::parse(const std::shared_ptr<RuntimeOperator> &op, SplitSections &sections)
+{
+    sections = SplitSections();
+    if (op->type == "torch.chunk") {
+        auto chunks = op->get_param<RuntimeParameterInt>("chunks");
+        sections.chunks = chunks ? chunks->value : 0;
+        return sections.chunks > 0;
+    }
+
+    if (auto split_size = op->get_param<RuntimeParameterInt>("split_size_or_sections")) {
+        sections.split_size = split_size->value;
+        return sections.split_size > 0;
+    }
+    if (auto sizes = op->get_param<RuntimeParameterIntArray>("split_size_or_sections")) {
+        sections.sizes = sizes->value;
+        return !sections.sizes.empty()
+               && std::all_of(sections.sizes.begin(), sections.sizes.end(), [](int size) { return size > 0; });
+    }
+    return false;
+}
+
+SplitLayer::SplitLayer(int axis, SplitSections sections) : Layer("Split"), axis_(axis), sections_(std::move(sections))
+{
+    CHECK(axis_ >= 0 && axis_ < 3) << "the axis of split layer is invalid: " << axis_;
+}
+
+InferStatus SplitLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    return this->forward(inputs, std::vector<std::vector<std::shared_ptr<Tensor<float>>> *>{&outputs});
+}
+
+InferStatus SplitLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                const std::vector<std::vector<std::shared_ptr<Tensor<float>>> *> &outputs)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the split layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        if (input == nullptr || input->empty()) {
+            LOG(ERROR) << "The input tensor in the split layer is empty";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+        if (input->channels() != inputs.front()->channels() || input->rows() != inputs.front()->rows()
+            || input->cols() != inputs.front()->cols()) {
+            LOG(ERROR) << "The input tensors in the split layer have different shapes";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+    }
+
+    const std::array<uint32_t, 3> input_shape = {inputs.front()->channels(), inputs.front()->rows(),
+                                                 inputs.front()->cols()};
+    const AxisSplit split = split_axis(input_shape[0], input_shape[1], input_shape[2], axis_);
+    const int length = int(split.length);
+    if (!sections_.valid(length) || sections_.count(length) != int(outputs.size())) {
+        LOG(ERROR) << "The split layer can not split length " << length << " into " << outputs.size() << " outputs";
+        return InferStatus::kInferFailedOutputSizeError;
+    }
+
+    for (size_t i = 0; i < outputs.size(); i++) {
+        CHECK(outputs.at(i) != nullptr);
+        std::vector<std::shared_ptr<Tensor<float>>> &piece_outputs = *outputs.at(i);
+        if (piece_outputs.size() != batch_size) {
+            LOG(ERROR) << "The input and output tensor array size of the split layer do not match";
+            return InferStatus::kInferFailedInputOutSizeMatchError;
+        }
+
+        int offset = 0;
+        int size = 0;
+        sections_.piece(int(i), length, offset, size);
+        std::array<uint32_t, 3> shape = input_shape;
+        shape[axis_] = uint32_t(size);
+
+        for (uint32_t b = 0; b < batch_size; b++) {
+            const std::shared_ptr<Tensor<float>> &input = inputs.at(b);
+            std::shared_ptr<Tensor<float>> &output = piece_outputs.at(b);
+            const bool matched = output != nullptr && output->channels() == shape[0] && output->rows() == shape[1]
+                                 && output->cols() == shape[2];
+
+            /// outer为1时这一段在内存中连续，输出是持有输入的视图；上次的视图指向同一位置时直接复用
+            float *piece_data = input->raw_ptr() + size_t(offset) * split.inner;
+            if (split.outer == 1) {
+                if (!matched || output->raw_ptr() != piece_data) {
+                    output = std::make_shared<ftensor>(piece_data, shape[0], shape[1], shape[2], input);
+                }
+                continue;
+            }
+
+            if (!matched) {
+                LOG(ERROR) << "The output tensor shape of the split layer is wrong";
+                return InferStatus::kInferFailedOutputSizeError;
+            }
+
+            const size_t block = size_t(size) * split.inner;
+            const size_t stride = size_t(length) * split.inner;
+            float *output_data = output->raw_ptr();
+            for (uint32_t o = 0; o < split.outer; o++) {
+                std::copy(piece_data + o * stride, piece_data + o * stride + block, output_data + o * block);
+            }
+        }
+    }
+    return InferStatus::kInferSuccess;
+}
+
+ParseParameterAttrStatus SplitLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                     std::shared_ptr<Layer> &split_layer)
+{
+    CHECK(op != nullptr) << "split operator is empty";
+
+    auto dim = op->get_param<RuntimeParameterInt>("dim");
+    if (!dim) {
+        LOG(ERROR) << "Can not find the dim parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingDim;
+    }
+
+    const int axis = tensor_axis_of(dim->value, input_rank_of(op));
+    if (axis < 0) {
+        LOG(ERROR) << "The dim " << dim->value << " of " << op->name << " is not supported";
+        return ParseParameterAttrStatus::kParameterMissingDim;
+    }
+
+    SplitSections sections;
+    if (!SplitSections::parse(op, sections)) {
+        LOG(ERROR) << "Can not find the chunks or split_size_or_sections parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingShape;
+    }
+
+    split_layer = std::make_shared<SplitLayer>(axis, std::move(sections));
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper chunk_create_instance("torch.chunk", SplitLayer::create_instance);
+LayerRegistererWrapper split_create_instance("torch.split", SplitLayer::create_instance);
+
+}// namespace jinfer
@@ -0,0 +1,309 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/details/upsample.hpp"
+#include "data/workspace.hpp"
+#include "layer/abstract/layer_factory.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+struct ResizeWorkspace;
+
+bool ResizeParam::output_size(int input_h, int input_w, int &out_h, int &out_w) const
+{
+    if (this->output_h > 0 && this->output_w > 0) {
+        out_h = this->output_h;
+        out_w = this->output_w;
+    } else {
+        out_h = int(std::floor(double(input_h) * this->scale_h));
+        out_w = int(std::floor(double(input_w) * this->scale_w));
+    }
+    return input_h > 0 && input_w > 0 && out_h > 0 && out_w > 0;
+}
+
+ParseParameterAttrStatus ResizeParam::parse(const std::shared_ptr<RuntimeOperator> &op, ResizeParam &param)
+{
+    param = ResizeParam();
+    auto mode = op->get_param<RuntimeParameterString>("mode");
+    if (mode) {
+        if (mode->value == "nearest") {
+            param.mode = ResizeMode::kResizeNearest;
+        } else if (mode->value == "bilinear") {
+            param.mode = ResizeMode::kResizeBilinear;
+        } else {
+            LOG(ERROR) << "Unsupported resize mode " << mode->value << " of " << op->name;
+            return ParseParameterAttrStatus::kParameterMissingResizeMode;
+        }
+    } else if (op->type == "nn.UpsamplingBilinear2d") {
+        param.mode = ResizeMode::kResizeBilinear;
+        param.align_corners = true;
+    }
+
+    auto align_corners = op->get_param<RuntimeParameterBool>("align_corners");
+    if (align_corners) {
+        param.align_corners = align_corners->value;
+    }
+
+    /// size和scale_factor可以是一个数，也可以是(h, w)
+    if (auto size = op->get_param<RuntimeParameterIntArray>("size");
+        size && !size->value.empty() && size->value.size() <= 2) {
+        param.output_h = size->value.front();
+        param.output_w = size->value.back();
+    } else if (auto size_int = op->get_param<RuntimeParameterInt>("size")) {
+        param.output_h = param.output_w = size_int->value;
+    } else if (auto scale = op->get_param<RuntimeParameterFloatArray>("scale_factor");
+               scale && !scale->value.empty() && scale->value.size() <= 2) {
+        param.scale_h = scale->value.front();
+        param.scale_w = scale->value.back();
+    } else if (auto scale_float = op->get_param<RuntimeParameterFloat>("scale_factor")) {
+        param.scale_h = param.scale_w = scale_float->value;
+    }
+
+    if ((param.output_h <= 0 || param.output_w <= 0) && (param.scale_h <= 0.f || param.scale_w <= 0.f)) {
+        LOG(ERROR) << "Can not find the size or scale factor parameter of " << op->name;
+        return ParseParameterAttrStatus::kParameterMissingScale;
+    }
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+ResizeTable ResizeTable::build(const ResizeParam &param, uint32_t input_size, uint32_t output_size, float scale)
+{
+    ResizeTable table;
+    table.input_size = input_size;
+    table.index0.resize(output_size);
+    table.index1.resize(output_size);
+    table.lambda.resize(output_size);
+
+    /// 与pytorch一致，给定scale_factor时按1 / scale_factor映射坐标，而不是按输入输出大小的比值
+    const bool align_corners = param.mode == ResizeMode::kResizeBilinear && param.align_corners;
+    float ratio = 0.f;
+    if (align_corners) {
+        ratio = output_size > 1 ? float(input_size - 1) / float(output_size - 1) : 0.f;
+    } else {
+        ratio = scale > 0.f ? 1.f / scale : float(input_size) / float(output_size);
+    }
+
+    for (uint32_t i = 0; i < output_size; i++) {
+        if (param.mode == ResizeMode::kResizeNearest) {
+            const uint32_t index = std::min(uint32_t(std::floor(float(i) * ratio)), input_size - 1);
+            table.index0.at(i) = index;
+            table.index1.at(i) = index;
+            table.lambda.at(i) = 0.f;
+            continue;
+        }
+
+        float src = align_corners ? ratio * float(i) : ratio * (float(i) + 0.5f) - 0.5f;
+        src = std::max(src, 0.f);
+        const uint32_t index = std::min(uint32_t(src), input_size - 1);
+        table.index0.at(i) = index;
+        table.index1.at(i) = index + (index < input_size - 1 ? 1 : 0);
+        table.lambda.at(i) = src - float(index);
+    }
+    return table;
+}
+
+UpsampleLayer::UpsampleLayer(const ResizeParam &param) : Layer("Upsample"), param_(param)
+{
+}
+
+std::shared_ptr<const ResizePlan>
+UpsampleLayer::make_plan(uint32_t input_rows, uint32_t input_cols, uint32_t output_rows, uint32_t output_cols) const
+{
+    auto plan = std::make_shared<ResizePlan>();
+    plan->row_table = ResizeTable::build(param_, input_rows, output_rows, param_.scale_h);
+    plan->col_table = ResizeTable::build(param_, input_cols, output_cols, param_.scale_w);
+    return plan;
+}
+
+std::shared_ptr<const LayerPlan>
+UpsampleLayer::create_plan(const std::vector<std::vector<int>> &input_shapes,
+                           const std::vector<std::vector<int>> &output_shapes) const
+{
+    if (input_shapes.size() != 1 || output_shapes.size() != 1 || input_shapes.front().size() != 4
+        || output_shapes.front().size() != 4) {
+        return nullptr;
+    }
+    const std::vector<int> &input_shape = input_shapes.front();
+    const std::vector<int> &output_shape = output_shapes.front();
+    if (input_shape.at(2) <= 0 || input_shape.at(3) <= 0 || output_shape.at(2) <= 0 || output_shape.at(3) <= 0) {
+        return nullptr;
+    }
+    return this->make_plan(input_shape.at(2), input_shape.at(3), output_shape.at(2), output_shape.at(3));
+}
+
+InferStatus UpsampleLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                   std::vector<std::shared_ptr<Tensor<float>>> &outputs)
+{
+    return this->forward(inputs, outputs, nullptr);
+}
+
+InferStatus UpsampleLayer::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                   std::vector<std::shared_ptr<Tensor<float>>> &outputs,
+                                   const LayerPlan *plan)
+{
+    if (inputs.empty()) {
+        LOG(ERROR) << "The input tensor array in the upsample layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    if (inputs.size() != outputs.size()) {
+        LOG(ERROR) << "The input and output tensor array size of the upsample layer do not match";
+        return InferStatus::kInferFailedInputOutSizeMatchError;
+    }
+
+    const std::shared_ptr<Tensor<float>> &first = inputs.front();
+    if (first == nullptr || first->empty()) {
+        LOG(ERROR) << "The input tensor in the upsample layer is empty";
+        return InferStatus::kInferFailedInputEmpty;
+    }
+
+    const uint32_t channels = first->channels();
+    const uint32_t rows = first->rows();
+    const uint32_t cols = first->cols();
+    int output_rows = 0;
+    int output_cols = 0;
+    if (!param_.output_size(int(rows), int(cols), output_rows, output_cols)) {
+        LOG(ERROR) << "The output size of the upsample layer is wrong";
+        return InferStatus::kInferFailedOutputSizeError;
+    }
+
+    const uint32_t batch_size = inputs.size();
+    for (uint32_t i = 0; i < batch_size; i++) {
+        const std::shared_ptr<Tensor<float>> &input = inputs.at(i);
+        const std::shared_ptr<Tensor<float>> &output = outputs.at(i);
+        if (input == nullptr || input->empty() || input->channels() != channels || input->rows() != rows
+            || input->cols() != cols) {
+            LOG(ERROR) << "The input tensor shapes of the upsample layer do not match";
+            return InferStatus::kInferFailedInputEmpty;
+        }
+
+        if (output == nullptr || output->empty()) {
+            LOG(ERROR) << "The output tensor in the upsample layer is empty";
+            return InferStatus::kInferFailedOutputEmpty;
+        }
+
+        if (output->channels() != channels || output->rows() != uint32_t(output_rows)
+            || output->cols() != uint32_t(output_cols)) {
+            LOG(ERROR) << "The output tensor shape of the upsample layer is wrong";
+            return InferStatus::kInferFailedOutputSizeError;
+        }
+    }
+
+    /// 内存规划中的索引表与实际形状一致时直接使用，否则为这次调用临时计算，不修改层的状态
+    const auto *tables = dynamic_cast<const ResizePlan *>(plan);
+    std::shared_ptr<const ResizePlan> local_tables;
+    if (tables == nullptr || tables->row_table.input_size != rows || tables->col_table.input_size != cols
+        || tables->row_table.index0.size() != uint32_t(output_rows)
+        || tables->col_table.index0.size() != uint32_t(output_cols)) {
+        local_tables = this->make_plan(rows, cols, output_rows, output_cols);
+        tables = local_tables.get();
+    }
+
+    const uint32_t input_size = rows * cols;
+    const uint32_t output_size = uint32_t(output_rows) * uint32_t(output_cols);
+#pragma omp parallel for schedule(static)
+    for (uint32_t i = 0; i < batch_size * channels; i++) {
+        const uint32_t b = i / channels;
+        const uint32_t c = i % channels;
+        const float *input = inputs.at(b)->raw_ptr() + size_t(c) * input_size;
+        float *output = outputs.at(b)->raw_ptr() + size_t(c) * output_size;
+        if (param_.mode == ResizeMode::kResizeNearest) {
+            this->resize_nearest(tables->row_table, tables->col_table, input, output);
+        } else {
+            this->resize_bilinear(tables->row_table, tables->col_table, input, output);
+        }
+    }
+    return InferStatus::kInferSuccess;
+}
+
+void UpsampleLayer::resize_nearest(const ResizeTable &row_table, const ResizeTable &col_table,
+                                   const float *input, float *output) const
+{
+    const uint32_t rows = row_table.input_size;
+    const uint32_t output_rows = row_table.index0.size();
+    const uint32_t output_cols = col_table.index0.size();
+    const uint32_t *row_index = row_table.index0.data();
+
+    for (uint32_t ow = 0; ow < output_cols; ow++) {
+        float *dst = output + size_t(ow) * output_rows;
+        /// 放大时相邻的输出列来自同一输入列，直接复制上一列
+        if (ow > 0 && col_table.index0.at(ow) == col_table.index0.at(ow - 1)) {
+            std::memcpy(dst, dst - output_rows, output_rows * sizeof(float));
+            continue;
+        }
+
+        const float *src = input + size_t(col_table.index0.at(ow)) * rows;
+#pragma omp simd
+        for (uint32_t oh = 0; oh < output_rows; oh++) {
+            dst[oh] = src[row_index[oh]];
+        }
+    }
+}
+
+void UpsampleLayer::resize_bilinear(const ResizeTable &row_table, const ResizeTable &col_table,
+                                    const float *input, float *output) const
+{
+    const uint32_t rows = row_table.input_size;
+    const uint32_t output_rows = row_table.index0.size();
+    const uint32_t output_cols = col_table.index0.size();
+    const uint32_t *row_index0 = row_table.index0.data();
+    const uint32_t *row_index1 = row_table.index1.data();
+    const float *row_lambda = row_table.lambda.data();
+
+    /// 先在列方向上对两列输入插值得到一列，再按行的索引表在行方向上插值
+    float *column = thread_workspace<ResizeWorkspace>(rows);
+    for (uint32_t ow = 0; ow < output_cols; ow++) {
+        const uint32_t index0 = col_table.index0.at(ow);
+        const uint32_t index1 = col_table.index1.at(ow);
+        const float lambda = col_table.lambda.at(ow);
+        float *dst = output + size_t(ow) * output_rows;
+        if (ow > 0 && index0 == col_table.index0.at(ow - 1) && index1 == col_table.index1.at(ow - 1)
+            && lambda == col_table.lambda.at(ow - 1)) {
+            std::memcpy(dst, dst - output_rows, output_rows * sizeof(float));
+            continue;
+        }
+
+        const float *src0 = input + size_t(index0) * rows;
+        const float *src1 = input + size_t(index1) * rows;
+#pragma omp simd
+        for (uint32_t r = 0; r < rows; r++) {
+            column[r] = src0[r] + lambda * (src1[r] - src0[r]);
+        }
+
+#pragma omp simd
+        for (uint32_t oh = 0; oh < output_rows; oh++) {
+            const float top = column[row_index0[oh]];
+            const float bottom = column[row_index1[oh]];
+            dst[oh] = top + row_lambda[oh] * (bottom - top);
+        }
+    }
+}
+
+ParseParameterAttrStatus UpsampleLayer::create_instance(const std::shared_ptr<RuntimeOperator> &op,
+                                                        std::shared_ptr<Layer> &upsample_layer)
+{
+    CHECK(op != nullptr) << "upsample operator is empty";
+
+    ResizeParam param;
+    const ParseParameterAttrStatus status = ResizeParam::parse(op, param);
+    if (status != ParseParameterAttrStatus::kParameterAttrParseSuccess) {
+        return status;
+    }
+
+    upsample_layer = std::make_shared<UpsampleLayer>(param);
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+LayerRegistererWrapper upsample_create_instance("nn.Upsample", UpsampleLayer::create_instance);
+LayerRegistererWrapper upsample_nearest_create_instance("nn.UpsamplingNearest2d", UpsampleLayer::create_instance);
+LayerRegistererWrapper upsample_bilinear_create_instance("nn.UpsamplingBilinear2d", UpsampleLayer::create_instance);
+LayerRegistererWrapper interpolate_create_instance("F.interpolate", UpsampleLayer::create_instance);
+LayerRegistererWrapper upsample_func_create_instance("F.upsample", UpsampleLayer::create_instance);
+
+}// namespace jinfer
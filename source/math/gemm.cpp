@@ -0,0 +1,319 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "math/gemm.hpp"
+#include "data/workspace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <glog/logging.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define JINFER_GEMM_X86
+#include <immintrin.h>
+#endif
+
+namespace jinfer
+{
+
+/// 微内核计算MR x NR的小块：a为打包后的MR行面板，b为打包后的NR列面板，c为列主序
+using MicroKernel = void (*)(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, bool accumulate);
+
+struct GemmKernelInfo {
+    uint32_t mr;
+    uint32_t nr;
+    MicroKernel micro_kernel;
+};
+
+/// KC x NR的B面板放在L1，MC x KC的A块放在L2，NC x KC的B块放在L3；kNc是所有NR的公倍数
+static constexpr uint32_t kKc = 256;
+static constexpr uint32_t kMc = 256;
+static constexpr uint32_t kNc = 2016;
+static constexpr uint32_t kMaxTile = 32 * 12;
+
+struct PackedAWorkspace;
+struct PackedBWorkspace;
+
+static void
+micro_kernel_scalar(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, bool accumulate)
+{
+    constexpr uint32_t mr = 8;
+    constexpr uint32_t nr = 4;
+    float sum[nr][mr] = {};
+    for (uint32_t p = 0; p < kc; p++) {
+        for (uint32_t j = 0; j < nr; j++) {
+            const float b_value = b[j];
+            for (uint32_t i = 0; i < mr; i++) {
+                sum[j][i] += a[i] * b_value;
+            }
+        }
+        a += mr;
+        b += nr;
+    }
+
+    for (uint32_t j = 0; j < nr; j++) {
+        float *c_col = c + size_t(j) * ldc;
+        for (uint32_t i = 0; i < mr; i++) {
+            c_col[i] = accumulate ? c_col[i] + sum[j][i] : sum[j][i];
+        }
+    }
+}
+
+#ifdef JINFER_GEMM_X86
+/// 16 x 6的小块，12个累加寄存器加2个A寄存器和1个广播的B寄存器
+__attribute__((target("avx2,fma"))) static void
+micro_kernel_avx2(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, bool accumulate)
+{
+    constexpr uint32_t nr = 6;
+    __m256 sum0[nr];
+    __m256 sum1[nr];
+    for (uint32_t j = 0; j < nr; j++) {
+        sum0[j] = _mm256_setzero_ps();
+        sum1[j] = _mm256_setzero_ps();
+    }
+
+    for (uint32_t p = 0; p < kc; p++) {
+        const __m256 a0 = _mm256_loadu_ps(a);
+        const __m256 a1 = _mm256_loadu_ps(a + 8);
+        for (uint32_t j = 0; j < nr; j++) {
+            const __m256 b_value = _mm256_broadcast_ss(b + j);
+            sum0[j] = _mm256_fmadd_ps(a0, b_value, sum0[j]);
+            sum1[j] = _mm256_fmadd_ps(a1, b_value, sum1[j]);
+        }
+        a += 16;
+        b += nr;
+    }
+
+    for (uint32_t j = 0; j < nr; j++) {
+        float *c_col = c + size_t(j) * ldc;
+        if (accumulate) {
+            sum0[j] = _mm256_add_ps(sum0[j], _mm256_loadu_ps(c_col));
+            sum1[j] = _mm256_add_ps(sum1[j], _mm256_loadu_ps(c_col + 8));
+        }
+        _mm256_storeu_ps(c_col, sum0[j]);
+        _mm256_storeu_ps(c_col + 8, sum1[j]);
+    }
+}
+
+/// 32 x 12的小块，24个累加寄存器
+__attribute__((target("avx512f"))) static void
+micro_kernel_avx512(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, bool accumulate)
+{
+    constexpr uint32_t nr = 12;
+    __m512 sum0[nr];
+    __m512 sum1[nr];
+    for (uint32_t j = 0; j < nr; j++) {
+        sum0[j] = _mm512_setzero_ps();
+        sum1[j] = _mm512_setzero_ps();
+    }
+
+    for (uint32_t p = 0; p < kc; p++) {
+        const __m512 a0 = _mm512_loadu_ps(a);
+        const __m512 a1 = _mm512_loadu_ps(a + 16);
+        for (uint32_t j = 0; j < nr; j++) {
+            const __m512 b_value = _mm512_set1_ps(b[j]);
+            sum0[j] = _mm512_fmadd_ps(a0, b_value, sum0[j]);
+            sum1[j] = _mm512_fmadd_ps(a1, b_value, sum1[j]);
+        }
+        a += 32;
+        b += nr;
+    }
+
+    for (uint32_t j = 0; j < nr; j++) {
+        float *c_col = c + size_t(j) * ldc;
+        if (accumulate) {
+            sum0[j] = _mm512_add_ps(sum0[j], _mm512_loadu_ps(c_col));
+            sum1[j] = _mm512_add_ps(sum1[j], _mm512_loadu_ps(c_col + 16));
+        }
+        _mm512_storeu_ps(c_col, sum0[j]);
+        _mm512_storeu_ps(c_col + 16, sum1[j]);
+    }
+}
+#endif
+
+static GemmKernelInfo
+kernel_info(GemmKernel kernel)
+{
+    switch (kernel) {
+#ifdef JINFER_GEMM_X86
+    case GemmKernel::kGemmAvx512:
+        return {32, 12, micro_kernel_avx512};
+    case GemmKernel::kGemmAvx2:
+        return {16, 6, micro_kernel_avx2};
+#endif
+    default:
+        return {8, 4, micro_kernel_scalar};
+    }
+}
+
+static GemmKernel
+best_kernel()
+{
+    if (gemm_kernel_supported(GemmKernel::kGemmAvx512)) {
+        return GemmKernel::kGemmAvx512;
+    }
+    if (gemm_kernel_supported(GemmKernel::kGemmAvx2)) {
+        return GemmKernel::kGemmAvx2;
+    }
+    return GemmKernel::kGemmScalar;
+}
+
+static std::atomic<GemmKernel> &
+current_kernel()
+{
+    static std::atomic<GemmKernel> kernel{best_kernel()};
+    return kernel;
+}
+
+bool gemm_kernel_supported(GemmKernel kernel)
+{
+    switch (kernel) {
+    case GemmKernel::kGemmScalar:
+        return true;
+#ifdef JINFER_GEMM_X86
+    case GemmKernel::kGemmAvx2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case GemmKernel::kGemmAvx512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return false;
+    }
+}
+
+GemmKernel gemm_kernel()
+{
+    return current_kernel().load(std::memory_order_relaxed);
+}
+
+bool set_gemm_kernel(GemmKernel kernel)
+{
+    if (!gemm_kernel_supported(kernel)) {
+        return false;
+    }
+    current_kernel().store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * 把A的mc x kc子块打包成若干MR行的面板，每个面板内按列连续存放MR个元素，不足MR行的部分补0
+ */
+static void
+pack_a(uint32_t mc, uint32_t kc, const float *a, uint32_t lda, uint32_t mr, float *packed, bool parallel)
+{
+    const uint32_t panels = (mc + mr - 1) / mr;
+#pragma omp parallel for schedule(static) if (parallel)
+    for (uint32_t panel = 0; panel < panels; panel++) {
+        const uint32_t i0 = panel * mr;
+        const uint32_t rows = std::min(mr, mc - i0);
+        float *dst = packed + size_t(panel) * mr * kc;
+        for (uint32_t p = 0; p < kc; p++) {
+            const float *src = a + i0 + size_t(p) * lda;
+            std::memcpy(dst, src, rows * sizeof(float));
+            std::fill(dst + rows, dst + mr, 0.f);
+            dst += mr;
+        }
+    }
+}
+
+/**
+ * 把B的kc x nc子块打包成若干NR列的面板，每个面板内按行连续存放NR个元素，不足NR列的部分补0
+ */
+static void
+pack_b(uint32_t kc, uint32_t nc, const float *b, uint32_t ldb, uint32_t nr, float *packed, bool parallel)
+{
+    const uint32_t panels = (nc + nr - 1) / nr;
+#pragma omp parallel for schedule(static) if (parallel)
+    for (uint32_t panel = 0; panel < panels; panel++) {
+        const uint32_t j0 = panel * nr;
+        const uint32_t cols = std::min(nr, nc - j0);
+        float *dst = packed + size_t(panel) * nr * kc;
+        for (uint32_t p = 0; p < kc; p++) {
+            for (uint32_t j = 0; j < cols; j++) {
+                dst[j] = b[p + size_t(j0 + j) * ldb];
+            }
+            std::fill(dst + cols, dst + nr, 0.f);
+            dst += nr;
+        }
+    }
+}
+
+void sgemm(uint32_t m, uint32_t n, uint32_t k,
+           const float *a, uint32_t lda,
+           const float *b, uint32_t ldb,
+           float *c, uint32_t ldc,
+           bool accumulate)
+{
+    CHECK(lda >= m && ldb >= k && ldc >= m) << "the leading dimensions of gemm are too small";
+    if (m == 0 || n == 0) {
+        return;
+    }
+    if (k == 0) {
+        if (!accumulate) {
+            for (uint32_t j = 0; j < n; j++) {
+                std::fill(c + size_t(j) * ldc, c + size_t(j) * ldc + m, 0.f);
+            }
+        }
+        return;
+    }
+
+    const GemmKernelInfo info = kernel_info(gemm_kernel());
+    const uint32_t mr = info.mr;
+    const uint32_t nr = info.nr;
+
+    /// 打包缓冲区属于调用线程，大小只增不减，重复调用时不再分配
+    const uint32_t max_mc = std::min(kMc, (m + mr - 1) / mr * mr);
+    const uint32_t max_nc = std::min(kNc, (n + nr - 1) / nr * nr);
+    const uint32_t max_kc = std::min(kKc, k);
+    float *pa = thread_workspace<PackedAWorkspace>(size_t(max_mc) * max_kc);
+    float *pb = thread_workspace<PackedBWorkspace>(size_t(max_nc) * max_kc);
+
+    for (uint32_t jc = 0; jc < n; jc += kNc) {
+        const uint32_t nc = std::min(kNc, n - jc);
+        const uint32_t n_panels = (nc + nr - 1) / nr;
+        for (uint32_t pc = 0; pc < k; pc += kKc) {
+            const uint32_t kc = std::min(kKc, k - pc);
+            const bool accumulate_block = accumulate || pc > 0;
+            pack_b(kc, nc, b + pc + size_t(jc) * ldb, ldb, nr, pb, uint64_t(kc) * nc > 16384);
+
+            for (uint32_t ic = 0; ic < m; ic += kMc) {
+                const uint32_t mc = std::min(kMc, m - ic);
+                const uint32_t m_panels = (mc + mr - 1) / mr;
+                const bool parallel = uint64_t(mc) * nc * kc > 262144;
+                pack_a(mc, kc, a + ic + size_t(pc) * lda, lda, mr, pa, parallel);
+
+                /// m或n很小时另一维度仍有足够多的小块，所以两个维度一起划分
+#pragma omp parallel for collapse(2) schedule(static) if (parallel)
+                for (uint32_t jr = 0; jr < n_panels; jr++) {
+                    for (uint32_t ir = 0; ir < m_panels; ir++) {
+                        const uint32_t i0 = ir * mr;
+                        const uint32_t j0 = jr * nr;
+                        const float *a_panel = pa + size_t(ir) * mr * kc;
+                        const float *b_panel = pb + size_t(jr) * nr * kc;
+                        float *c_tile = c + (ic + i0) + size_t(jc + j0) * ldc;
+
+                        const uint32_t rows = std::min(mr, mc - i0);
+                        const uint32_t cols = std::min(nr, nc - j0);
+                        if (rows == mr && cols == nr) {
+                            info.micro_kernel(kc, a_panel, b_panel, c_tile, ldc, accumulate_block);
+                            continue;
+                        }
+
+                        /// 边缘的小块先算到临时缓冲区，再把有效部分写回
+                        float tile[kMaxTile];
+                        info.micro_kernel(kc, a_panel, b_panel, tile, mr, false);
+                        for (uint32_t j = 0; j < cols; j++) {
+                            float *c_col = c_tile + size_t(j) * ldc;
+                            const float *tile_col = tile + size_t(j) * mr;
+                            for (uint32_t i = 0; i < rows; i++) {
+                                c_col[i] = accumulate_block ? c_col[i] + tile_col[i] : tile_col[i];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+}// namespace jinfer
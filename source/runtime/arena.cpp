@@ -0,0 +1,56 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "runtime/arena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+Arena::Arena(size_t block_size) : block_size_(block_size)
+{
+    CHECK(block_size_ > 0) << "the block size of arena is empty";
+}
+
+void *Arena::allocate(size_t size, size_t alignment)
+{
+    CHECK(alignment > 0 && (alignment & (alignment - 1)) == 0) << "the alignment must be a power of two";
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    auto aligned = [alignment](char *ptr) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+        return reinterpret_cast<char *>((address + alignment - 1) & ~uintptr_t(alignment - 1));
+    };
+
+    char *begin = this->cursor_ ? aligned(this->cursor_) : nullptr;
+    if (begin == nullptr || begin + size > this->end_) {
+        /// 当前块放不下时申请新块，超过块大小的对象按自身大小申请，并留出对齐所需的空间
+        const size_t bytes = std::max(this->block_size_, size + alignment);
+        this->blocks_.emplace_back(new char[bytes]);
+        this->cursor_ = this->blocks_.back().get();
+        this->end_ = this->cursor_ + bytes;
+        this->reserved_bytes_ += bytes;
+        begin = aligned(this->cursor_);
+    }
+
+    this->used_bytes_ += begin + size - this->cursor_;
+    this->cursor_ = begin + size;
+    return begin;
+}
+
+size_t Arena::reserved_bytes() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->reserved_bytes_;
+}
+
+size_t Arena::used_bytes() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->used_bytes_;
+}
+
+}// namespace jinfer
@@ -0,0 +1,208 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/batching_server.hpp"
+#include <glog/logging.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace jinfer
+{
+
+/// 不进入队列的请求直接返回一个已经失败的future
+static std::future<std::shared_ptr<Tensor<float>>>
+failed_future(const std::string &message)
+{
+    std::promise<std::shared_ptr<Tensor<float>>> promise;
+    promise.set_exception(std::make_exception_ptr(std::runtime_error(message)));
+    return promise.get_future();
+}
+
+static bool
+same_shape(const std::shared_ptr<Tensor<float>> &a, const std::shared_ptr<Tensor<float>> &b)
+{
+    return a->channels() == b->channels() && a->rows() == b->rows() && a->cols() == b->cols();
+}
+
+BatchingServer::BatchingServer(std::shared_ptr<const CompiledModel> model, const BatchingOptions &options)
+    : model_(std::move(model)), options_(options), queue_(options.queue_capacity)
+{
+    CHECK(this->model_ != nullptr) << "the model of server is null";
+    CHECK(this->options_.max_batch_size > 0) << "the max batch size should be positive";
+    CHECK(this->options_.worker_num > 0) << "the worker number should be positive";
+
+    for (uint32_t i = 0; i < this->options_.worker_num; i++) {
+        this->workers_.emplace_back(&BatchingServer::run, this);
+    }
+}
+
+BatchingServer::~BatchingServer()
+{
+    this->stop();
+}
+
+std::future<std::shared_ptr<Tensor<float>>>
+BatchingServer::submit(std::shared_ptr<Tensor<float>> input)
+{
+    /// 提交时就校验形状，不合法的样本不会进入批次，也不会让同一批次的其他请求失败
+    std::vector<int> input_shape;
+    if (input == nullptr || !this->model_->input_shape_of({input}, input_shape)) {
+        return failed_future("the input tensor is empty or does not match the model input");
+    }
+
+    /// 先登记正在提交的线程再检查是否停止，工作线程要等所有提交完成、队列为空后才退出
+    this->submitting_.fetch_add(1);
+    if (this->stopped_.load()) {
+        this->submitting_.fetch_sub(1);
+        return failed_future("the server is stopped");
+    }
+
+    Request request;
+    request.input = std::move(input);
+    request.arrival = Clock::now();
+    auto future = request.promise.get_future();
+    /// 入队前增加计数，工作线程取出请求后的减一不会使计数小于零
+    this->pending_.fetch_add(1);
+    while (!this->queue_.try_push(request)) {
+        std::this_thread::yield();
+    }
+    this->submitting_.fetch_sub(1);
+
+    /// 先增加计数再检查等待者，与run中的顺序相反，保证不会丢失唤醒
+    if (this->waiting_.load() > 0) {
+        std::lock_guard<std::mutex> lock(this->wait_mutex_);
+        this->wait_cond_.notify_one();
+    }
+    return future;
+}
+
+void BatchingServer::stop()
+{
+    if (this->stopped_.exchange(true)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->wait_mutex_);
+        this->wait_cond_.notify_all();
+    }
+    for (auto &worker : this->workers_) {
+        worker.join();
+    }
+    this->workers_.clear();
+
+    /// 工作线程退出时队列已经为空，这里只是兜底，不让调用者一直等待
+    Request request;
+    while (this->queue_.try_pop(request)) {
+        this->pending_.fetch_sub(1);
+        request.promise.set_exception(std::make_exception_ptr(std::runtime_error("the server is stopped")));
+    }
+}
+
+uint64_t BatchingServer::batches() const
+{
+    return this->batches_.load();
+}
+
+uint64_t BatchingServer::requests() const
+{
+    return this->requests_.load();
+}
+
+bool BatchingServer::pop_request(Request &request, const Clock::time_point *deadline)
+{
+    while (true) {
+        if (this->queue_.try_pop(request)) {
+            this->pending_.fetch_sub(1);
+            return true;
+        }
+        if (this->stopped_.load() && this->submitting_.load() == 0) {
+            /// 停止后没有正在提交的线程，再取一次，队列为空才退出
+            if (this->queue_.try_pop(request)) {
+                this->pending_.fetch_sub(1);
+                return true;
+            }
+            return false;
+        }
+        if (deadline && Clock::now() >= *deadline) {
+            return false;
+        }
+
+        this->waiting_.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(this->wait_mutex_);
+            auto ready = [this]() { return this->pending_.load() > 0 || this->stopped_.load(); };
+            if (deadline) {
+                this->wait_cond_.wait_until(lock, *deadline, ready);
+            } else {
+                this->wait_cond_.wait(lock, ready);
+            }
+        }
+        this->waiting_.fetch_sub(1);
+    }
+}
+
+void BatchingServer::run()
+{
+    Session session(this->model_);
+    std::vector<Request> batch;
+    std::optional<Request> carried;
+    while (true) {
+        batch.clear();
+        if (carried) {
+            batch.push_back(std::move(*carried));
+            carried.reset();
+        } else {
+            Request request;
+            if (!this->pop_request(request, nullptr)) {
+                break;
+            }
+            batch.push_back(std::move(request));
+        }
+
+        /// 只合并与第一个请求形状相同的请求，形状不同的留到下一批
+        const Clock::time_point deadline = batch.front().arrival + this->options_.max_delay;
+        while (batch.size() < this->options_.max_batch_size) {
+            Request request;
+            if (!this->pop_request(request, &deadline)) {
+                break;
+            }
+            if (!same_shape(request.input, batch.front().input)) {
+                carried = std::move(request);
+                break;
+            }
+            batch.push_back(std::move(request));
+        }
+        this->forward_batch(session, batch);
+    }
+}
+
+void BatchingServer::forward_batch(Session &session, std::vector<Request> &batch)
+{
+    std::vector<std::shared_ptr<Tensor<float>>> inputs;
+    inputs.reserve(batch.size());
+    for (const auto &request : batch) {
+        inputs.push_back(request.input);
+    }
+
+    /// 会话的输出张量在下一次推理时会被复用，返回给调用者的是拷贝
+    const auto &outputs = session.forward(inputs);
+    if (outputs.size() != batch.size()) {
+        /// 推理失败只影响这一批次的请求，服务继续运行
+        LOG(ERROR) << "the forward of a batch with " << batch.size() << " requests failed";
+        const auto error = std::make_exception_ptr(std::runtime_error("the forward of the batch failed"));
+        for (auto &request : batch) {
+            request.promise.set_exception(error);
+        }
+        return;
+    }
+
+    /// 先更新统计，调用者拿到结果时统计中已经包含了它的请求
+    this->batches_.fetch_add(1);
+    this->requests_.fetch_add(batch.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+        batch.at(i).promise.set_value(std::make_shared<Tensor<float>>(*outputs.at(i)));
+    }
+}
+
+}// namespace jinfer
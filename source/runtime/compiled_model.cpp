@@ -0,0 +1,134 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/compiled_model.hpp"
+#include <algorithm>
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+std::shared_ptr<const CompiledModel>
+CompiledModel::compile(const std::string &param_path, const std::string &bin_path,
+                       const std::string &input_name, const std::string &output_name)
+{
+    auto graph = std::make_unique<RuntimeGraph>(param_path, bin_path);
+    if (!graph->init() || !graph->build(input_name, output_name)) {
+        LOG(ERROR) << "compile model " << param_path << " fail";
+        return nullptr;
+    }
+    return std::shared_ptr<const CompiledModel>(new CompiledModel(std::move(graph)));
+}
+
+CompiledModel::CompiledModel(std::unique_ptr<RuntimeGraph> graph) : graph_(std::move(graph))
+{
+    const auto &topo_operators = this->graph_->get_topo_seq();
+    CHECK(!topo_operators.empty() && topo_operators.front()->type == "pnnx.Input")
+        << "the first operator of topology sequence is not an input operator";
+
+    /// 输入操作数的名称即为产生它的节点名称
+    std::map<std::string, size_t> topo_indices;
+    for (size_t i = 0; i < topo_operators.size(); i++) {
+        topo_indices.insert({topo_operators.at(i)->name, i});
+    }
+
+    this->activation_count_ = topo_operators.size();
+    for (size_t i = 0; i < topo_operators.size(); i++) {
+        const auto &op = topo_operators.at(i);
+        CompiledOperator compiled_op;
+        compiled_op.op = op;
+        for (const auto &input_operand : op->input_operands_seq) {
+            auto iter = topo_indices.find(input_operand->name);
+            CHECK(iter != topo_indices.end() && iter->second < i)
+                << "the input operand " << input_operand->name << " of operator " << op->name
+                << " is not produced before it";
+            const auto &output_indices = this->operators_.at(iter->second).output_indices;
+            CHECK(input_operand->output_index < output_indices.size())
+                << "operator " << input_operand->name << " has no output " << input_operand->output_index;
+            compiled_op.input_indices.push_back(output_indices.at(input_operand->output_index));
+        }
+
+        compiled_op.output_indices.push_back(i);
+        for (size_t k = 1; k < op->output_operands.size(); k++) {
+            compiled_op.output_indices.push_back(this->activation_count_++);
+        }
+
+        if (op->type == "pnnx.Output") {
+            CHECK(compiled_op.input_indices.size() == 1)
+                << "output operator " << op->name << " should have one input operand";
+        } else if (op->type != "pnnx.Input") {
+            CHECK(op->layer != nullptr)
+                << "no layer for operator " << op->name << " of type " << op->type;
+        }
+        this->operators_.push_back(std::move(compiled_op));
+    }
+
+    /// 输出节点可以是中间节点，此时推理结果就是它自己的输出
+    const auto &output_op = this->graph_->output_operators().front();
+    auto output_iter = topo_indices.find(output_op->name);
+    CHECK(output_iter != topo_indices.end()) << "output operator " << output_op->name << " is not in topology sequence";
+    this->output_index_ = output_op->type == "pnnx.Output"
+                              ? this->operators_.at(output_iter->second).input_indices.front()
+                              : output_iter->second;
+}
+
+const std::vector<CompiledOperator> &
+CompiledModel::operators() const
+{
+    return this->operators_;
+}
+
+size_t CompiledModel::output_index() const
+{
+    return this->output_index_;
+}
+
+size_t CompiledModel::activation_count() const
+{
+    return this->activation_count_;
+}
+
+bool CompiledModel::input_shape_of(const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                   std::vector<int> &input_shape) const
+{
+    input_shape.clear();
+    if (inputs.empty()) {
+        LOG(ERROR) << "the inputs of model are empty";
+        return false;
+    }
+    return this->graph_->input_shape_of(this->operators_.front().op, inputs, input_shape);
+}
+
+std::shared_ptr<const MemoryPlan>
+CompiledModel::memory_plan(const std::vector<int> &input_shape) const
+{
+    std::lock_guard<std::mutex> lock(this->plan_mutex_);
+    auto iter = this->memory_plans_.find(input_shape);
+    if (iter == this->memory_plans_.end()) {
+        auto plan = std::make_shared<MemoryPlan>();
+        if (!this->graph_->create_memory_plan(input_shape, *plan)) {
+            LOG(ERROR) << "cannot create the memory plan for the input shapes of the model";
+            return nullptr;
+        }
+
+        /// 输入形状很多时只保留最近使用的规划，正在使用被淘汰规划的会话仍持有它
+        if (this->memory_plans_.size() >= kMaxMemoryPlans) {
+            auto oldest = std::min_element(this->memory_plans_.begin(), this->memory_plans_.end(),
+                                           [](const auto &a, const auto &b) {
+                                               return a.second.last_use < b.second.last_use;
+                                           });
+            this->memory_plans_.erase(oldest);
+        }
+        iter = this->memory_plans_.insert({input_shape, CachedPlan{std::move(plan)}}).first;
+    }
+    iter->second.last_use = ++this->plan_uses_;
+    return iter->second.plan;
+}
+
+const std::shared_ptr<TensorAllocator> &
+CompiledModel::tensor_allocator() const
+{
+    return this->graph_->tensor_allocator();
+}
+
+}// namespace jinfer
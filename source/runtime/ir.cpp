@@ -669,7 +669,7 @@ load_shape(Operator *op, const std::string &key, const std::string &value)
 }
 
 static void
-load_attribute(Operator *op, const std::string &key, const std::string &value, StoreZipReader &szr)
+load_attribute(Operator *op, const std::string &key, const std::string &value, StoreZipReader &szr, bool load_weights)
 {
     Attribute &a = op->attrs[key];
 
@@ -717,11 +717,14 @@ load_attribute(Operator *op, const std::string &key, const std::string &value, S
         fprintf(stderr, "file size not match expect %lu but got %lu\n", bytesize, filesize);
     }
 
+    if (!load_weights)
+        return;
+
     a.data.resize(bytesize);
     szr.read_file(filename, (char *) a.data.data());
 }
 
-int Graph::load(const std::string &parampath, const std::string &binpath)
+int Graph::load(const std::string &parampath, const std::string &binpath, bool load_weights)
 {
     std::ifstream is(parampath, std::ios::in | std::ios::binary);
     if (!is.good()) {
@@ -799,7 +802,7 @@ int Graph::load(const std::string &parampath, const std::string &binpath)
 
             if (key[0] == '@') {
                 // attribute
-                load_attribute(op, key.substr(1), value, szr);
+                load_attribute(op, key.substr(1), value, szr, load_weights);
             } else if (key[0] == '$') {
                 // operand input key
                 load_input_key(op, key.substr(1), value);
@@ -0,0 +1,279 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/pipeline_executor.hpp"
+#include <chrono>
+#include <glog/logging.h>
+#include <limits>
+#include <omp.h>
+#include <stdexcept>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace jinfer
+{
+
+/// 轮询为空时先自旋，再让出cpu，长时间空闲后短暂休眠
+static void
+backoff(uint32_t &spins)
+{
+    spins += 1;
+    if (spins < 64) {
+        return;
+    }
+    if (spins < 1024) {
+        std::this_thread::yield();
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+}
+
+static void
+pin_current_thread(const std::vector<int> &cpus)
+{
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &cpu_set);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+        LOG(WARNING) << "failed to pin pipeline stage to the given cpus";
+    }
+#else
+    LOG(WARNING) << "pinning pipeline stages is only supported on linux";
+#endif
+}
+
+PipelineExecutor::PipelineExecutor(std::shared_ptr<const CompiledModel> model,
+                                   const std::vector<std::shared_ptr<Tensor<float>>> &sample_inputs,
+                                   const PipelineOptions &options)
+    : model_(std::move(model)), options_(options), free_frames_(options.max_in_flight),
+      entry_(options.max_in_flight)
+{
+    CHECK(this->model_ != nullptr) << "the model of pipeline is null";
+    CHECK(this->options_.stage_num > 0) << "the stage number should be positive";
+    CHECK(this->options_.max_in_flight > 0) << "the max in flight requests should be positive";
+    CHECK(this->options_.cpu_sets.empty() || this->options_.cpu_sets.size() == this->options_.stage_num)
+        << "the cpu sets should be given for every stage";
+
+    const std::vector<double> costs = measure_costs(this->model_, sample_inputs, this->options_.calibration_runs);
+    this->boundaries_ = partition_stages(costs, this->options_.stage_num);
+    const size_t stage_num = this->boundaries_.size() - 1;
+
+    for (size_t i = 0; i < this->options_.max_in_flight; i++) {
+        this->frames_.push_back(std::make_unique<Frame>(this->model_));
+        Frame *frame = this->frames_.back().get();
+        CHECK(this->free_frames_.try_push(frame));
+    }
+    for (size_t i = 0; i + 1 < stage_num; i++) {
+        this->rings_.push_back(std::make_unique<SpscRing<Frame *>>(this->options_.max_in_flight));
+    }
+
+    this->finished_ = std::make_unique<std::atomic<bool>[]>(stage_num);
+    for (size_t i = 0; i < stage_num; i++) {
+        this->finished_[i].store(false);
+    }
+    for (size_t i = 0; i < stage_num; i++) {
+        this->stages_.emplace_back(&PipelineExecutor::run_stage, this, i);
+    }
+}
+
+PipelineExecutor::~PipelineExecutor()
+{
+    this->stop();
+}
+
+std::future<std::vector<std::shared_ptr<Tensor<float>>>>
+PipelineExecutor::submit(std::vector<std::shared_ptr<Tensor<float>>> inputs)
+{
+    this->submitting_.fetch_add(1);
+    if (this->stopped_.load()) {
+        this->submitting_.fetch_sub(1);
+        std::promise<std::vector<std::shared_ptr<Tensor<float>>>> promise;
+        promise.set_exception(std::make_exception_ptr(std::runtime_error("the pipeline is stopped")));
+        return promise.get_future();
+    }
+
+    Frame *frame = nullptr;
+    uint32_t spins = 0;
+    while (!this->free_frames_.try_pop(frame)) {
+        backoff(spins);
+    }
+
+    /// 在提交线程中确定内存规划，形状不合法的请求不进入流水线
+    frame->inputs = std::move(inputs);
+    frame->promise = std::promise<std::vector<std::shared_ptr<Tensor<float>>>>();
+    auto future = frame->promise.get_future();
+    if (!frame->session.set_inputs(frame->inputs)) {
+        this->fail_frame(frame, "the inputs do not match the model");
+        this->submitting_.fetch_sub(1);
+        return future;
+    }
+
+    spins = 0;
+    while (!this->entry_.try_push(frame)) {
+        backoff(spins);
+    }
+    this->submitting_.fetch_sub(1);
+    return future;
+}
+
+void PipelineExecutor::stop()
+{
+    if (this->stopped_.exchange(true)) {
+        return;
+    }
+    for (auto &stage : this->stages_) {
+        stage.join();
+    }
+    this->stages_.clear();
+}
+
+const std::vector<size_t> &
+PipelineExecutor::stage_boundaries() const
+{
+    return this->boundaries_;
+}
+
+bool PipelineExecutor::pop_frame(size_t stage, Frame *&frame)
+{
+    uint32_t spins = 0;
+    while (true) {
+        if (stage == 0) {
+            if (this->entry_.try_pop(frame)) {
+                return true;
+            }
+            if (this->stopped_.load() && this->submitting_.load() == 0) {
+                return this->entry_.try_pop(frame);
+            }
+        } else {
+            SpscRing<Frame *> &ring = *this->rings_.at(stage - 1);
+            if (ring.try_pop(frame)) {
+                return true;
+            }
+            if (this->finished_[stage - 1].load()) {
+                return ring.try_pop(frame);
+            }
+        }
+        backoff(spins);
+    }
+}
+
+void PipelineExecutor::run_stage(size_t stage)
+{
+    if (!this->options_.cpu_sets.empty()) {
+        pin_current_thread(this->options_.cpu_sets.at(stage));
+    }
+    omp_set_num_threads(int(this->options_.threads_per_stage));
+
+    const size_t begin = this->boundaries_.at(stage);
+    const size_t end = this->boundaries_.at(stage + 1);
+    const bool last_stage = stage + 2 == this->boundaries_.size();
+
+    Frame *frame = nullptr;
+    while (this->pop_frame(stage, frame)) {
+        if (!frame->session.forward_operators(begin, end)) {
+            this->fail_frame(frame, "the forward of the pipeline failed");
+            continue;
+        }
+        if (!last_stage) {
+            uint32_t spins = 0;
+            while (!this->rings_.at(stage)->try_push(frame)) {
+                backoff(spins);
+            }
+            continue;
+        }
+
+        /// 会话的张量会被下一个请求复用，返回给调用者的是拷贝
+        std::vector<std::shared_ptr<Tensor<float>>> outputs;
+        for (const auto &output : frame->session.outputs()) {
+            outputs.push_back(std::make_shared<Tensor<float>>(*output));
+        }
+        frame->inputs.clear();
+        auto promise = std::move(frame->promise);
+        CHECK(this->free_frames_.try_push(frame));
+        promise.set_value(std::move(outputs));
+    }
+    this->finished_[stage].store(true);
+}
+
+void PipelineExecutor::fail_frame(Frame *frame, const std::string &message)
+{
+    frame->inputs.clear();
+    auto promise = std::move(frame->promise);
+    CHECK(this->free_frames_.try_push(frame));
+    promise.set_exception(std::make_exception_ptr(std::runtime_error(message)));
+}
+
+std::vector<size_t>
+PipelineExecutor::partition_stages(const std::vector<double> &costs, uint32_t stage_num)
+{
+    CHECK(!costs.empty()) << "the costs of operators are empty";
+    CHECK(stage_num > 0) << "the stage number should be positive";
+    const size_t op_num = costs.size();
+    const size_t part_num = std::min<size_t>(stage_num, op_num);
+
+    std::vector<double> prefix(op_num + 1, 0.);
+    for (size_t i = 0; i < op_num; i++) {
+        prefix.at(i + 1) = prefix.at(i) + costs.at(i);
+    }
+
+    /// best[k][i]为前i个节点切成k段时最大一段的最小耗时，split记录最后一段的起点
+    const double infinity = std::numeric_limits<double>::max();
+    std::vector<std::vector<double>> best(part_num + 1, std::vector<double>(op_num + 1, infinity));
+    std::vector<std::vector<size_t>> split(part_num + 1, std::vector<size_t>(op_num + 1, 0));
+    best[0][0] = 0.;
+    for (size_t k = 1; k <= part_num; k++) {
+        for (size_t i = k; i <= op_num; i++) {
+            for (size_t j = k - 1; j < i; j++) {
+                if (best[k - 1][j] == infinity) {
+                    continue;
+                }
+                const double cost = std::max(best[k - 1][j], prefix[i] - prefix[j]);
+                if (cost < best[k][i]) {
+                    best[k][i] = cost;
+                    split[k][i] = j;
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> boundaries(part_num + 1, 0);
+    boundaries.back() = op_num;
+    for (size_t k = part_num, i = op_num; k > 0; k--) {
+        i = split[k][i];
+        boundaries.at(k - 1) = i;
+    }
+    return boundaries;
+}
+
+std::vector<double>
+PipelineExecutor::measure_costs(const std::shared_ptr<const CompiledModel> &model,
+                                const std::vector<std::shared_ptr<Tensor<float>>> &sample_inputs,
+                                uint32_t runs)
+{
+    using Clock = std::chrono::steady_clock;
+    const size_t op_num = model->operators().size();
+    std::vector<double> costs(op_num, 0.);
+
+    /// 第一次推理分配激活值，不计入耗时
+    Session session(model);
+    CHECK(!session.forward(sample_inputs).empty()) << "the forward of the sample inputs failed";
+    for (uint32_t run = 0; run < runs; run++) {
+        CHECK(session.set_inputs(sample_inputs));
+        for (size_t i = 0; i < op_num; i++) {
+            const auto start = Clock::now();
+            CHECK(session.forward_operators(i, i + 1));
+            costs.at(i) += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        }
+    }
+    for (double &cost : costs) {
+        cost /= std::max(runs, 1u);
+    }
+    return costs;
+}
+
+}// namespace jinfer
@@ -0,0 +1,241 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <glog/logging.h>
+#include <sstream>
+
+namespace jinfer
+{
+
+static uint64_t
+tensors_size(const std::vector<std::shared_ptr<Tensor<float>>> &tensors)
+{
+    uint64_t size = 0;
+    for (const auto &tensor : tensors) {
+        if (tensor) {
+            size += tensor->size();
+        }
+    }
+    return size;
+}
+
+static uint64_t
+kernel_area(const std::shared_ptr<RuntimeOperator> &op)
+{
+    auto kernel_size = op->get_param<RuntimeParameterIntArray>("kernel_size");
+    if (!kernel_size || kernel_size->value.empty()) {
+        return 1;
+    }
+    uint64_t area = 1;
+    for (int kernel : kernel_size->value) {
+        area *= uint64_t(std::max(kernel, 1));
+    }
+    return area;
+}
+
+static std::string
+escape_json(const std::string &text)
+{
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(c);
+    }
+    return escaped;
+}
+
+Profiler::Profiler() : origin_(Clock::now())
+{
+}
+
+void Profiler::begin_run()
+{
+    this->runs_ += 1;
+}
+
+void Profiler::record(const std::shared_ptr<RuntimeOperator> &op, Clock::time_point start, Clock::time_point end)
+{
+    CHECK(op != nullptr) << "the profiled operator is null";
+    const double duration_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    const uint64_t flops = estimate_flops(op);
+    const uint64_t bytes_read = estimate_bytes_read(op);
+    const uint64_t bytes_written = estimate_bytes_written(op);
+
+    auto iter = this->profiles_.find(op->name);
+    if (iter == this->profiles_.end()) {
+        OperatorProfile profile;
+        profile.name = op->name;
+        profile.type = op->type;
+        profile.min_ms = duration_ms;
+        profile.max_ms = duration_ms;
+        iter = this->profiles_.insert({op->name, profile}).first;
+        this->order_.push_back(op->name);
+    }
+
+    OperatorProfile &profile = iter->second;
+    profile.calls += 1;
+    profile.total_ms += duration_ms;
+    profile.min_ms = std::min(profile.min_ms, duration_ms);
+    profile.max_ms = std::max(profile.max_ms, duration_ms);
+    profile.flops += flops;
+    profile.bytes_read += bytes_read;
+    profile.bytes_written += bytes_written;
+
+    TraceEvent event;
+    event.name = op->name;
+    event.type = op->type;
+    event.run = this->runs_;
+    event.start_us = std::chrono::duration<double, std::micro>(start - this->origin_).count();
+    event.duration_us = duration_ms * 1000.;
+    event.flops = flops;
+    event.bytes = bytes_read + bytes_written;
+    this->trace_events_.push_back(std::move(event));
+}
+
+uint32_t Profiler::runs() const
+{
+    return this->runs_;
+}
+
+std::vector<OperatorProfile> Profiler::profiles() const
+{
+    std::vector<OperatorProfile> profiles;
+    for (const auto &name : this->order_) {
+        profiles.push_back(this->profiles_.at(name));
+    }
+    std::stable_sort(profiles.begin(), profiles.end(), [](const OperatorProfile &a, const OperatorProfile &b) {
+        return a.total_ms > b.total_ms;
+    });
+    return profiles;
+}
+
+const std::vector<TraceEvent> &Profiler::trace_events() const
+{
+    return this->trace_events_;
+}
+
+std::string Profiler::report() const
+{
+    const std::vector<OperatorProfile> profiles = this->profiles();
+    double total_ms = 0.;
+    for (const auto &profile : profiles) {
+        total_ms += profile.total_ms;
+    }
+
+    std::ostringstream stream;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-24s %-20s %8s %10s %10s %7s %10s %9s\n",
+                  "name", "type", "calls", "total(ms)", "avg(ms)", "%", "GFLOP/s", "GB/s");
+    stream << line;
+    for (const auto &profile : profiles) {
+        const double seconds = profile.total_ms / 1000.;
+        const double gflops = seconds > 0. ? double(profile.flops) / seconds * 1e-9 : 0.;
+        const double gbytes = seconds > 0. ? double(profile.bytes_read + profile.bytes_written) / seconds * 1e-9 : 0.;
+        const double percent = total_ms > 0. ? profile.total_ms / total_ms * 100. : 0.;
+        std::snprintf(line, sizeof(line), "%-24s %-20s %8llu %10.3f %10.3f %7.2f %10.2f %9.2f\n",
+                      profile.name.c_str(), profile.type.c_str(), (unsigned long long) profile.calls,
+                      profile.total_ms, profile.total_ms / double(profile.calls), percent, gflops, gbytes);
+        stream << line;
+    }
+    std::snprintf(line, sizeof(line), "runs: %u, total: %.3f ms, per run: %.3f ms\n",
+                  this->runs_, total_ms, this->runs_ ? total_ms / this->runs_ : 0.);
+    stream << line;
+    return stream.str();
+}
+
+bool Profiler::dump_chrome_trace(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG(ERROR) << "cannot open trace file: " << path;
+        return false;
+    }
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < this->trace_events_.size(); i++) {
+        const TraceEvent &event = this->trace_events_.at(i);
+        if (i != 0) {
+            file << ",";
+        }
+        file << "\n{\"name\":\"" << escape_json(event.name) << "\",\"cat\":\"" << escape_json(event.type)
+             << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.run
+             << ",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us
+             << ",\"args\":{\"flops\":" << event.flops << ",\"bytes\":" << event.bytes << "}}";
+    }
+    file << "\n]}\n";
+    return file.good();
+}
+
+void Profiler::clear()
+{
+    this->origin_ = Clock::now();
+    this->runs_ = 0;
+    this->order_.clear();
+    this->profiles_.clear();
+    this->trace_events_.clear();
+}
+
+uint64_t Profiler::estimate_flops(const std::shared_ptr<RuntimeOperator> &op)
+{
+    const uint64_t output_size = op->output_operand ? tensors_size(op->output_operand->data) : 0;
+    uint64_t input_size = 0;
+    for (const auto &operand : op->input_operands_seq) {
+        input_size += tensors_size(operand->data);
+    }
+
+    if (op->type == "nn.Conv2d") {
+        auto in_channels = op->get_param<RuntimeParameterInt>("in_channels");
+        auto groups = op->get_param<RuntimeParameterInt>("groups");
+        const uint64_t group_channels = in_channels ? uint64_t(in_channels->value) / uint64_t(groups ? std::max(groups->value, 1) : 1) : 1;
+        return output_size * group_channels * kernel_area(op) * 2;
+    }
+    if (op->type == "nn.Linear") {
+        auto in_features = op->get_param<RuntimeParameterInt>("in_features");
+        return output_size * (in_features ? uint64_t(in_features->value) : 1) * 2;
+    }
+    if (op->type == "nn.MaxPool2d" || op->type == "nn.AvgPool2d") {
+        return output_size * kernel_area(op);
+    }
+    if (op->type == "nn.AdaptiveAvgPool2d" || op->type == "torch.sum" || op->type == "torch.mean"
+        || op->type == "torch.amax" || op->type == "torch.amin") {
+        return input_size;
+    }
+    return output_size;
+}
+
+uint64_t Profiler::estimate_bytes_read(const std::shared_ptr<RuntimeOperator> &op)
+{
+    uint64_t size = 0;
+    for (const auto &operand : op->input_operands_seq) {
+        size += tensors_size(operand->data);
+    }
+
+    /// 权重可能已经在创建层时被清空，按形状计算
+    for (const auto &[_, attr] : op->attrs) {
+        if (attr->shape.empty()) {
+            continue;
+        }
+        uint64_t attr_size = 1;
+        for (int dim : attr->shape) {
+            attr_size *= uint64_t(std::max(dim, 0));
+        }
+        size += attr_size;
+    }
+    return size * sizeof(float);
+}
+
+uint64_t Profiler::estimate_bytes_written(const std::shared_ptr<RuntimeOperator> &op)
+{
+    if (!op->output_operand) {
+        return 0;
+    }
+    return tensors_size(op->output_operand->data) * sizeof(float);
+}
+
+}// namespace jinfer
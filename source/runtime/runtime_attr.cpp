@@ -8,44 +8,38 @@
 namespace jinfer
 {
 
-template<class T>
-std::vector<T>
-RuntimeAttribute::get(bool need_clear_weight)
+void RuntimeAttribute::materialize()
 {
-    CHECK(!this->weight_data.empty());
-    CHECK(this->type != RuntimeDataType::kTypeUnknown);
-
-    std::vector<T> weights;
-    switch (this->type) {
-    case RuntimeDataType::kTypeFloat32: {
-        bool same_type = std::is_same<T, float>::value;
-        CHECK_EQ(same_type, true);
-        const uint32_t float_size = sizeof(float);
-        CHECK_EQ(this->weight_data.size() % float_size, 0);
-
-        for (uint32_t i = 0; i < this->weight_data.size() / float_size; i++) {
-            float weight = *((float *) weight_data.data() + i);
-            weights.push_back(weight);
-        }
-        break;
+    if (!this->weight_source) {
+        return;
     }
 
-    default: {
-        LOG(FATAL) << "Unknown weight data type: " << int(type);
-    }
+    const size_t size = this->weight_source->get_file_size(this->weight_name);
+    if (size != 0) {
+        this->weight_data.resize(size);
+        if (this->weight_source->read_file(this->weight_name, this->weight_data.data()) != 0) {
+            LOG(ERROR) << "Cannot read the weight " << this->weight_name;
+            this->weight_data.clear();
+        }
     }
 
-    if (need_clear_weight) {
-        this->clear_weight();
-    }
+    this->weight_source.reset();
+    this->weight_name.clear();
+}
+
+bool RuntimeAttribute::pending() const
+{
+    return this->weight_source != nullptr;
 }
 
 void RuntimeAttribute::clear_weight()
 {
+    this->weight_source.reset();
+    this->weight_name.clear();
     if (!this->weight_data.empty()) {
         std::vector<char> tmp = std::vector<char>();
         this->weight_data.swap(tmp);
     }
 }
 
-}// namespace jinfer
\ No newline at end of file
+}// namespace jinfer
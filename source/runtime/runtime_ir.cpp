@@ -2,14 +2,23 @@
 // Created by 27836 on 2025/6/15.
 //
 
+#include "layer/abstract/layer_factory.hpp"
+#include "layer/abstract/reduction.hpp"
+#include "layer/details/layout_transform.hpp"
+#include "runtime/shape_infer.hpp"
 #include <runtime/runtime_ir.hpp>
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <queue>
+#include <set>
 
 namespace jinfer
 {
 
 RuntimeGraph::RuntimeGraph(std::string param_path, std::string bin_path)
-    : param_path_(std::move(param_path)), bin_path_(std::move(bin_path))
+    : param_path_(std::move(param_path)), bin_path_(std::move(bin_path)),
+      arena_(std::make_shared<Arena>()), tensor_allocator_(std::make_shared<PoolAllocator>())
 {
 }
 
@@ -57,11 +66,14 @@ bool RuntimeGraph::init()
         return false;
     }
 
+    /// 权重只记录在模型文件中的位置，构建时再读取输入可达的部分
     this->graph_ = std::make_unique<pnnx::Graph>();
-    int load_result = this->graph_->load(this->param_path_, this->bin_path_);
-    if (load_result != 0) {
+    int load_result = this->graph_->load(this->param_path_, this->bin_path_, false);
+    this->weight_reader_ = std::make_shared<pnnx::StoreZipReader>();
+    if (load_result != 0 || this->weight_reader_->open(this->bin_path_) != 0) {
         LOG(ERROR) << "Cannot find the param path or bin path: " << this->param_path_
                    << " " << this->bin_path_;
+        this->weight_reader_.reset();
         return false;
     }
 
@@ -108,6 +120,8 @@ bool RuntimeGraph::init()
         }
     }
 
+    /// 文件由尚未读取的属性共同持有，全部读取或清空后关闭
+    this->weight_reader_.reset();
     this->graph_state_ = GraphState::need_build;
     return true;
 }
@@ -122,15 +136,20 @@ void RuntimeGraph::init_input_ops(const std::vector<pnnx::Operand *> &inputs,
                                   const std::shared_ptr<RuntimeOperator> &runtime_operator)
 {
     for (auto *input : inputs) {
-        std::shared_ptr<RuntimeOperand> runtime_operand = std::make_shared<RuntimeOperand>();
+        std::shared_ptr<RuntimeOperand> runtime_operand = this->arena_make_shared<RuntimeOperand>();
         runtime_operand->name = input->producer->name;
+        const auto &producer_outputs = input->producer->outputs;
+        runtime_operand->output_index =
+            uint32_t(std::find(producer_outputs.begin(), producer_outputs.end(), input) - producer_outputs.begin());
+        CHECK(runtime_operand->output_index < producer_outputs.size())
+            << "operand " << input->name << " is not an output of operator " << input->producer->name;
         runtime_operand->shape = input->shape;
         check_shape(input->shape);
 
         switch (input->type) {
+        /// 输入操作数的数据在forward时直接复用前驱节点的输出，这里不再分配
         case 1: {
             runtime_operand->type = RuntimeDataType::kTypeFloat32;
-            init_data(runtime_operand->data, input->shape);
             break;
         }
 
@@ -154,30 +173,23 @@ void RuntimeGraph::init_output_ops(const std::vector<pnnx::Operand *> &outputs,
                                    const std::shared_ptr<RuntimeOperator> &runtime_operator)
 {
     CHECK(!outputs.empty()) << "no output operand in operator " << runtime_operator->name;
-    CHECK(outputs.size() == 1)
-        << "jinfer only supports one output operand for each operator, current op: "
-        << runtime_operator->name << ", output num: " << outputs.size();
 
-    /// 采用循环：日后可能改成多输出
     for (auto *output : outputs) {
-        if (!output) {
-            continue;
-        }
-
+        CHECK(output != nullptr) << "empty output operand in operator " << runtime_operator->name;
         check_shape(output->shape);
-        runtime_operator->output_operand = std::make_shared<RuntimeOperand>();
-        runtime_operator->output_operand->shape = output->shape;
-        runtime_operator->output_operand->name = output->name + "_output";
+        std::shared_ptr<RuntimeOperand> output_operand = this->arena_make_shared<RuntimeOperand>();
+        output_operand->shape = output->shape;
+        output_operand->name = output->name + "_output";
 
         switch (output->type) {
         case 1: {
-            runtime_operator->output_operand->type = RuntimeDataType::kTypeFloat32;
-            init_data(runtime_operator->output_operand->data, output->shape);
+            output_operand->type = RuntimeDataType::kTypeFloat32;
+            init_data(output_operand->data, output->shape, RuntimeDataLayout::kLayoutNCHW, this->tensor_allocator_);
             break;
         }
 
         case 0: {
-            runtime_operator->output_operand->type = RuntimeDataType::kTypeUnknown;
+            output_operand->type = RuntimeDataType::kTypeUnknown;
             break;
         }
 
@@ -186,8 +198,13 @@ void RuntimeGraph::init_output_ops(const std::vector<pnnx::Operand *> &outputs,
             break;
         }
         }
+        runtime_operator->output_operands.push_back(output_operand);
 
+        /// 同一个后继节点可能使用多个输出，只记录一次
         for (const auto *consumer : output->consumers) {
+            if (runtime_operator->output_operators.count(consumer->name)) {
+                continue;
+            }
             runtime_operator->output_names.push_back(consumer->name);
 
             std::shared_ptr<RuntimeOperator> output_operator;
@@ -201,6 +218,7 @@ void RuntimeGraph::init_output_ops(const std::vector<pnnx::Operand *> &outputs,
             runtime_operator->output_operators.insert({consumer->name, output_operator});
         }
     }
+    runtime_operator->output_operand = runtime_operator->output_operands.front();
 }
 
 void RuntimeGraph::init_op_attrs(const std::map<std::string, pnnx::Attribute> &attrs,
@@ -210,11 +228,15 @@ void RuntimeGraph::init_op_attrs(const std::map<std::string, pnnx::Attribute> &a
         switch (attr.type) {
         // float32
         case 1: {
-            std::shared_ptr<RuntimeAttribute> runtime_attr =
-                std::make_shared<RuntimeAttribute>();
+            std::shared_ptr<RuntimeAttribute> runtime_attr = this->arena_make_shared<RuntimeAttribute>();
             runtime_attr->type = RuntimeDataType::kTypeFloat32;
-            runtime_attr->weight_data = attr.data;
             runtime_attr->shape = attr.shape;
+            if (!attr.data.empty()) {
+                runtime_attr->weight_data = attr.data;
+            } else if (this->weight_reader_ && !attr.shape.empty()) {
+                runtime_attr->weight_source = this->weight_reader_;
+                runtime_attr->weight_name = runtime_operator->name + "." + name;
+            }
             runtime_operator->attrs.insert({name, runtime_attr});
             break;
         }
@@ -237,20 +259,20 @@ void RuntimeGraph::init_op_params(const std::map<std::string, pnnx::Parameter> &
         const int type = param.type;
         switch (type) {
         case int(RuntimeParameterType::kParameterUnknown): {
-            std::shared_ptr<RuntimeParameter> runtime_parameter = std::make_shared<RuntimeParameter>();
+            std::shared_ptr<RuntimeParameter> runtime_parameter = this->arena_make_shared<RuntimeParameter>();
             runtime_operator->params.insert({name, runtime_parameter});
             break;
         }
 
         case int(RuntimeParameterType::kParameterBool): {
-            std::shared_ptr<RuntimeParameterBool> runtime_parameter = std::make_shared<RuntimeParameterBool>();
+            std::shared_ptr<RuntimeParameterBool> runtime_parameter = this->arena_make_shared<RuntimeParameterBool>();
             runtime_parameter->value = param.b;
             runtime_operator->params.insert({name, runtime_parameter});
             break;
         }
 
         case int(RuntimeParameterType::kParameterInt): {
-            std::shared_ptr<RuntimeParameterInt> runtime_parameter = std::make_shared<RuntimeParameterInt>();
+            std::shared_ptr<RuntimeParameterInt> runtime_parameter = this->arena_make_shared<RuntimeParameterInt>();
             runtime_parameter->value = param.i;
             runtime_operator->params.insert({name, runtime_parameter});
             break;
@@ -258,7 +280,7 @@ void RuntimeGraph::init_op_params(const std::map<std::string, pnnx::Parameter> &
 
         case int(RuntimeParameterType::kParameterFloat): {
             std::shared_ptr<RuntimeParameterFloat> runtime_parameter =
-                std::make_shared<RuntimeParameterFloat>();
+                this->arena_make_shared<RuntimeParameterFloat>();
             runtime_parameter->value = param.f;
             runtime_operator->params.insert({name, runtime_parameter});
             break;
@@ -266,7 +288,7 @@ void RuntimeGraph::init_op_params(const std::map<std::string, pnnx::Parameter> &
 
         case int(RuntimeParameterType::kParameterString): {
             std::shared_ptr<RuntimeParameterString> runtime_parameter =
-                std::make_shared<RuntimeParameterString>();
+                this->arena_make_shared<RuntimeParameterString>();
             runtime_parameter->value = param.s;
             runtime_operator->params.insert({name, runtime_parameter});
             break;
@@ -274,7 +296,7 @@ void RuntimeGraph::init_op_params(const std::map<std::string, pnnx::Parameter> &
 
         case int(RuntimeParameterType::kParameterIntArray): {
             std::shared_ptr<RuntimeParameterIntArray> runtime_parameter =
-                std::make_shared<RuntimeParameterIntArray>();
+                this->arena_make_shared<RuntimeParameterIntArray>();
             runtime_parameter->value = param.ai;
             runtime_operator->params.insert({name, runtime_parameter});
             break;
@@ -282,7 +304,7 @@ void RuntimeGraph::init_op_params(const std::map<std::string, pnnx::Parameter> &
 
         case int(RuntimeParameterType::kParameterFloatArray): {
             std::shared_ptr<RuntimeParameterFloatArray> runtime_parameter =
-                std::make_shared<RuntimeParameterFloatArray>();
+                this->arena_make_shared<RuntimeParameterFloatArray>();
             runtime_parameter->value = param.af;
             runtime_operator->params.insert({name, runtime_parameter});
             break;
@@ -290,7 +312,7 @@ void RuntimeGraph::init_op_params(const std::map<std::string, pnnx::Parameter> &
 
         case int(RuntimeParameterType::kParameterStringArray): {
             std::shared_ptr<RuntimeParameterStringArray> runtime_parameter =
-                std::make_shared<RuntimeParameterStringArray>();
+                this->arena_make_shared<RuntimeParameterStringArray>();
             runtime_parameter->value = param.as;
             runtime_operator->params.insert({name, runtime_parameter});
             break;
@@ -304,31 +326,194 @@ void RuntimeGraph::init_op_params(const std::map<std::string, pnnx::Parameter> &
     }
 }
 
-void RuntimeGraph::reverse_topo(const std::shared_ptr<RuntimeOperator> &cur)
+/// 操作数的元素个数，动态维度按1估计
+static int64_t
+operand_size(const std::shared_ptr<RuntimeOperand> &operand)
 {
-    CHECK(cur != nullptr) << "start operator is null";
-    cur->has_forward = true;
+    int64_t size = 1;
+    for (int dim : operand->shape) {
+        size *= std::max(dim, 1);
+    }
+    return size;
+}
+
+bool RuntimeGraph::init_topo_seq()
+{
+    /// 每个节点尚未排序的前驱个数，以及每个节点尚未排序的后继个数(决定它的输出何时可以释放)
+    std::map<const RuntimeOperator *, size_t> in_degrees;
+    std::map<const RuntimeOperator *, size_t> pending_consumers;
+    for (const auto &op : this->operators_) {
+        if (!this->subgraph_.count(op.get())) {
+            continue;
+        }
+
+        size_t in_degree = 0;
+        for (const auto &[name, _] : op->input_operands) {
+            auto prev_iter = this->operators_map_.find(name);
+            if (prev_iter != this->operators_map_.end() && this->subgraph_.count(prev_iter->second.get())) {
+                in_degree += 1;
+            }
+        }
+        in_degrees.insert({op.get(), in_degree});
+
+        size_t consumers = 0;
+        for (const auto &[_, next_op] : op->output_operators) {
+            consumers += this->subgraph_.count(next_op.get());
+        }
+        pending_consumers.insert({op.get(), consumers});
+    }
+
+    /// 就绪节点和它就绪的次序，次序越大越晚就绪；输入节点逆序加入，保证第一个输入排在最前
+    std::vector<std::pair<std::shared_ptr<RuntimeOperator>, size_t>> ready;
+    size_t ready_order = 0;
+    for (auto iter = this->input_ops_.rbegin(); iter != this->input_ops_.rend(); ++iter) {
+        const auto &input_op = *iter;
+        const bool seeded = std::any_of(ready.begin(), ready.end(),
+                                        [&input_op](const auto &item) { return item.first == input_op; });
+        if (!seeded && this->subgraph_.count(input_op.get())) {
+            ready.emplace_back(input_op, ready_order++);
+        }
+    }
 
-    if (!cur->output_operators.empty()) {
-        for (auto &[_, op] : cur->output_operators) {
-            if (!op->has_forward) {
-                reverse_topo(op);
+    this->topo_operators_.clear();
+    while (!ready.empty()) {
+        /// 执行一个节点新增它的输出，并释放以它为最后一个消费者的输入
+        size_t best = 0;
+        int64_t best_delta = std::numeric_limits<int64_t>::max();
+        for (size_t i = 0; i < ready.size(); i++) {
+            const auto &op = ready.at(i).first;
+            int64_t delta = 0;
+            if (op->type != "pnnx.Input" && op->output_operand) {
+                delta += operand_size(op->output_operand);
+            }
+            for (const auto &[name, operand] : op->input_operands) {
+                auto prev_iter = this->operators_map_.find(name);
+                if (prev_iter == this->operators_map_.end()) {
+                    continue;
+                }
+                auto consumer_iter = pending_consumers.find(prev_iter->second.get());
+                if (consumer_iter != pending_consumers.end() && consumer_iter->second == 1) {
+                    delta -= operand_size(operand);
+                }
+            }
+
+            if (delta < best_delta || (delta == best_delta && ready.at(i).second > ready.at(best).second)) {
+                best = i;
+                best_delta = delta;
+            }
+        }
+
+        const std::shared_ptr<RuntimeOperator> op = ready.at(best).first;
+        ready.erase(ready.begin() + best);
+        this->topo_operators_.push_back(op);
+
+        for (const auto &[name, _] : op->input_operands) {
+            auto prev_iter = this->operators_map_.find(name);
+            if (prev_iter != this->operators_map_.end()) {
+                auto consumer_iter = pending_consumers.find(prev_iter->second.get());
+                if (consumer_iter != pending_consumers.end() && consumer_iter->second > 0) {
+                    consumer_iter->second -= 1;
+                }
+            }
+        }
+
+        for (const auto &[_, next_op] : op->output_operators) {
+            auto degree_iter = in_degrees.find(next_op.get());
+            if (degree_iter != in_degrees.end() && --degree_iter->second == 0) {
+                ready.emplace_back(next_op, ready_order++);
             }
         }
     }
 
-    this->topo_operators_.push_back(cur);
+    /// 环上以及环之后的节点入度永远不会降为0
+    if (this->topo_operators_.size() != in_degrees.size()) {
+        for (const auto &op : this->operators_) {
+            auto degree_iter = in_degrees.find(op.get());
+            if (degree_iter != in_degrees.end() && degree_iter->second != 0) {
+                LOG(ERROR) << "the graph has a cycle, operator " << op->name << " cannot be scheduled";
+                break;
+            }
+        }
+        return false;
+    }
+    return true;
 }
 
-void RuntimeGraph::init_topo_seq(const std::shared_ptr<RuntimeOperator> &start)
+bool RuntimeGraph::collect_subgraph()
 {
-    this->reverse_topo(start);
-    std::reverse(this->topo_operators_.begin(), this->topo_operators_.end());
+    std::set<const RuntimeOperator *> reachable;
+    std::vector<std::shared_ptr<RuntimeOperator>> stack;
+    for (const auto &input_op : this->input_ops_) {
+        if (reachable.insert(input_op.get()).second) {
+            stack.push_back(input_op);
+        }
+    }
+    while (!stack.empty()) {
+        const std::shared_ptr<RuntimeOperator> op = stack.back();
+        stack.pop_back();
+        for (const auto &[_, next_op] : op->output_operators) {
+            if (reachable.insert(next_op.get()).second) {
+                stack.push_back(next_op);
+            }
+        }
+    }
+
+    /// 从输出节点沿输入操作数反向遍历，只保留输入可达的前驱
+    this->subgraph_.clear();
+    for (const auto &output_op : this->output_ops_) {
+        if (!reachable.count(output_op.get())) {
+            LOG(ERROR) << "output operator " << output_op->name << " is unreachable from the input operators";
+            return false;
+        }
+        if (this->subgraph_.insert(output_op.get()).second) {
+            stack.push_back(output_op);
+        }
+    }
+    while (!stack.empty()) {
+        const std::shared_ptr<RuntimeOperator> op = stack.back();
+        stack.pop_back();
+        for (const auto &input_operand : op->input_operands_seq) {
+            auto prev_iter = this->operators_map_.find(input_operand->name);
+            if (prev_iter == this->operators_map_.end()) {
+                continue;
+            }
+
+            const std::shared_ptr<RuntimeOperator> &prev_op = prev_iter->second;
+            if (reachable.count(prev_op.get())) {
+                if (this->subgraph_.insert(prev_op.get()).second) {
+                    stack.push_back(prev_op);
+                }
+            } else if (prev_op->type == "pnnx.Input") {
+                LOG(ERROR) << "operator " << op->name << " depends on input operator " << prev_op->name
+                           << ", which is not one of the input operators";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool RuntimeGraph::is_internal(const std::shared_ptr<RuntimeOperator> &op) const
+{
+    return this->subgraph_.count(op.get())
+           && std::find(this->output_ops_.begin(), this->output_ops_.end(), op) == this->output_ops_.end();
+}
+
+void RuntimeGraph::materialize_weights()
+{
+    for (const auto &op : this->operators_) {
+        if (!this->subgraph_.count(op.get())) {
+            continue;
+        }
+        for (const auto &[_, attr] : op->attrs) {
+            attr->materialize();
+        }
+    }
 }
 
 std::shared_ptr<RuntimeOperator> RuntimeGraph::create_op(const std::string& name)
 {
-    auto runtime_operator = std::make_shared<RuntimeOperator>();
+    auto runtime_operator = this->arena_make_shared<RuntimeOperator>();
     this->operators_.push_back(runtime_operator);
     this->operators_map_.insert({name, runtime_operator});
     return runtime_operator;
@@ -340,6 +525,13 @@ GraphState RuntimeGraph::state() const
 }
 
 bool RuntimeGraph::build(std::string input_op_name, std::string output_op_name)
+{
+    return this->build(std::vector<std::string>{std::move(input_op_name)},
+                       std::vector<std::string>{std::move(output_op_name)});
+}
+
+bool RuntimeGraph::build(const std::vector<std::string> &input_op_names,
+                         const std::vector<std::string> &output_op_names)
 {
     switch (this->graph_state_) {
     case GraphState::need_init:
@@ -359,15 +551,57 @@ bool RuntimeGraph::build(std::string input_op_name, std::string output_op_name)
         return false;
     }
 
-    this->input_name_ = std::move(input_op_name);
-    this->output_name_ = std::move(output_op_name);
+    if (input_op_names.empty() || output_op_names.empty()) {
+        LOG(ERROR) << "the input or output operators of graph are empty";
+        return false;
+    }
+
+    this->input_names_ = input_op_names;
+    this->output_names_ = output_op_names;
+    this->input_ops_.clear();
+    this->output_ops_.clear();
+    for (const auto &name : this->input_names_) {
+        auto iter = this->operators_map_.find(name);
+        if (iter == this->operators_map_.end() || iter->second->type != "pnnx.Input") {
+            LOG(ERROR) << "cannot find input operator: " << name;
+            return false;
+        }
+        this->input_ops_.push_back(iter->second);
+    }
+    for (const auto &name : this->output_names_) {
+        auto iter = this->operators_map_.find(name);
+        if (iter == this->operators_map_.end()) {
+            LOG(ERROR) << "cannot find output operator: " << name;
+            return false;
+        }
+        this->output_ops_.push_back(iter->second);
+    }
 
-    try {
-        std::shared_ptr<RuntimeOperator> input_op = this->operators_map_.at(this->input_name_);
-        this->topo_operators_.clear();
-        this->init_topo_seq(input_op);
-    } catch (std::exception &e) {
-        LOG(FATAL) << "init topology sequence fail: " << e.what();
+    if (!this->collect_subgraph()) {
+        LOG(ERROR) << "cannot extract the subgraph between the input and output operators";
+        return false;
+    }
+    this->materialize_weights();
+    this->fuse_operators();
+
+    /// 融合删除了子图中的节点，插入布局转换节点后也需要重新计算子图并排序
+    this->collect_subgraph();
+    if (!this->init_topo_seq()) {
+        LOG(ERROR) << "init topology sequence fail";
+        return false;
+    }
+    if (this->blocked_layout_ && this->propagate_layout()) {
+        this->collect_subgraph();
+        CHECK(this->init_topo_seq()) << "the layout transform operators create a cycle";
+    }
+
+    if (!this->create_layers()) {
+        LOG(ERROR) << "cannot create the layers of the graph";
+        return false;
+    }
+    this->memory_plans_.clear();
+    if (!this->infer_shapes()) {
+        LOG(ERROR) << "the operand shapes of graph are inconsistent with the model file";
         return false;
     }
 
@@ -380,36 +614,658 @@ const std::vector<std::shared_ptr<RuntimeOperator>> &RuntimeGraph::get_topo_seq(
     return this->topo_operators_;
 }
 
+bool RuntimeGraph::create_layers()
+{
+    for (const auto &op : this->topo_operators_) {
+        if (op->type == "pnnx.Input" || op->type == "pnnx.Output") {
+            continue;
+        }
+
+        if (!LayerRegisterer::has_creator(op->type)) {
+            LOG(ERROR) << "no layer registered for operator " << op->name << " of type " << op->type;
+            return false;
+        }
+
+        ParseParameterAttrStatus status = ParseParameterAttrStatus::kParameterMissingUnknown;
+        std::shared_ptr<Layer> layer = LayerRegisterer::create_layer(op, status);
+        if (!layer) {
+            LOG(ERROR) << "create layer " << op->name << " of type " << op->type << " fail, status: " << int(status);
+            return false;
+        }
+
+        layer->set_runtime_operator(op);
+        op->layer = layer;
+
+        /// 权重已经复制或重排到层中，释放原始数据
+        for (const auto &[_, attr] : op->attrs) {
+            attr->clear_weight();
+        }
+    }
+    return true;
+}
+
+const std::vector<std::shared_ptr<Tensor<float>>> &
+RuntimeGraph::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs)
+{
+    CHECK(this->graph_state_ == GraphState::completed)
+        << "the graph has not been built, forward fail";
+    if (!this->forward_graph(&inputs, 1)) {
+        /// 失败时不清空结果操作数，它的缓冲区留给下一次推理复用
+        static const std::vector<std::shared_ptr<Tensor<float>>> empty_outputs;
+        return empty_outputs;
+    }
+    return result_operand(this->output_ops_.front())->data;
+}
+
+std::vector<std::vector<std::shared_ptr<Tensor<float>>>>
+RuntimeGraph::forward(const std::vector<std::vector<std::shared_ptr<Tensor<float>>>> &inputs)
+{
+    CHECK(this->graph_state_ == GraphState::completed)
+        << "the graph has not been built, forward fail";
+    std::vector<std::vector<std::shared_ptr<Tensor<float>>>> outputs;
+    if (!this->forward_graph(inputs.data(), inputs.size())) {
+        return outputs;
+    }
+
+    outputs.reserve(this->output_ops_.size());
+    for (const auto &output_op : this->output_ops_) {
+        outputs.push_back(result_operand(output_op)->data);
+    }
+    return outputs;
+}
+
+bool RuntimeGraph::forward_graph(const std::vector<std::shared_ptr<Tensor<float>>> *inputs, size_t input_count)
+{
+    CHECK_EQ(input_count, this->input_ops_.size())
+        << "the number of inputs is different from the number of input operators";
+
+    this->input_shape_.clear();
+    for (size_t k = 0; k < input_count; k++) {
+        if (inputs[k].empty() || inputs[k].size() != inputs[0].size()) {
+            LOG(ERROR) << "the inputs of operator " << this->input_ops_.at(k)->name
+                       << " are empty or have a different batch, forward fail";
+            return false;
+        }
+        if (!this->input_shape_of(this->input_ops_.at(k), inputs[k], this->input_shape_)) {
+            return false;
+        }
+    }
+    const MemoryPlan *plan = nullptr;
+    if (!this->get_memory_plan(this->input_shape_, plan)) {
+        LOG(ERROR) << "cannot create the memory plan for the input shapes, forward fail";
+        return false;
+    }
+    if (this->profiler_) {
+        this->profiler_->begin_run();
+    }
+
+    for (size_t i = 0; i < this->topo_operators_.size(); i++) {
+        const auto &op = this->topo_operators_.at(i);
+        if (op->type == "pnnx.Input") {
+            auto input_iter = std::find(this->input_ops_.begin(), this->input_ops_.end(), op);
+            CHECK(input_iter != this->input_ops_.end()) << "operator " << op->name << " is not an input operator";
+            op->output_operand->data = inputs[input_iter - this->input_ops_.begin()];
+        } else if (op->type != "pnnx.Output") {
+            CHECK(op->layer != nullptr)
+                << "no layer for operator " << op->name << " of type " << op->type;
+            this->init_outputs(i, *plan);
+
+            Profiler::Clock::time_point start;
+            if (this->profiler_) {
+                start = Profiler::Clock::now();
+            }
+            const InferStatus status = this->forward_layer(op, plan->layer_plans.at(i).get());
+            if (this->profiler_) {
+                this->profiler_->record(op, start, Profiler::Clock::now());
+            }
+            if (status != InferStatus::kInferSuccess) {
+                LOG(ERROR) << "forward of layer " << op->name << " fail, status: " << int(status);
+                return false;
+            }
+        }
+
+        if (!op->output_operand) {
+            continue;
+        }
+
+        /// 后继节点的输入操作数直接共享当前节点对应输出的数据
+        for (const auto &[_, next_op] : op->output_operators) {
+            for (const auto &input_operand : next_op->input_operands_seq) {
+                if (input_operand->name == op->name) {
+                    input_operand->data = op->output_operands.at(input_operand->output_index)->data;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+InferStatus RuntimeGraph::forward_layer(const std::shared_ptr<RuntimeOperator> &op, const LayerPlan *layer_plan)
+{
+    /// 多个输入操作数时按输入顺序依次拼接，与Layer::forward()一致
+    this->layer_inputs_.clear();
+    for (const auto &input_operand : op->input_operands_seq) {
+        this->layer_inputs_.insert(this->layer_inputs_.end(), input_operand->data.begin(), input_operand->data.end());
+    }
+
+    CHECK(op->output_operand != nullptr) << "layer " << op->name << " has no output operand";
+    InferStatus status;
+    if (op->output_operands.size() == 1) {
+        status = op->layer->forward(this->layer_inputs_, op->output_operand->data, layer_plan);
+    } else {
+        this->layer_outputs_.clear();
+        for (const auto &output_operand : op->output_operands) {
+            this->layer_outputs_.push_back(&output_operand->data);
+        }
+        status = op->layer->forward(this->layer_inputs_, this->layer_outputs_);
+    }
+
+    /// 只保留容量，不在两次推理之间持有输入张量
+    this->layer_inputs_.clear();
+    return status;
+}
+
+void RuntimeGraph::init_outputs(size_t index, const MemoryPlan &plan)
+{
+    const auto &op = this->topo_operators_.at(index);
+    const BufferAlias &alias = plan.aliases.at(index);
+    if (alias.target < 0) {
+        for (size_t k = 0; k < op->output_operands.size(); k++) {
+            const auto &output_operand = op->output_operands.at(k);
+            this->init_data(output_operand->data, plan.output_shapes.at(index).at(k), output_operand->layout,
+                            this->tensor_allocator_);
+        }
+        return;
+    }
+
+    /// 拼接节点的输出可能也是更后面拼接节点的一段，先准备好它的缓冲区
+    this->init_outputs(alias.target, plan);
+    const auto &target_op = this->topo_operators_.at(alias.target);
+    init_alias(op->output_operand->data, plan.output_shapes.at(index).front(), target_op->output_operand->data,
+               alias.offset);
+}
+
+const std::vector<std::shared_ptr<RuntimeOperator>> &
+RuntimeGraph::input_operators() const
+{
+    return this->input_ops_;
+}
+
+const std::vector<std::shared_ptr<RuntimeOperator>> &
+RuntimeGraph::output_operators() const
+{
+    return this->output_ops_;
+}
+
+const std::shared_ptr<RuntimeOperand> &
+RuntimeGraph::result_operand(const std::shared_ptr<RuntimeOperator> &output_op)
+{
+    if (output_op->type == "pnnx.Output") {
+        CHECK(!output_op->input_operands_seq.empty())
+            << "output operator " << output_op->name << " has no input operand";
+        return output_op->input_operands_seq.front();
+    }
+
+    CHECK(output_op->output_operand != nullptr)
+        << "output operator " << output_op->name << " has no output operand";
+    return output_op->output_operand;
+}
+
+const std::map<std::vector<int>, MemoryPlan> &
+RuntimeGraph::memory_plans() const
+{
+    return this->memory_plans_;
+}
+
+void RuntimeGraph::set_profiler(std::shared_ptr<Profiler> profiler)
+{
+    this->profiler_ = std::move(profiler);
+}
+
+const std::shared_ptr<Profiler> &RuntimeGraph::profiler() const
+{
+    return this->profiler_;
+}
+
+void RuntimeGraph::set_blocked_layout(bool blocked)
+{
+    if (this->graph_state_ == GraphState::completed) {
+        LOG(WARNING) << "the graph has been built, the layout takes effect after rebuilding";
+    }
+    this->blocked_layout_ = blocked;
+}
+
+void RuntimeGraph::set_tensor_allocator(std::shared_ptr<TensorAllocator> allocator)
+{
+    this->tensor_allocator_ = std::move(allocator);
+}
+
+const std::shared_ptr<TensorAllocator> &RuntimeGraph::tensor_allocator() const
+{
+    return this->tensor_allocator_;
+}
+
+const std::shared_ptr<Arena> &RuntimeGraph::arena() const
+{
+    return this->arena_;
+}
+
+bool RuntimeGraph::blocked_layout() const
+{
+    return this->blocked_layout_;
+}
+
+bool RuntimeGraph::input_shape_of(const std::shared_ptr<RuntimeOperator> &input_op,
+                                  const std::vector<std::shared_ptr<Tensor<float>>> &inputs,
+                                  std::vector<int> &input_shape) const
+{
+    CHECK(input_op->output_operand != nullptr)
+        << "input operator " << input_op->name << " has no output operand";
+    const std::vector<int> &declared_shape = input_op->output_operand->shape;
+
+    const auto &input = inputs.front();
+    if (input == nullptr || input->empty()) {
+        LOG(ERROR) << "the input tensor is empty";
+        return false;
+    }
+
+    const size_t offset = input_shape.size();
+    input_shape.push_back(int(inputs.size()));
+    bool matched = true;
+    switch (declared_shape.size()) {
+    case 4:
+        input_shape.push_back(int(input->channels()));
+        input_shape.push_back(int(input->rows()));
+        input_shape.push_back(int(input->cols()));
+        break;
+    case 3:
+        matched = input->channels() == 1;
+        input_shape.push_back(int(input->rows()));
+        input_shape.push_back(int(input->cols()));
+        break;
+    case 2:
+        matched = input->channels() == 1 && input->rows() == 1;
+        input_shape.push_back(int(input->cols()));
+        break;
+    default:
+        LOG(ERROR) << "unsupported input shape size: " << declared_shape.size();
+        return false;
+    }
+    if (!matched) {
+        LOG(ERROR) << "the input tensor has more dims than the input of " << input_op->name;
+        return false;
+    }
+
+    /// 批次维度总是以实际输入为准，其余维度只有声明为动态(-1)时才能与模型文件不同
+    for (size_t i = 1; i < declared_shape.size(); i++) {
+        if (declared_shape.at(i) >= 0 && declared_shape.at(i) != input_shape.at(offset + i)) {
+            LOG(ERROR) << "input shape mismatch at dim " << i << ", expect: " << declared_shape.at(i)
+                       << ", actual: " << input_shape.at(offset + i);
+            return false;
+        }
+    }
+
+    for (const auto &tensor : inputs) {
+        if (tensor == nullptr || tensor->empty() || tensor->channels() != input->channels()
+            || tensor->rows() != input->rows() || tensor->cols() != input->cols()) {
+            LOG(ERROR) << "the input tensors in one batch have different shapes";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RuntimeGraph::get_memory_plan(const std::vector<int> &input_shape, const MemoryPlan *&plan)
+{
+    auto iter = this->memory_plans_.find(input_shape);
+    if (iter == this->memory_plans_.end()) {
+        /// 推导失败的形状不缓存，下次遇到时重新推导并报告
+        MemoryPlan new_plan;
+        if (!this->create_memory_plan(input_shape, new_plan)) {
+            return false;
+        }
+        iter = this->memory_plans_.insert({input_shape, std::move(new_plan)}).first;
+    }
+    plan = &iter->second;
+    return true;
+}
+
+bool RuntimeGraph::create_memory_plan(const std::vector<int> &input_shape, MemoryPlan &plan) const
+{
+    plan = MemoryPlan();
+    plan.input_shape = input_shape;
+    plan.output_shapes.resize(this->topo_operators_.size());
+    plan.layer_plans.resize(this->topo_operators_.size());
+
+    const int batch = input_shape.front();
+    std::map<std::string, std::vector<std::vector<int>>> shapes;
+    for (size_t i = 0; i < this->topo_operators_.size(); i++) {
+        const auto &op = this->topo_operators_.at(i);
+        if (!op->output_operand) {
+            continue;
+        }
+
+        std::vector<std::vector<int>> output_shapes;
+        if (op->type == "pnnx.Input") {
+            std::vector<int> output_shape;
+            /// 多个输入的形状按输入节点的顺序首尾相接，各自的长度与模型文件中声明的一致
+            size_t offset = 0;
+            for (const auto &input_op : this->input_ops_) {
+                const size_t rank = input_op->output_operand->shape.size();
+                if (input_op == op) {
+                    CHECK_LE(offset + rank, input_shape.size()) << "the input shape is too short";
+                    output_shape.assign(input_shape.begin() + offset, input_shape.begin() + offset + rank);
+                    break;
+                }
+                offset += rank;
+            }
+            CHECK(!output_shape.empty()) << "operator " << op->name << " is not an input operator";
+            output_shapes.push_back(std::move(output_shape));
+        } else {
+            std::vector<std::vector<int>> input_shapes;
+            for (const auto &input_operand : op->input_operands_seq) {
+                auto shape_iter = shapes.find(input_operand->name);
+                if (shape_iter != shapes.end()) {
+                    input_shapes.push_back(shape_iter->second.at(input_operand->output_index));
+                    continue;
+                }
+
+                /// 不在拓扑序列中的前驱节点(例如常量)只能使用模型文件中的形状
+                const std::vector<int> &declared_shape = input_operand->shape;
+                if (!std::all_of(declared_shape.begin(), declared_shape.end(), [](int dim) { return dim > 0; })) {
+                    LOG(ERROR) << "the shape of operand " << input_operand->name << " has not been inferred";
+                    return false;
+                }
+                input_shapes.push_back(declared_shape);
+            }
+            if (!this->infer_output_shapes(op, input_shapes, batch, output_shapes)) {
+                return false;
+            }
+            if (op->layer) {
+                plan.layer_plans.at(i) = op->layer->create_plan(input_shapes, output_shapes);
+            }
+        }
+
+        shapes.insert({op->name, output_shapes});
+        plan.output_shapes.at(i) = std::move(output_shapes);
+    }
+
+    this->plan_aliases(plan);
+    return true;
+}
+
+/// 输出会被替换为输入视图的节点，写入拼接节点的缓冲区反而会使视图失效
+static bool
+produces_view(const std::shared_ptr<RuntimeOperator> &op)
+{
+    return op->type == "Tensor.slice" || op->type == "torch.chunk" || op->type == "torch.split";
+}
+
+void RuntimeGraph::plan_aliases(MemoryPlan &plan) const
+{
+    plan.aliases.assign(this->topo_operators_.size(), BufferAlias());
+
+    std::map<std::string, size_t> topo_indices;
+    for (size_t i = 0; i < this->topo_operators_.size(); i++) {
+        topo_indices.insert({this->topo_operators_.at(i)->name, i});
+    }
+
+    for (size_t i = 0; i < this->topo_operators_.size(); i++) {
+        const auto &op = this->topo_operators_.at(i);
+        auto dim = op->get_param<RuntimeParameterInt>("dim");
+        if (op->type != "torch.cat" || !dim || op->output_operands.size() != 1
+            || op->output_operand->layout != RuntimeDataLayout::kLayoutNCHW) {
+            continue;
+        }
+
+        const std::vector<int> &output_shape = plan.output_shapes.at(i).front();
+        const int rank = int(output_shape.size());
+        const int axis = tensor_axis_of(dim->value, rank);
+        std::array<uint32_t, 3> tensor_shape = {1, 1, 1};
+        if (axis < 0 || !tensor_shape_of(output_shape, RuntimeDataLayout::kLayoutNCHW, tensor_shape)) {
+            continue;
+        }
+
+        /// 拼接维度之外只有批次时，每个输入在输出中占连续的一段
+        const AxisSplit split = split_axis(tensor_shape[0], tensor_shape[1], tensor_shape[2], axis);
+        if (split.outer != 1) {
+            continue;
+        }
+
+        const int logical_dim = dim->value < 0 ? dim->value + rank : dim->value;
+        std::vector<std::pair<size_t, size_t>> candidates;
+        size_t offset = 0;
+        for (const auto &input_operand : op->input_operands_seq) {
+            auto iter = topo_indices.find(input_operand->name);
+            if (iter == topo_indices.end()) {
+                candidates.clear();
+                break;
+            }
+            const std::vector<int> &input_shape = plan.output_shapes.at(iter->second).at(input_operand->output_index);
+            candidates.emplace_back(iter->second, offset);
+            offset += size_t(input_shape.at(logical_dim)) * split.inner;
+        }
+
+        for (const auto &[producer_index, producer_offset] : candidates) {
+            const auto &producer = this->topo_operators_.at(producer_index);
+            BufferAlias &alias = plan.aliases.at(producer_index);
+            /// 输入节点的数据来自调用者；同一个输出被多次拼接或被多个拼接节点使用时只有第一段能直接写入
+            if (producer->type == "pnnx.Input" || producer->type == "pnnx.Output" || produces_view(producer)
+                || producer->output_operands.size() != 1
+                || producer->output_operand->layout != RuntimeDataLayout::kLayoutNCHW || alias.target >= 0) {
+                continue;
+            }
+            alias.target = int(i);
+            alias.offset = producer_offset;
+        }
+    }
+}
+
+bool RuntimeGraph::infer_output_shapes(const std::shared_ptr<RuntimeOperator> &op,
+                                       const std::vector<std::vector<int>> &input_shapes,
+                                       int batch,
+                                       std::vector<std::vector<int>> &output_shapes) const
+{
+    output_shapes.clear();
+    if (ShapeInferRegisterer::has_shape_func(op->type)) {
+        if (!ShapeInferRegisterer::infer_shapes(op, input_shapes, output_shapes)) {
+            LOG(ERROR) << "cannot infer the output shape of operator " << op->name;
+            return false;
+        }
+        return true;
+    }
+
+    for (const auto &output_operand : op->output_operands) {
+        std::vector<int> output_shape = output_operand->shape;
+        if (output_shape.empty()) {
+            LOG(ERROR) << "operator " << op->name << " has no output shape";
+            return false;
+        }
+        output_shape.front() = batch;
+
+        /// 没有形状推导函数的算子，其余的动态维度与第一个输入保持一致
+        for (size_t i = 1; i < output_shape.size(); i++) {
+            if (output_shape.at(i) >= 0) {
+                continue;
+            }
+
+            if (input_shapes.empty() || input_shapes.front().size() != output_shape.size()) {
+                LOG(ERROR) << "cannot infer dynamic dim " << i << " of operator " << op->name;
+                return false;
+            }
+            output_shape.at(i) = input_shapes.front().at(i);
+        }
+        output_shapes.push_back(std::move(output_shape));
+    }
+    return true;
+}
+
+bool RuntimeGraph::infer_shapes()
+{
+    /// 输入的非批次维度是动态的，形状只能在forward时由实际输入推导
+    std::vector<int> input_shape;
+    bool dynamic_batch = false;
+    for (const auto &input_op : this->input_ops_) {
+        CHECK(input_op->output_operand != nullptr)
+            << "input operator " << input_op->name << " has no output operand";
+        const std::vector<int> &declared_shape = input_op->output_operand->shape;
+        for (size_t i = 1; i < declared_shape.size(); i++) {
+            if (declared_shape.at(i) < 0) {
+                LOG(INFO) << "the input of graph has dynamic dims, skip static shape inference";
+                return true;
+            }
+        }
+        dynamic_batch = dynamic_batch || declared_shape.front() < 0;
+        input_shape.insert(input_shape.end(), declared_shape.begin(), declared_shape.end());
+    }
+
+    if (dynamic_batch) {
+        size_t offset = 0;
+        for (const auto &input_op : this->input_ops_) {
+            input_shape.at(offset) = 1;
+            offset += input_op->output_operand->shape.size();
+        }
+    }
+
+    MemoryPlan plan;
+    if (!this->create_memory_plan(input_shape, plan)) {
+        LOG(ERROR) << "cannot infer the shapes of the graph from the shapes in model file";
+        return false;
+    }
+    for (size_t i = 0; i < this->topo_operators_.size(); i++) {
+        const auto &op = this->topo_operators_.at(i);
+        if (!op->output_operand) {
+            continue;
+        }
+
+        for (size_t k = 0; k < op->output_operands.size(); k++) {
+            const auto &output_operand = op->output_operands.at(k);
+            std::vector<int> &declared_shape = output_operand->shape;
+            const std::vector<int> &inferred_shape = plan.output_shapes.at(i).at(k);
+            bool matched = declared_shape.size() == inferred_shape.size();
+            for (size_t j = 1; matched && j < declared_shape.size(); j++) {
+                matched = declared_shape.at(j) < 0 || declared_shape.at(j) == inferred_shape.at(j);
+            }
+
+            if (!matched) {
+                LOG(ERROR) << "the inferred shape of operator " << op->name
+                           << " does not match the shape in model file";
+                return false;
+            }
+
+            /// 用推导结果补全模型文件中的动态维度，批次维度保持不变
+            bool filled = false;
+            for (size_t j = 1; j < declared_shape.size(); j++) {
+                if (declared_shape.at(j) < 0) {
+                    declared_shape.at(j) = inferred_shape.at(j);
+                    filled = true;
+                }
+            }
+
+            if (filled) {
+                this->init_data(output_operand->data, declared_shape, output_operand->layout,
+                                this->tensor_allocator_);
+            }
+
+            for (const auto &[_, next_op] : op->output_operators) {
+                for (const auto &input_operand : next_op->input_operands_seq) {
+                    if (input_operand->name == op->name && input_operand->output_index == k) {
+                        input_operand->shape = declared_shape;
+                    }
+                }
+            }
+        }
+    }
+
+    if (!dynamic_batch) {
+        this->memory_plans_.insert({input_shape, std::move(plan)});
+    }
+    return true;
+}
+
 void RuntimeGraph::check_shape(const std::vector<int> &shape) const
 {
     CHECK(shape.size() >= 2 && shape.size() <= 4)
         << "unsupported tensor shape size: " << shape.size();
 
-    auto batch = shape.at(0);
-    CHECK(batch >= 0)
-        << "dynamic batch size is not supported";
+    /// 模型文件中的?会被解析为-1，表示动态维度，在forward时由实际输入推导
+    for (int dim : shape) {
+        CHECK(dim > 0 || dim == -1)
+            << "invalid tensor dim: " << dim;
+    }
 }
 
-void RuntimeGraph::init_data(std::vector<std::shared_ptr<Tensor<float>>> &data, const std::vector<int> &shape)
+bool RuntimeGraph::tensor_shape_of(const std::vector<int> &shape, RuntimeDataLayout layout,
+                                   std::array<uint32_t, 3> &tensor_shape)
 {
     CHECK(shape.size() >= 2 && shape.size() <= 4)
         << "unsupported shape size: " << shape.size();
 
+    for (int dim : shape) {
+        if (dim < 0) {
+            return false;
+        }
+    }
+
+    /// 张量的(channels, rows, cols)，维度不足时在前面补1
+    tensor_shape = {1, 1, 1};
+    std::copy(shape.begin() + 1, shape.end(), tensor_shape.end() - (shape.size() - 1));
+    if (layout == RuntimeDataLayout::kLayoutNCHW8c) {
+        CHECK_EQ(shape.size(), 4) << "the NCHW8c layout only supports 4-d shape";
+        tensor_shape[0] = channel_blocks(tensor_shape[0]);
+        tensor_shape[1] *= kChannelBlock;
+    }
+    return true;
+}
+
+void RuntimeGraph::init_alias(std::vector<std::shared_ptr<Tensor<float>>> &data, const std::vector<int> &shape,
+                              const std::vector<std::shared_ptr<Tensor<float>>> &target, size_t offset)
+{
+    std::array<uint32_t, 3> tensor_shape = {1, 1, 1};
+    if (!tensor_shape_of(shape, RuntimeDataLayout::kLayoutNCHW, tensor_shape)) {
+        return;
+    }
+
+    const size_t batch = shape[0];
+    CHECK_EQ(target.size(), batch) << "the batch of alias target is different";
+    data.resize(batch);
+
+    const size_t size = size_t(tensor_shape[0]) * tensor_shape[1] * tensor_shape[2];
+    for (size_t i = 0; i < batch; i++) {
+        const auto &target_tensor = target.at(i);
+        CHECK(target_tensor != nullptr && offset + size <= target_tensor->size())
+            << "the alias is out of the target tensor";
+
+        float *alias_data = target_tensor->raw_ptr() + offset;
+        const auto &tensor = data.at(i);
+        if (tensor && tensor->raw_ptr() == alias_data && tensor->channels() == tensor_shape[0]
+            && tensor->rows() == tensor_shape[1] && tensor->cols() == tensor_shape[2]) {
+            continue;
+        }
+        data.at(i) = std::make_shared<ftensor>(alias_data, tensor_shape[0], tensor_shape[1], tensor_shape[2],
+                                               target_tensor);
+    }
+}
+
+void RuntimeGraph::init_data(std::vector<std::shared_ptr<Tensor<float>>> &data, const std::vector<int> &shape,
+                             RuntimeDataLayout layout, const std::shared_ptr<TensorAllocator> &allocator)
+{
+    std::array<uint32_t, 3> tensor_shape = {1, 1, 1};
+    if (!tensor_shape_of(shape, layout, tensor_shape)) {
+        return;
+    }
+
     auto batch = shape[0];
     data.resize(batch);
 
     for (int i = 0; i < batch; i++) {
-        switch (shape.size()) {
-        case 2:
-            data[i] = std::make_shared<ftensor>(shape[1]);
-            break;
-        case 3:
-            data[i] = std::make_shared<ftensor>(shape[1], shape[2]);
-            break;
-        case 4:
-            data[i] = std::make_shared<ftensor>(shape[1], shape[2], shape[3]);
-            break;
+        const auto &tensor = data[i];
+        if (tensor && !tensor->empty() && tensor->channels() == tensor_shape[0]
+            && tensor->rows() == tensor_shape[1] && tensor->cols() == tensor_shape[2]) {
+            continue;
         }
+
+        data[i] = std::make_shared<ftensor>(tensor_shape[0], tensor_shape[1], tensor_shape[2], allocator);
     }
 }
 
@@ -0,0 +1,298 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "layer/abstract/activation.hpp"
+#include "layer/details/batchnorm.hpp"
+#include "layer/details/layout_transform.hpp"
+#include "status_code.hpp"
+#include <algorithm>
+#include <cmath>
+#include <runtime/runtime_ir.hpp>
+
+namespace jinfer
+{
+
+/**
+ * 把BatchNorm的缩放和平移折叠进前一个卷积或线性层的权重和偏置，W' = W * scale，b' = b * scale + shift
+ */
+static ParseParameterAttrStatus
+fold_batchnorm(const std::shared_ptr<RuntimeOperator> &op, const std::shared_ptr<RuntimeOperator> &bn_op)
+{
+    std::vector<float> scale;
+    std::vector<float> shift;
+    const ParseParameterAttrStatus status = BatchNormLayer::scale_shift(bn_op, scale, shift, false);
+    if (status != ParseParameterAttrStatus::kParameterAttrParseSuccess) {
+        return status;
+    }
+
+    auto weight = op->attrs.find("weight");
+    if (weight == op->attrs.end() || weight->second->weight_data.empty()) {
+        return ParseParameterAttrStatus::kAttrMissingWeight;
+    }
+
+    auto use_bias = op->get_param<RuntimeParameterBool>("bias");
+    if (!use_bias) {
+        return ParseParameterAttrStatus::kParameterMissingUseBias;
+    }
+
+    const uint32_t channels = scale.size();
+    std::vector<float> weights = weight->second->get<float>(false);
+    if (weights.size() % channels != 0 || weight->second->shape.empty()
+        || weight->second->shape.front() != int(channels)) {
+        return ParseParameterAttrStatus::kAttrMissingWeight;
+    }
+
+    std::vector<float> bias(channels, 0.f);
+    auto bias_attr = op->attrs.find("bias");
+    if (use_bias->value) {
+        if (bias_attr == op->attrs.end() || bias_attr->second->weight_data.empty()) {
+            return ParseParameterAttrStatus::kAttrMissingBias;
+        }
+        bias = bias_attr->second->get<float>(false);
+        if (bias.size() != channels) {
+            return ParseParameterAttrStatus::kAttrMissingBias;
+        }
+    }
+
+    /// 行主序的权重中，每个输出通道占连续的row_len个元素
+    const size_t row_len = weights.size() / channels;
+    for (uint32_t c = 0; c < channels; c++) {
+        float *row = weights.data() + c * row_len;
+        for (size_t k = 0; k < row_len; k++) {
+            row[k] *= scale.at(c);
+        }
+        bias.at(c) = bias.at(c) * scale.at(c) + shift.at(c);
+    }
+
+    weight->second->set(weights, weight->second->shape);
+    if (bias_attr == op->attrs.end()) {
+        bias_attr = op->attrs.insert({"bias", std::make_shared<RuntimeAttribute>()}).first;
+    }
+    bias_attr->second->set(bias, {int(channels)});
+    use_bias->value = true;
+    return ParseParameterAttrStatus::kParameterAttrParseSuccess;
+}
+
+void RuntimeGraph::fuse_operators()
+{
+    std::vector<std::shared_ptr<RuntimeOperator>> operators = this->operators_;
+    for (const auto &op : operators) {
+        if (op->type != "nn.BatchNorm2d" && op->type != "nn.BatchNorm1d") {
+            continue;
+        }
+
+        if (op->input_operands_seq.size() != 1) {
+            continue;
+        }
+
+        auto prev_iter = this->operators_map_.find(op->input_operands_seq.front()->name);
+        if (prev_iter == this->operators_map_.end()) {
+            continue;
+        }
+
+        const std::shared_ptr<RuntimeOperator> prev_op = prev_iter->second;
+        /// BatchNorm1d只有在(N, C)输入上才是对线性层输出特征的逐通道变换
+        const bool foldable = (op->type == "nn.BatchNorm2d" && prev_op->type == "nn.Conv2d")
+                              || (op->type == "nn.BatchNorm1d" && prev_op->type == "nn.Linear"
+                                  && prev_op->output_operand && prev_op->output_operand->shape.size() == 2);
+        /// 子图以外的节点没有读取权重；输出节点的结果会被返回，也不能融合；不能折叠的BatchNorm由BatchNormLayer计算
+        if (!foldable || prev_op->output_operators.size() != 1 || prev_op->params.count("activation")
+            || !this->is_internal(op) || !this->is_internal(prev_op)) {
+            continue;
+        }
+
+        const ParseParameterAttrStatus status = fold_batchnorm(prev_op, op);
+        if (status != ParseParameterAttrStatus::kParameterAttrParseSuccess) {
+            LOG(WARNING) << "cannot fold batchnorm " << op->name << " into " << prev_op->name
+                         << ", status: " << int(status) << ", compute it as a separate layer";
+            continue;
+        }
+
+        LOG(INFO) << "fold batchnorm " << op->name << " into " << prev_op->name;
+        this->remove_operator(op);
+    }
+
+    operators = this->operators_;
+    for (const auto &op : operators) {
+        if ((op->type != "nn.Linear" && op->type != "nn.Conv2d") || op->output_operators.size() != 1
+            || op->params.count("activation")) {
+            continue;
+        }
+
+        const std::shared_ptr<RuntimeOperator> next_op = op->output_operators.begin()->second;
+        if (activation_type_of(next_op->type) == ActivationType::kActivationNone
+            || next_op->input_operands_seq.size() != 1 || !this->is_internal(op) || !this->is_internal(next_op)) {
+            continue;
+        }
+
+        auto activation = this->arena_make_shared<RuntimeParameterString>();
+        activation->value = next_op->type;
+        op->params.insert({"activation", activation});
+
+        LOG(INFO) << "fuse activation " << next_op->name << " into " << op->name;
+        this->remove_operator(next_op);
+    }
+}
+
+void RuntimeGraph::remove_operator(const std::shared_ptr<RuntimeOperator> &removed_op)
+{
+    /// 参数可能引用自前驱节点的output_operators，删除前先持有一份
+    const std::shared_ptr<RuntimeOperator> op = removed_op;
+    CHECK(op->input_operands_seq.size() == 1)
+        << "only the operator with one input can be removed: " << op->name;
+    const std::string prev_name = op->input_operands_seq.front()->name;
+    auto prev_iter = this->operators_map_.find(prev_name);
+    CHECK(prev_iter != this->operators_map_.end()) << "cannot find operator: " << prev_name;
+    const std::shared_ptr<RuntimeOperator> prev_op = prev_iter->second;
+
+    for (const auto &[next_name, next_op] : op->output_operators) {
+        CHECK(next_op->input_operands.count(prev_name) == 0)
+            << "operator " << next_name << " consumes both " << prev_name << " and " << op->name;
+    }
+
+    prev_op->output_operators.erase(op->name);
+    auto &prev_output_names = prev_op->output_names;
+    prev_output_names.erase(std::remove(prev_output_names.begin(), prev_output_names.end(), op->name),
+                            prev_output_names.end());
+
+    /// 后继节点的输入操作数改为以前驱节点命名
+    for (const auto &[next_name, next_op] : op->output_operators) {
+        prev_op->output_operators.insert({next_name, next_op});
+        prev_output_names.push_back(next_name);
+
+        auto operand = next_op->input_operands.extract(op->name);
+        CHECK(!operand.empty()) << "operator " << next_name << " has no input operand from " << op->name;
+        operand.key() = prev_name;
+        operand.mapped()->name = prev_name;
+        next_op->input_operands.insert(std::move(operand));
+    }
+
+    this->operators_.erase(std::remove(this->operators_.begin(), this->operators_.end(), op),
+                           this->operators_.end());
+    this->operators_map_.erase(op->name);
+}
+
+static bool
+is_blocked(const std::shared_ptr<RuntimeOperator> &op)
+{
+    return op->output_operand && op->output_operand->layout == RuntimeDataLayout::kLayoutNCHW8c;
+}
+
+/// 可以沿用前驱NCHW8c布局的单输入节点，它们的计算与通道的排列无关
+static bool
+is_layout_agnostic(const std::string &type)
+{
+    return type == "nn.MaxPool2d" || type == "nn.AvgPool2d" || type == "nn.ReLU"
+           || type == "nn.Sigmoid" || type == "F.sigmoid";
+}
+
+bool RuntimeGraph::propagate_layout()
+{
+    for (const auto &op : this->topo_operators_) {
+        if (!op->output_operand || op->output_operand->shape.size() != 4 || op->input_operands_seq.size() != 1) {
+            continue;
+        }
+
+        /// 布局转换节点只能接在单输出节点之后，多输出节点的后继保持NCHW布局
+        auto prev_iter = this->operators_map_.find(op->input_operands_seq.front()->name);
+        if (prev_iter == this->operators_map_.end() || prev_iter->second->output_operands.size() != 1) {
+            continue;
+        }
+
+        bool blocked = false;
+        if (op->type == "nn.Conv2d") {
+            auto groups = op->get_param<RuntimeParameterInt>("groups");
+            blocked = groups && groups->value == 1;
+        } else if (is_layout_agnostic(op->type)) {
+            blocked = is_blocked(prev_iter->second);
+        }
+        /// 作为输出的节点保持NCHW布局，结果不需要再转换
+        if (!blocked || !this->is_internal(op)) {
+            continue;
+        }
+
+        auto layout = this->arena_make_shared<RuntimeParameterString>();
+        layout->value = kBlockedLayoutName;
+        op->params.insert_or_assign("layout", layout);
+        op->output_operand->layout = RuntimeDataLayout::kLayoutNCHW8c;
+    }
+
+    /// 标记为NCHW8c的节点按NCHW8c读取输入，其余节点都需要NCHW布局的输入
+    bool changed = false;
+    const std::vector<std::shared_ptr<RuntimeOperator>> topo_operators = this->topo_operators_;
+    for (const auto &op : topo_operators) {
+        if (!op->output_operand || op->output_operands.size() != 1) {
+            continue;
+        }
+
+        std::vector<std::shared_ptr<RuntimeOperator>> mismatched_ops;
+        for (const auto &[_, next_op] : op->output_operators) {
+            if (!this->subgraph_.count(next_op.get())) {
+                continue;
+            }
+            if (is_blocked(next_op) != is_blocked(op)) {
+                mismatched_ops.push_back(next_op);
+            } else {
+                next_op->input_operands.at(op->name)->layout = op->output_operand->layout;
+            }
+        }
+
+        if (!mismatched_ops.empty()) {
+            this->insert_layout_transform(op, mismatched_ops, !is_blocked(op));
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void RuntimeGraph::insert_layout_transform(const std::shared_ptr<RuntimeOperator> &op,
+                                           const std::vector<std::shared_ptr<RuntimeOperator>> &next_ops,
+                                           bool to_blocked)
+{
+    const RuntimeDataLayout layout = to_blocked ? RuntimeDataLayout::kLayoutNCHW8c : RuntimeDataLayout::kLayoutNCHW;
+    const std::string name = op->name + (to_blocked ? ".to_nchw8c" : ".to_nchw");
+    CHECK(this->operators_map_.count(name) == 0) << "the layout transform operator exists: " << name;
+
+    std::shared_ptr<RuntimeOperator> transform_op = this->create_op(name);
+    transform_op->name = name;
+    transform_op->type = to_blocked ? "jinfer.ToBlocked" : "jinfer.ToPlanar";
+
+    auto input_operand = this->arena_make_shared<RuntimeOperand>();
+    input_operand->name = op->name;
+    input_operand->type = op->output_operand->type;
+    input_operand->shape = op->output_operand->shape;
+    input_operand->layout = op->output_operand->layout;
+    transform_op->input_operands.insert({op->name, input_operand});
+    transform_op->input_operands_seq.push_back(input_operand);
+
+    transform_op->output_operand = this->arena_make_shared<RuntimeOperand>();
+    transform_op->output_operand->name = name;
+    transform_op->output_operand->type = op->output_operand->type;
+    transform_op->output_operand->shape = op->output_operand->shape;
+    transform_op->output_operand->layout = layout;
+    transform_op->output_operands.push_back(transform_op->output_operand);
+
+    /// 与remove_operator相反，后继节点的输入操作数改为以转换节点命名
+    auto &output_names = op->output_names;
+    for (const auto &next_op : next_ops) {
+        op->output_operators.erase(next_op->name);
+        output_names.erase(std::remove(output_names.begin(), output_names.end(), next_op->name), output_names.end());
+
+        transform_op->output_operators.insert({next_op->name, next_op});
+        transform_op->output_names.push_back(next_op->name);
+
+        auto operand = next_op->input_operands.extract(op->name);
+        CHECK(!operand.empty()) << "operator " << next_op->name << " has no input operand from " << op->name;
+        operand.key() = name;
+        operand.mapped()->name = name;
+        operand.mapped()->layout = layout;
+        next_op->input_operands.insert(std::move(operand));
+    }
+
+    op->output_operators.insert({name, transform_op});
+    output_names.push_back(name);
+    LOG(INFO) << "insert layout transform " << name;
+}
+
+}// namespace jinfer
@@ -0,0 +1,115 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/session.hpp"
+#include "layer/abstract/layer.hpp"
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+Session::Session(std::shared_ptr<const CompiledModel> model) : model_(std::move(model))
+{
+    CHECK(this->model_ != nullptr) << "the model of session is null";
+    this->activations_.resize(this->model_->activation_count());
+}
+
+const std::vector<std::shared_ptr<Tensor<float>>> &
+Session::forward(const std::vector<std::shared_ptr<Tensor<float>>> &inputs)
+{
+    if (!this->set_inputs(inputs) || !this->forward_operators(0, this->model_->operators().size())) {
+        static const std::vector<std::shared_ptr<Tensor<float>>> empty_outputs;
+        return empty_outputs;
+    }
+    return this->outputs();
+}
+
+bool Session::set_inputs(const std::vector<std::shared_ptr<Tensor<float>>> &inputs)
+{
+    if (!this->model_->input_shape_of(inputs, this->input_shape_)) {
+        this->plan_ = nullptr;
+        return false;
+    }
+    if (this->plan_ == nullptr || this->plan_->input_shape != this->input_shape_) {
+        this->plan_ = this->model_->memory_plan(this->input_shape_);
+        if (this->plan_ == nullptr) {
+            return false;
+        }
+    }
+    this->activations_.front() = inputs;
+    return true;
+}
+
+bool Session::forward_operators(size_t begin, size_t end)
+{
+    CHECK(this->plan_ != nullptr) << "the inputs of session are not set";
+    CHECK(begin <= end && end <= this->model_->operators().size())
+        << "invalid operator range [" << begin << ", " << end << ")";
+
+    const auto &operators = this->model_->operators();
+    for (size_t i = begin; i < end; i++) {
+        const CompiledOperator &compiled_op = operators.at(i);
+        const auto &op = compiled_op.op;
+        if (op->type == "pnnx.Input" || op->type == "pnnx.Output") {
+            continue;
+        }
+
+        /// 多个输入操作数时按输入顺序依次拼接，与Layer::forward()一致
+        this->layer_inputs_.clear();
+        for (size_t input_index : compiled_op.input_indices) {
+            const auto &input = this->activations_.at(input_index);
+            this->layer_inputs_.insert(this->layer_inputs_.end(), input.begin(), input.end());
+        }
+
+        this->init_outputs(i);
+        InferStatus status;
+        if (compiled_op.output_indices.size() == 1) {
+            status = op->layer->forward(this->layer_inputs_, this->activations_.at(i),
+                                        this->plan_->layer_plans.at(i).get());
+        } else {
+            this->layer_outputs_.clear();
+            for (size_t output_index : compiled_op.output_indices) {
+                this->layer_outputs_.push_back(&this->activations_.at(output_index));
+            }
+            status = op->layer->forward(this->layer_inputs_, this->layer_outputs_);
+        }
+        if (status != InferStatus::kInferSuccess) {
+            LOG(ERROR) << "forward of layer " << op->name << " fail, status: " << int(status);
+            return false;
+        }
+    }
+    return true;
+}
+
+void Session::init_outputs(size_t index)
+{
+    const CompiledOperator &compiled_op = this->model_->operators().at(index);
+    const auto &op = compiled_op.op;
+    const BufferAlias &alias = this->plan_->aliases.at(index);
+    if (alias.target < 0) {
+        for (size_t k = 0; k < compiled_op.output_indices.size(); k++) {
+            RuntimeGraph::init_data(this->activations_.at(compiled_op.output_indices.at(k)),
+                                    this->plan_->output_shapes.at(index).at(k), op->output_operands.at(k)->layout,
+                                    this->model_->tensor_allocator());
+        }
+        return;
+    }
+
+    this->init_outputs(alias.target);
+    RuntimeGraph::init_alias(this->activations_.at(index), this->plan_->output_shapes.at(index).front(),
+                             this->activations_.at(alias.target), alias.offset);
+}
+
+const std::vector<std::shared_ptr<Tensor<float>>> &
+Session::outputs() const
+{
+    return this->activations_.at(this->model_->output_index());
+}
+
+const std::shared_ptr<const CompiledModel> &
+Session::model() const
+{
+    return this->model_;
+}
+
+}// namespace jinfer
@@ -0,0 +1,587 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#include "runtime/shape_infer.hpp"
+#include "layer/abstract/reduction.hpp"
+#include "layer/details/slice.hpp"
+#include "layer/details/split.hpp"
+#include "layer/details/upsample.hpp"
+#include <glog/logging.h>
+
+namespace jinfer
+{
+
+ShapeInferRegisterer::ShapeRegistry &
+ShapeInferRegisterer::registry()
+{
+    static ShapeRegistry *registry = new ShapeRegistry();
+    return *registry;
+}
+
+ShapeInferRegisterer::MultiShapeRegistry &
+ShapeInferRegisterer::multi_registry()
+{
+    static MultiShapeRegistry *registry = new MultiShapeRegistry();
+    return *registry;
+}
+
+void ShapeInferRegisterer::register_shape_func(const std::string &op_type, const ShapeFunc &func)
+{
+    CHECK(func != nullptr) << "shape function of " << op_type << " is empty";
+    ShapeRegistry &registry = ShapeInferRegisterer::registry();
+    CHECK_EQ(registry.count(op_type), 0)
+        << "shape function of " << op_type << " has been registered";
+    registry.insert({op_type, func});
+}
+
+void ShapeInferRegisterer::register_multi_shape_func(const std::string &op_type, const MultiShapeFunc &func)
+{
+    CHECK(func != nullptr) << "shape function of " << op_type << " is empty";
+    CHECK_EQ(ShapeInferRegisterer::registry().count(op_type), 0)
+        << "shape function of " << op_type << " has been registered";
+    MultiShapeRegistry &registry = ShapeInferRegisterer::multi_registry();
+    CHECK_EQ(registry.count(op_type), 0)
+        << "shape function of " << op_type << " has been registered";
+    registry.insert({op_type, func});
+}
+
+bool ShapeInferRegisterer::has_shape_func(const std::string &op_type)
+{
+    return ShapeInferRegisterer::registry().count(op_type) > 0
+           || ShapeInferRegisterer::multi_registry().count(op_type) > 0;
+}
+
+bool ShapeInferRegisterer::infer_shape(const std::shared_ptr<RuntimeOperator> &op,
+                                       const std::vector<std::vector<int>> &input_shapes,
+                                       std::vector<int> &output_shape)
+{
+    CHECK(op != nullptr);
+    ShapeRegistry &registry = ShapeInferRegisterer::registry();
+    auto iter = registry.find(op->type);
+    if (iter == registry.end()) {
+        return false;
+    }
+
+    output_shape.clear();
+    if (!iter->second(op, input_shapes, output_shape)) {
+        LOG(ERROR) << "infer shape of operator " << op->name << " of type " << op->type << " fail";
+        return false;
+    }
+    return true;
+}
+
+bool ShapeInferRegisterer::infer_shapes(const std::shared_ptr<RuntimeOperator> &op,
+                                        const std::vector<std::vector<int>> &input_shapes,
+                                        std::vector<std::vector<int>> &output_shapes)
+{
+    CHECK(op != nullptr);
+    MultiShapeRegistry &registry = ShapeInferRegisterer::multi_registry();
+    auto iter = registry.find(op->type);
+    if (iter == registry.end()) {
+        output_shapes.resize(1);
+        return ShapeInferRegisterer::infer_shape(op, input_shapes, output_shapes.front());
+    }
+
+    output_shapes.clear();
+    if (!iter->second(op, input_shapes, output_shapes) || output_shapes.size() != op->output_operands.size()) {
+        LOG(ERROR) << "infer shape of operator " << op->name << " of type " << op->type << " fail";
+        return false;
+    }
+    return true;
+}
+
+static bool
+get_int(const std::shared_ptr<RuntimeOperator> &op, const std::string &name, int &value)
+{
+    auto param = op->get_param<RuntimeParameterInt>(name);
+    if (!param) {
+        return false;
+    }
+    value = param->value;
+    return true;
+}
+
+static bool
+get_pair(const std::shared_ptr<RuntimeOperator> &op, const std::string &name, int &h, int &w)
+{
+    auto param = op->get_param<RuntimeParameterIntArray>(name);
+    if (!param || param->value.empty() || param->value.size() > 2) {
+        return false;
+    }
+    h = param->value.front();
+    w = param->value.back();
+    return true;
+}
+
+int window_output_size(int in, int kernel, int stride, int padding, int dilation, bool ceil_mode)
+{
+    const int span = in + 2 * padding - dilation * (kernel - 1) - 1;
+    if (span < 0 || stride <= 0) {
+        return -1;
+    }
+
+    int out = (ceil_mode ? (span + stride - 1) / stride : span / stride) + 1;
+    /// 与pytorch保持一致，最后一个窗口必须从输入或左侧填充区域开始
+    if (ceil_mode && (out - 1) * stride >= in + padding) {
+        out -= 1;
+    }
+    return out;
+}
+
+int transposed_window_output_size(int in, int kernel, int stride, int padding, int dilation, int output_padding)
+{
+    /// 与pytorch一致，output_padding必须小于stride或dilation
+    if (in <= 0 || kernel <= 0 || stride <= 0 || dilation <= 0 || padding < 0 || output_padding < 0
+        || (output_padding >= stride && output_padding >= dilation)) {
+        return -1;
+    }
+    const int out = (in - 1) * stride - 2 * padding + dilation * (kernel - 1) + output_padding + 1;
+    return out > 0 ? out : -1;
+}
+
+static bool
+same_as_input(const std::shared_ptr<RuntimeOperator> &op,
+              const std::vector<std::vector<int>> &input_shapes,
+              std::vector<int> &output_shape)
+{
+    if (input_shapes.size() != 1) {
+        return false;
+    }
+    output_shape = input_shapes.front();
+    return true;
+}
+
+static bool
+conv2d_shape(const std::shared_ptr<RuntimeOperator> &op,
+             const std::vector<std::vector<int>> &input_shapes,
+             std::vector<int> &output_shape)
+{
+    if (input_shapes.size() != 1 || input_shapes.front().size() != 4) {
+        return false;
+    }
+    const std::vector<int> &input_shape = input_shapes.front();
+
+    int in_channels = 0, out_channels = 0;
+    int kernel_h = 0, kernel_w = 0;
+    int stride_h = 1, stride_w = 1;
+    int dilation_h = 1, dilation_w = 1;
+    if (!get_int(op, "in_channels", in_channels) || !get_int(op, "out_channels", out_channels)
+        || !get_pair(op, "kernel_size", kernel_h, kernel_w)) {
+        return false;
+    }
+    get_pair(op, "stride", stride_h, stride_w);
+    get_pair(op, "dilation", dilation_h, dilation_w);
+
+    if (input_shape.at(1) != in_channels) {
+        LOG(ERROR) << "conv2d " << op->name << " expects " << in_channels
+                   << " input channels, but got " << input_shape.at(1);
+        return false;
+    }
+
+    int out_h = 0, out_w = 0;
+    auto padding_mode = op->get_param<RuntimeParameterString>("padding");
+    if (padding_mode && padding_mode->value == "same") {
+        out_h = input_shape.at(2);
+        out_w = input_shape.at(3);
+    } else {
+        int padding_h = 0, padding_w = 0;
+        get_pair(op, "padding", padding_h, padding_w);
+        out_h = window_output_size(input_shape.at(2), kernel_h, stride_h, padding_h, dilation_h, false);
+        out_w = window_output_size(input_shape.at(3), kernel_w, stride_w, padding_w, dilation_w, false);
+    }
+
+    if (out_h <= 0 || out_w <= 0) {
+        return false;
+    }
+    output_shape = {input_shape.at(0), out_channels, out_h, out_w};
+    return true;
+}
+
+static bool
+deconv2d_shape(const std::shared_ptr<RuntimeOperator> &op,
+               const std::vector<std::vector<int>> &input_shapes,
+               std::vector<int> &output_shape)
+{
+    if (input_shapes.size() != 1 || input_shapes.front().size() != 4) {
+        return false;
+    }
+    const std::vector<int> &input_shape = input_shapes.front();
+
+    int in_channels = 0, out_channels = 0;
+    int kernel_h = 0, kernel_w = 0;
+    int stride_h = 1, stride_w = 1;
+    int padding_h = 0, padding_w = 0;
+    int dilation_h = 1, dilation_w = 1;
+    int output_padding_h = 0, output_padding_w = 0;
+    if (!get_int(op, "in_channels", in_channels) || !get_int(op, "out_channels", out_channels)
+        || !get_pair(op, "kernel_size", kernel_h, kernel_w)) {
+        return false;
+    }
+    get_pair(op, "stride", stride_h, stride_w);
+    get_pair(op, "padding", padding_h, padding_w);
+    get_pair(op, "dilation", dilation_h, dilation_w);
+    get_pair(op, "output_padding", output_padding_h, output_padding_w);
+
+    if (input_shape.at(1) != in_channels) {
+        LOG(ERROR) << "conv_transpose2d " << op->name << " expects " << in_channels
+                   << " input channels, but got " << input_shape.at(1);
+        return false;
+    }
+
+    const int out_h = transposed_window_output_size(input_shape.at(2), kernel_h, stride_h, padding_h, dilation_h,
+                                                    output_padding_h);
+    const int out_w = transposed_window_output_size(input_shape.at(3), kernel_w, stride_w, padding_w, dilation_w,
+                                                    output_padding_w);
+    if (out_h <= 0 || out_w <= 0) {
+        return false;
+    }
+    output_shape = {input_shape.at(0), out_channels, out_h, out_w};
+    return true;
+}
+
+static bool
+pool2d_shape(const std::shared_ptr<RuntimeOperator> &op,
+             const std::vector<std::vector<int>> &input_shapes,
+             std::vector<int> &output_shape)
+{
+    if (input_shapes.size() != 1 || input_shapes.front().size() != 4) {
+        return false;
+    }
+    const std::vector<int> &input_shape = input_shapes.front();
+
+    int kernel_h = 0, kernel_w = 0;
+    if (!get_pair(op, "kernel_size", kernel_h, kernel_w)) {
+        return false;
+    }
+
+    /// pytorch中stride缺省时与kernel_size相同
+    int stride_h = kernel_h, stride_w = kernel_w;
+    int padding_h = 0, padding_w = 0;
+    int dilation_h = 1, dilation_w = 1;
+    get_pair(op, "stride", stride_h, stride_w);
+    get_pair(op, "padding", padding_h, padding_w);
+    get_pair(op, "dilation", dilation_h, dilation_w);
+
+    auto ceil_mode = op->get_param<RuntimeParameterBool>("ceil_mode");
+    const bool ceil = ceil_mode && ceil_mode->value;
+
+    const int out_h = window_output_size(input_shape.at(2), kernel_h, stride_h, padding_h, dilation_h, ceil);
+    const int out_w = window_output_size(input_shape.at(3), kernel_w, stride_w, padding_w, dilation_w, ceil);
+    if (out_h <= 0 || out_w <= 0) {
+        return false;
+    }
+    output_shape = {input_shape.at(0), input_shape.at(1), out_h, out_w};
+    return true;
+}
+
+static bool
+adaptive_pool2d_shape(const std::shared_ptr<RuntimeOperator> &op,
+                      const std::vector<std::vector<int>> &input_shapes,
+                      std::vector<int> &output_shape)
+{
+    if (input_shapes.size() != 1 || input_shapes.front().size() != 4) {
+        return false;
+    }
+    const std::vector<int> &input_shape = input_shapes.front();
+
+    int out_h = 0, out_w = 0;
+    if (!get_pair(op, "output_size", out_h, out_w)) {
+        return false;
+    }
+
+    /// output_size中的None表示保持输入大小
+    out_h = out_h > 0 ? out_h : input_shape.at(2);
+    out_w = out_w > 0 ? out_w : input_shape.at(3);
+    output_shape = {input_shape.at(0), input_shape.at(1), out_h, out_w};
+    return true;
+}
+
+static bool
+linear_shape(const std::shared_ptr<RuntimeOperator> &op,
+             const std::vector<std::vector<int>> &input_shapes,
+             std::vector<int> &output_shape)
+{
+    if (input_shapes.size() != 1 || input_shapes.front().size() < 2) {
+        return false;
+    }
+
+    int in_features = 0, out_features = 0;
+    if (!get_int(op, "in_features", in_features) || !get_int(op, "out_features", out_features)) {
+        return false;
+    }
+
+    output_shape = input_shapes.front();
+    if (output_shape.back() != in_features) {
+        LOG(ERROR) << "linear " << op->name << " expects " << in_features
+                   << " input features, but got " << output_shape.back();
+        return false;
+    }
+    output_shape.back() = out_features;
+    return true;
+}
+
+static bool
+flatten_shape(const std::shared_ptr<RuntimeOperator> &op,
+              const std::vector<std::vector<int>> &input_shapes,
+              std::vector<int> &output_shape)
+{
+    if (input_shapes.size() != 1) {
+        return false;
+    }
+    const std::vector<int> &input_shape = input_shapes.front();
+    const int dims = int(input_shape.size());
+
+    int start_dim = 0, end_dim = -1;
+    get_int(op, "start_dim", start_dim);
+    get_int(op, "end_dim", end_dim);
+    start_dim = start_dim < 0 ? start_dim + dims : start_dim;
+    end_dim = end_dim < 0 ? end_dim + dims : end_dim;
+    if (start_dim < 0 || end_dim >= dims || start_dim > end_dim) {
+        return false;
+    }
+
+    output_shape.assign(input_shape.begin(), input_shape.begin() + start_dim);
+    int flatten_size = 1;
+    for (int i = start_dim; i <= end_dim; i++) {
+        flatten_size *= input_shape.at(i);
+    }
+    output_shape.push_back(flatten_size);
+    output_shape.insert(output_shape.end(), input_shape.begin() + end_dim + 1, input_shape.end());
+    return true;
+}
+
+/// 表达式由逐元素运算组成，输出形状为各输入按广播规则对齐后的形状
+static bool
+expression_shape(const std::shared_ptr<RuntimeOperator> &op,
+                 const std::vector<std::vector<int>> &input_shapes,
+                 std::vector<int> &output_shape)
+{
+    if (input_shapes.empty()) {
+        return false;
+    }
+
+    output_shape = input_shapes.front();
+    for (size_t i = 1; i < input_shapes.size(); i++) {
+        const std::vector<int> &shape = input_shapes.at(i);
+        if (shape.size() > output_shape.size()) {
+            output_shape.insert(output_shape.begin(), shape.size() - output_shape.size(), 1);
+        }
+
+        const size_t offset = output_shape.size() - shape.size();
+        for (size_t j = 0; j < shape.size(); j++) {
+            int &dim = output_shape.at(offset + j);
+            if (dim == shape.at(j) || shape.at(j) == 1) {
+                continue;
+            }
+            if (dim != 1) {
+                LOG(ERROR) << "expression " << op->name << " cannot broadcast dim " << j;
+                return false;
+            }
+            dim = shape.at(j);
+        }
+    }
+    return true;
+}
+
+/// 批次维度不能被归约，不保留维度时至少要留下一个非批次维度
+static bool
+reduce_shape(const std::shared_ptr<RuntimeOperator> &op,
+             const std::vector<std::vector<int>> &input_shapes,
+             std::vector<int> &output_shape)
+{
+    if (input_shapes.size() != 1) {
+        return false;
+    }
+    const std::vector<int> &input_shape = input_shapes.front();
+    const int rank = int(input_shape.size());
+
+    std::vector<int> dims;
+    if (!get_int_list(op, "dim", dims)) {
+        return false;
+    }
+
+    std::vector<bool> reduced(rank, false);
+    for (int dim : dims) {
+        if (tensor_axis_of(dim, rank) < 0) {
+            LOG(ERROR) << "reduce " << op->name << " does not support dim " << dim;
+            return false;
+        }
+        reduced.at(dim < 0 ? dim + rank : dim) = true;
+    }
+
+    auto keepdim = op->get_param<RuntimeParameterBool>("keepdim");
+    const bool keep = keepdim && keepdim->value;
+    for (int i = 0; i < rank; i++) {
+        if (!reduced.at(i)) {
+            output_shape.push_back(input_shape.at(i));
+        } else if (keep) {
+            output_shape.push_back(1);
+        }
+    }
+
+    if (output_shape.size() < 2) {
+        LOG(ERROR) << "reduce " << op->name << " can not reduce all dims except batch without keepdim";
+        return false;
+    }
+    return true;
+}
+
+/// 被切分的维度按各段的长度变化，其余维度与输入相同
+static bool
+split_shape(const std::shared_ptr<RuntimeOperator> &op,
+            const std::vector<std::vector<int>> &input_shapes,
+            std::vector<std::vector<int>> &output_shapes)
+{
+    SplitSections sections;
+    int dim = 0;
+    if (input_shapes.size() != 1 || !SplitSections::parse(op, sections) || !get_int(op, "dim", dim)) {
+        return false;
+    }
+
+    const std::vector<int> &input_shape = input_shapes.front();
+    const int rank = int(input_shape.size());
+    dim = dim < 0 ? dim + rank : dim;
+    if (dim <= 0 || dim >= rank) {
+        return false;
+    }
+
+    const int length = input_shape.at(dim);
+    if (!sections.valid(length) || sections.count(length) != int(op->output_operands.size())) {
+        LOG(ERROR) << "operator " << op->name << " can not split length " << length << " into "
+                   << op->output_operands.size() << " outputs";
+        return false;
+    }
+
+    for (int i = 0; i < sections.count(length); i++) {
+        int offset = 0;
+        std::vector<int> output_shape = input_shape;
+        sections.piece(i, length, offset, output_shape.at(dim));
+        output_shapes.push_back(std::move(output_shape));
+    }
+    return true;
+}
+
+/// 拼接的维度上长度相加，其余维度必须相同
+static bool
+cat_shape(const std::shared_ptr<RuntimeOperator> &op,
+          const std::vector<std::vector<int>> &input_shapes,
+          std::vector<int> &output_shape)
+{
+    int dim = 0;
+    if (input_shapes.empty() || !get_int(op, "dim", dim)) {
+        return false;
+    }
+
+    output_shape = input_shapes.front();
+    const int rank = int(output_shape.size());
+    dim = dim < 0 ? dim + rank : dim;
+    if (dim <= 0 || dim >= rank) {
+        return false;
+    }
+
+    for (size_t i = 1; i < input_shapes.size(); i++) {
+        const std::vector<int> &shape = input_shapes.at(i);
+        if (int(shape.size()) != rank) {
+            LOG(ERROR) << "cat " << op->name << " has inputs of different ranks";
+            return false;
+        }
+        for (int j = 0; j < rank; j++) {
+            if (j != dim && shape.at(j) != output_shape.at(j)) {
+                LOG(ERROR) << "cat " << op->name << " has inputs of different shapes in dim " << j;
+                return false;
+            }
+        }
+        int &length = output_shape.at(dim);
+        length = length < 0 || shape.at(dim) < 0 ? -1 : length + shape.at(dim);
+    }
+    return true;
+}
+
+/// 被切的维度按切片规则变化，动态维度保持动态
+static bool
+slice_shape(const std::shared_ptr<RuntimeOperator> &op,
+            const std::vector<std::vector<int>> &input_shapes,
+            std::vector<int> &output_shape)
+{
+    std::vector<int> dims;
+    std::vector<SliceRange> ranges;
+    if (input_shapes.size() != 1 || !SliceRange::parse(op, dims, ranges)) {
+        return false;
+    }
+
+    output_shape = input_shapes.front();
+    const int rank = int(output_shape.size());
+    for (size_t i = 0; i < dims.size(); i++) {
+        const int dim = dims.at(i) < 0 ? dims.at(i) + rank : dims.at(i);
+        if (dim <= 0 || dim >= rank) {
+            return false;
+        }
+
+        int &length = output_shape.at(dim);
+        int offset = 0;
+        if (length >= 0 && !ranges.at(i).resolve(length, offset, length)) {
+            LOG(ERROR) << "slice " << op->name << " slices nothing from dim " << dim;
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool
+resize_shape(const std::shared_ptr<RuntimeOperator> &op,
+             const std::vector<std::vector<int>> &input_shapes,
+             std::vector<int> &output_shape)
+{
+    ResizeParam param;
+    if (input_shapes.size() != 1 || input_shapes.front().size() != 4
+        || ResizeParam::parse(op, param) != ParseParameterAttrStatus::kParameterAttrParseSuccess) {
+        return false;
+    }
+
+    const std::vector<int> &input_shape = input_shapes.front();
+    int out_h = 0, out_w = 0;
+    if (!param.output_size(input_shape.at(2), input_shape.at(3), out_h, out_w)) {
+        return false;
+    }
+    output_shape = {input_shape.at(0), input_shape.at(1), out_h, out_w};
+    return true;
+}
+
+ShapeInferRegistererWrapper relu_shape_func("nn.ReLU", same_as_input);
+ShapeInferRegistererWrapper relu_func_shape_func("F.relu", same_as_input);
+ShapeInferRegistererWrapper relu6_shape_func("nn.ReLU6", same_as_input);
+ShapeInferRegistererWrapper relu6_func_shape_func("F.relu6", same_as_input);
+ShapeInferRegistererWrapper sigmoid_shape_func("nn.Sigmoid", same_as_input);
+ShapeInferRegistererWrapper sigmoid_func_shape_func("F.sigmoid", same_as_input);
+ShapeInferRegistererWrapper silu_shape_func("nn.SiLU", same_as_input);
+ShapeInferRegistererWrapper batchnorm1d_shape_func("nn.BatchNorm1d", same_as_input);
+ShapeInferRegistererWrapper batchnorm2d_shape_func("nn.BatchNorm2d", same_as_input);
+ShapeInferRegistererWrapper conv2d_shape_func("nn.Conv2d", conv2d_shape);
+ShapeInferRegistererWrapper deconv2d_shape_func("nn.ConvTranspose2d", deconv2d_shape);
+ShapeInferRegistererWrapper maxpool2d_shape_func("nn.MaxPool2d", pool2d_shape);
+ShapeInferRegistererWrapper avgpool2d_shape_func("nn.AvgPool2d", pool2d_shape);
+ShapeInferRegistererWrapper adaptive_avgpool2d_shape_func("nn.AdaptiveAvgPool2d", adaptive_pool2d_shape);
+ShapeInferRegistererWrapper linear_shape_func("nn.Linear", linear_shape);
+ShapeInferRegistererWrapper flatten_shape_func("torch.flatten", flatten_shape);
+ShapeInferRegistererWrapper expression_shape_func("pnnx.Expression", expression_shape);
+ShapeInferRegistererWrapper softmax_shape_func("nn.Softmax", same_as_input);
+ShapeInferRegistererWrapper softmax_func_shape_func("F.softmax", same_as_input);
+ShapeInferRegistererWrapper layer_norm_shape_func("nn.LayerNorm", same_as_input);
+ShapeInferRegistererWrapper sum_shape_func("torch.sum", reduce_shape);
+ShapeInferRegistererWrapper mean_shape_func("torch.mean", reduce_shape);
+ShapeInferRegistererWrapper amax_shape_func("torch.amax", reduce_shape);
+ShapeInferRegistererWrapper amin_shape_func("torch.amin", reduce_shape);
+ShapeInferRegistererWrapper to_blocked_shape_func("jinfer.ToBlocked", same_as_input);
+ShapeInferRegistererWrapper to_planar_shape_func("jinfer.ToPlanar", same_as_input);
+ShapeInferRegistererWrapper cat_shape_func("torch.cat", cat_shape);
+ShapeInferRegistererWrapper slice_shape_func("Tensor.slice", slice_shape);
+ShapeInferRegistererWrapper upsample_shape_func("nn.Upsample", resize_shape);
+ShapeInferRegistererWrapper upsample_nearest_shape_func("nn.UpsamplingNearest2d", resize_shape);
+ShapeInferRegistererWrapper upsample_bilinear_shape_func("nn.UpsamplingBilinear2d", resize_shape);
+ShapeInferRegistererWrapper interpolate_shape_func("F.interpolate", resize_shape);
+ShapeInferRegistererWrapper upsample_func_shape_func("F.upsample", resize_shape);
+MultiShapeInferRegistererWrapper chunk_shape_func("torch.chunk", split_shape);
+MultiShapeInferRegistererWrapper split_shape_func("torch.split", split_shape);
+
+}// namespace jinfer
@@ -0,0 +1,174 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "data/allocator.hpp"
+#include "data/tensor.hpp"
+#include "runtime/arena.hpp"
+#include <cstdint>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <new>
+
+using namespace jinfer;
+
+TEST(test_allocator, block_size)
+{
+    ASSERT_EQ(PoolAllocator::block_size_of(1), PoolAllocator::kMinBlockSize);
+    ASSERT_EQ(PoolAllocator::block_size_of(64), 64);
+    ASSERT_EQ(PoolAllocator::block_size_of(65), 72);
+    ASSERT_EQ(PoolAllocator::block_size_of(1000), 1024);
+    for (size_t size = 1; size < 100000; size += 37) {
+        const size_t block_size = PoolAllocator::block_size_of(size);
+        ASSERT_GE(block_size, size);
+        ASSERT_LE(block_size, std::max(size + size / 4, PoolAllocator::kMinBlockSize));
+    }
+}
+
+TEST(test_allocator, pool_reuse)
+{
+    PoolAllocator allocator;
+    float *first = allocator.allocate(1000);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(first) % PoolAllocator::kAlignment, 0);
+    ASSERT_EQ(allocator.reserved_size(), 1024);
+
+    allocator.deallocate(first, 1000);
+    ASSERT_EQ(allocator.cached_size(), 1024);
+
+    /// 同一级别的大小复用空闲缓冲区
+    float *second = allocator.allocate(1010);
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(allocator.cached_size(), 0);
+    ASSERT_EQ(allocator.reserved_size(), 1024);
+
+    float *third = allocator.allocate(1000);
+    ASSERT_NE(third, second);
+    ASSERT_EQ(allocator.reserved_size(), 2048);
+
+    allocator.deallocate(second, 1010);
+    allocator.deallocate(third, 1000);
+    allocator.release();
+    ASSERT_EQ(allocator.cached_size(), 0);
+    ASSERT_EQ(allocator.reserved_size(), 0);
+}
+
+TEST(test_allocator, external_tensor)
+{
+    std::vector<float> buffer(2 * 3 * 4, 0.f);
+    Tensor<float> tensor(buffer.data(), 2, 3, 4);
+    ASSERT_EQ(tensor.raw_ptr(), buffer.data());
+    ASSERT_EQ(tensor.raw_shapes(), std::vector<uint32_t>({2, 3, 4}));
+
+    tensor.fill(2.f);
+    for (float value : buffer) {
+        ASSERT_EQ(value, 2.f);
+    }
+
+    /// 形状改变后张量持有自己的内存，外部内存保持不变
+    tensor.padding({1, 1, 1, 1}, 0.f);
+    ASSERT_NE(tensor.raw_ptr(), buffer.data());
+    ASSERT_EQ(tensor.rows(), 5);
+    ASSERT_EQ(tensor.cols(), 6);
+    ASSERT_EQ(tensor.at(1, 1, 1), 2.f);
+    ASSERT_EQ(tensor.at(1, 0, 0), 0.f);
+}
+
+TEST(test_allocator, pooled_tensor)
+{
+    auto allocator = std::make_shared<PoolAllocator>();
+    float *ptr = nullptr;
+    {
+        Tensor<float> tensor(3, 16, 16, allocator);
+        ptr = tensor.raw_ptr();
+        ASSERT_EQ(tensor.size(), 3 * 16 * 16);
+        ASSERT_EQ(allocator->cached_size(), 0);
+
+        /// 移动后仍使用同一块内存
+        Tensor<float> moved(std::move(tensor));
+        ASSERT_EQ(moved.raw_ptr(), ptr);
+        moved.fill(1.f);
+        ASSERT_EQ(allocator->cached_size(), 0);
+    }
+    ASSERT_EQ(allocator->cached_size(), PoolAllocator::block_size_of(3 * 16 * 16));
+
+    /// 释放后同样大小的张量复用缓冲区
+    auto tensor = std::make_shared<ftensor>(3, 16, 16, allocator);
+    ASSERT_EQ(tensor->raw_ptr(), ptr);
+    ASSERT_EQ(allocator->cached_size(), 0);
+
+    /// padding后缓冲区立刻归还
+    tensor->fill(1.f);
+    tensor->padding({1, 1, 1, 1}, 0.f);
+    ASSERT_NE(tensor->raw_ptr(), ptr);
+    ASSERT_EQ(tensor->at(2, 16, 16), 1.f);
+    ASSERT_EQ(allocator->cached_size(), PoolAllocator::block_size_of(3 * 16 * 16));
+}
+
+TEST(test_allocator, null_allocator)
+{
+    Tensor<float> tensor(2, 3, 4, std::shared_ptr<TensorAllocator>());
+    ASSERT_EQ(tensor.size(), 2 * 3 * 4);
+    tensor.fill(1.f);
+    ASSERT_EQ(tensor.at(1, 2, 3), 1.f);
+}
+
+TEST(test_allocator, arena)
+{
+    auto arena = std::make_shared<Arena>(256);
+    std::weak_ptr<Arena> weak_arena = arena;
+
+    std::vector<std::shared_ptr<std::vector<int>>> objects;
+    for (int i = 0; i < 100; i++) {
+        auto object = std::allocate_shared<std::vector<int>>(ArenaAllocator<std::vector<int>>(arena), 3, i);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(object.get()) % alignof(std::vector<int>), 0);
+        objects.push_back(std::move(object));
+    }
+    ASSERT_GE(arena->reserved_bytes(), arena->used_bytes());
+    ASSERT_GE(arena->used_bytes(), 100 * sizeof(std::vector<int>));
+
+    /// 超过块大小的对象单独申请
+    void *large = arena->allocate(1024, 64);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(large) % 64, 0);
+
+    /// 对象仍存在时区域不会释放
+    arena.reset();
+    ASSERT_FALSE(weak_arena.expired());
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(objects.at(i)->at(2), i);
+    }
+    objects.clear();
+    ASSERT_TRUE(weak_arena.expired());
+}
+
+TEST(test_allocator, trim_cached_blocks)
+{
+    PoolAllocator allocator(2048);
+    ASSERT_EQ(allocator.max_cached_size(), 2048);
+    float *small = allocator.allocate(512);
+    float *middle = allocator.allocate(1024);
+    float *large = allocator.allocate(2048);
+    ASSERT_EQ(allocator.reserved_size(), 3584);
+
+    allocator.deallocate(small, 512);
+    allocator.deallocate(middle, 1024);
+    ASSERT_EQ(allocator.cached_size(), 1536);
+
+    /// 超过上限后先归还最大的缓冲区
+    allocator.deallocate(large, 2048);
+    ASSERT_EQ(allocator.cached_size(), 1536);
+    ASSERT_EQ(allocator.reserved_size(), 1536);
+    ASSERT_EQ(allocator.allocate(1000), middle);
+    ASSERT_EQ(allocator.allocate(500), small);
+    allocator.deallocate(middle, 1024);
+    allocator.deallocate(small, 512);
+    allocator.release();
+    ASSERT_EQ(allocator.reserved_size(), 0);
+}
+
+TEST(test_allocator, allocate_fail)
+{
+    PoolAllocator allocator;
+    /// 申请失败时抛出异常，不计入已申请的大小
+    ASSERT_THROW(allocator.allocate(size_t(1) << 50), std::bad_alloc);
+    ASSERT_EQ(allocator.reserved_size(), 0);
+    ASSERT_EQ(allocator.cached_size(), 0);
+}
@@ -0,0 +1,105 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/concat.hpp"
+#include <array>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+using namespace jinfer;
+
+static sftensor
+RandTensor(uint32_t channels, uint32_t rows, uint32_t cols)
+{
+    auto tensor = std::make_shared<ftensor>(channels, rows, cols);
+    tensor->rand();
+    return tensor;
+}
+
+/// 两个批次的输入沿axis维拼接，逐元素与对应输入比较
+static void
+CheckConcat(int axis, const std::vector<std::array<uint32_t, 3>> &input_shapes)
+{
+    const uint32_t batch_size = 2;
+    std::vector<sftensor> inputs;
+    std::array<uint32_t, 3> output_shape = input_shapes.front();
+    output_shape[axis] = 0;
+    for (const auto &shape : input_shapes) {
+        output_shape[axis] += shape[axis];
+        for (uint32_t b = 0; b < batch_size; b++) {
+            inputs.push_back(RandTensor(shape[0], shape[1], shape[2]));
+        }
+    }
+
+    std::vector<sftensor> outputs;
+    for (uint32_t b = 0; b < batch_size; b++) {
+        outputs.push_back(std::make_shared<ftensor>(output_shape[0], output_shape[1], output_shape[2]));
+    }
+    ConcatLayer layer(axis);
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    for (uint32_t b = 0; b < batch_size; b++) {
+        uint32_t offset = 0;
+        for (size_t j = 0; j < input_shapes.size(); j++) {
+            const sftensor &input = inputs.at(j * batch_size + b);
+            uint32_t index[3];
+            for (index[0] = 0; index[0] < input->channels(); index[0]++) {
+                for (index[1] = 0; index[1] < input->rows(); index[1]++) {
+                    for (index[2] = 0; index[2] < input->cols(); index[2]++) {
+                        uint32_t output_index[3] = {index[0], index[1], index[2]};
+                        output_index[axis] += offset;
+                        ASSERT_EQ(outputs.at(b)->at(output_index[0], output_index[1], output_index[2]),
+                                  input->at(index[0], index[1], index[2]));
+                    }
+                }
+            }
+            offset += input_shapes.at(j)[axis];
+        }
+    }
+}
+
+TEST(test_concat, channels)
+{
+    CheckConcat(0, {{2, 3, 4}, {1, 3, 4}, {3, 3, 4}});
+}
+
+TEST(test_concat, rows)
+{
+    CheckConcat(1, {{2, 3, 4}, {2, 5, 4}});
+}
+
+TEST(test_concat, cols)
+{
+    CheckConcat(2, {{3, 2, 1}, {3, 2, 4}});
+}
+
+/// 输入已经是输出中对应的一段时不复制，结果不变
+TEST(test_concat, inputs_in_place)
+{
+    auto output = std::make_shared<ftensor>(5, 3, 4);
+    auto first = std::make_shared<ftensor>(output->raw_ptr(), 2, 3, 4, output);
+    auto second = std::make_shared<ftensor>(output->raw_ptr() + 2 * 3 * 4, 3, 3, 4, output);
+    first->rand();
+    second->rand();
+    const float first_value = first->at(1, 2, 3);
+    const float second_value = second->at(2, 0, 1);
+
+    ConcatLayer layer(0);
+    std::vector<sftensor> inputs = {first, second};
+    std::vector<sftensor> outputs = {output};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    ASSERT_EQ(output->at(1, 2, 3), first_value);
+    ASSERT_EQ(output->at(4, 0, 1), second_value);
+}
+
+TEST(test_concat, shape_mismatch)
+{
+    ConcatLayer layer(0);
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(4, 3, 4)};
+
+    std::vector<sftensor> inputs = {RandTensor(2, 3, 4), RandTensor(2, 3, 5)};
+    ASSERT_NE(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    inputs = {RandTensor(2, 3, 4), RandTensor(1, 3, 4)};
+    ASSERT_NE(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+}
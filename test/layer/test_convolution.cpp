@@ -0,0 +1,200 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/convolution.hpp"
+#include "runtime/ir.h"
+#include "runtime/runtime_ir.hpp"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+
+using namespace jinfer;
+
+struct ConvParam {
+    uint32_t in_channels;
+    uint32_t out_channels;
+    uint32_t kernel;
+    uint32_t stride;
+    uint32_t padding;
+    uint32_t dilation;
+    uint32_t groups;
+};
+
+/// 朴素实现，weights按(out_channels, in_channels / groups, kernel, kernel)行主序存放
+static float
+NaiveConv(const sftensor &input, const std::vector<float> &weights, const std::vector<float> &bias,
+          const ConvParam &p, uint32_t o, int oh, int ow)
+{
+    const uint32_t in_per_group = p.in_channels / p.groups;
+    const uint32_t g = o / (p.out_channels / p.groups);
+    float sum = bias.empty() ? 0.f : bias.at(o);
+    for (uint32_t ic = 0; ic < in_per_group; ic++) {
+        for (uint32_t kh = 0; kh < p.kernel; kh++) {
+            for (uint32_t kw = 0; kw < p.kernel; kw++) {
+                const int ih = oh * int(p.stride) - int(p.padding) + int(kh * p.dilation);
+                const int iw = ow * int(p.stride) - int(p.padding) + int(kw * p.dilation);
+                if (ih < 0 || iw < 0 || ih >= int(input->rows()) || iw >= int(input->cols())) {
+                    continue;
+                }
+                const float w = weights.at(((o * in_per_group + ic) * p.kernel + kh) * p.kernel + kw);
+                sum += w * input->at(g * in_per_group + ic, ih, iw);
+            }
+        }
+    }
+    return sum;
+}
+
+static void
+CheckConv(const ConvParam &p, uint32_t rows, uint32_t cols, uint32_t batch = 2,
+          ActivationType activation = ActivationType::kActivationNone)
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    std::vector<float> weights(p.out_channels * (p.in_channels / p.groups) * p.kernel * p.kernel);
+    std::vector<float> bias(p.out_channels);
+    for (auto &w : weights) w = dist(gen);
+    for (auto &b : bias) b = dist(gen);
+
+    ConvolutionLayer layer(p.in_channels, p.out_channels, p.kernel, p.kernel, p.stride, p.stride,
+                           p.padding, p.padding, p.dilation, p.dilation, p.groups, true);
+    layer.set_weights(weights);
+    layer.set_bias(bias);
+    layer.set_activation(activation);
+
+    const uint32_t output_rows = (rows + 2 * p.padding - p.dilation * (p.kernel - 1) - 1) / p.stride + 1;
+    const uint32_t output_cols = (cols + 2 * p.padding - p.dilation * (p.kernel - 1) - 1) / p.stride + 1;
+    std::vector<sftensor> inputs;
+    std::vector<sftensor> outputs;
+    for (uint32_t i = 0; i < batch; i++) {
+        inputs.push_back(std::make_shared<ftensor>(p.in_channels, rows, cols));
+        inputs.back()->rand();
+        outputs.push_back(std::make_shared<ftensor>(p.out_channels, output_rows, output_cols));
+    }
+
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    for (uint32_t i = 0; i < batch; i++) {
+        for (uint32_t o = 0; o < p.out_channels; o++) {
+            for (uint32_t oh = 0; oh < output_rows; oh++) {
+                for (uint32_t ow = 0; ow < output_cols; ow++) {
+                    const float expect =
+                        apply_activation(activation, NaiveConv(inputs.at(i), weights, bias, p, o, int(oh), int(ow)));
+                    ASSERT_NEAR(outputs.at(i)->at(o, oh, ow), expect, 1e-4f);
+                }
+            }
+        }
+    }
+}
+
+TEST(test_convolution, conv3x3_padding)
+{
+    CheckConv({3, 8, 3, 1, 1, 1, 1}, 16, 16);
+}
+
+TEST(test_convolution, conv7x7_stride2)
+{
+    CheckConv({3, 4, 7, 2, 3, 1, 1}, 23, 19);
+}
+
+TEST(test_convolution, conv3x3_stride2_dilation)
+{
+    CheckConv({4, 6, 3, 2, 2, 2, 1}, 13, 11);
+}
+
+TEST(test_convolution, conv_groups)
+{
+    CheckConv({8, 4, 3, 1, 1, 1, 2}, 9, 9);
+    CheckConv({6, 6, 3, 1, 1, 1, 6}, 9, 9);
+}
+
+TEST(test_convolution, conv_depthwise)
+{
+    CheckConv({16, 16, 3, 1, 1, 1, 16}, 14, 11);
+    CheckConv({16, 16, 3, 2, 1, 1, 16}, 15, 12);
+    CheckConv({8, 8, 5, 1, 2, 1, 8}, 9, 10);
+    CheckConv({8, 8, 5, 2, 2, 1, 8}, 9, 10);
+    CheckConv({6, 6, 3, 1, 2, 2, 6}, 8, 7);
+    CheckConv({4, 4, 7, 1, 3, 1, 4}, 6, 9);
+}
+
+/// 每个输入通道对应多个输出通道
+TEST(test_convolution, conv_depthwise_multiplier)
+{
+    CheckConv({4, 8, 3, 1, 1, 1, 4}, 9, 9);
+    CheckConv({3, 9, 3, 2, 0, 1, 3}, 9, 8);
+}
+
+TEST(test_convolution, conv_activation)
+{
+    CheckConv({16, 16, 3, 1, 1, 1, 16}, 12, 12, 2, ActivationType::kActivationRelu6);
+    CheckConv({8, 8, 5, 2, 2, 1, 8}, 11, 9, 1, ActivationType::kActivationSigmoid);
+    CheckConv({3, 8, 3, 1, 1, 1, 1}, 10, 10, 1, ActivationType::kActivationRelu);
+}
+
+TEST(test_convolution, conv_pointwise)
+{
+    CheckConv({16, 8, 1, 1, 0, 1, 1}, 7, 5);
+    CheckConv({16, 8, 1, 2, 0, 1, 1}, 7, 5);
+}
+
+TEST(test_convolution, conv_padding_larger_than_input)
+{
+    CheckConv({2, 3, 3, 1, 2, 1, 1}, 2, 3);
+}
+
+TEST(test_convolution, graph_forward)
+{
+    std::string bin_path("model_file/simple_ops2.pnnx.bin");
+    std::string param_path("model_file/simple_ops2.pnnx.param");
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    std::vector<sftensor> inputs;
+    for (int i = 0; i < 2; i++) {
+        inputs.push_back(std::make_shared<ftensor>(3, 16, 16));
+        inputs.back()->rand();
+    }
+    const auto outputs = graph.forward(inputs);
+    ASSERT_EQ(outputs.size(), 2);
+
+    // 逐层用朴素实现复现，权重直接从模型文件读取
+    pnnx::Graph pnnx_graph;
+    ASSERT_EQ(pnnx_graph.load(param_path, bin_path), 0);
+    std::vector<sftensor> expects = inputs;
+    for (const auto *op : pnnx_graph.ops) {
+        if (op->type != "nn.Conv2d") {
+            continue;
+        }
+        const auto &weight_data = op->attrs.at("weight").data;
+        const auto &bias_data = op->attrs.at("bias").data;
+        std::vector<float> weights(weight_data.size() / sizeof(float));
+        std::vector<float> bias(bias_data.size() / sizeof(float));
+        std::memcpy(weights.data(), weight_data.data(), weight_data.size());
+        std::memcpy(bias.data(), bias_data.data(), bias_data.size());
+
+        const ConvParam p{uint32_t(op->params.at("in_channels").i), uint32_t(op->params.at("out_channels").i),
+                          3, 1, 1, 1, 1};
+        std::vector<sftensor> next;
+        for (const auto &input : expects) {
+            auto output = std::make_shared<ftensor>(p.out_channels, 16, 16);
+            for (uint32_t o = 0; o < p.out_channels; o++) {
+                for (uint32_t oh = 0; oh < 16; oh++) {
+                    for (uint32_t ow = 0; ow < 16; ow++) {
+                        output->raw_ptr()[o * 256 + ow * 16 + oh] =
+                            NaiveConv(input, weights, bias, p, o, int(oh), int(ow));
+                    }
+                }
+            }
+            next.push_back(output);
+        }
+        expects = next;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(outputs.at(i)->size(), expects.at(i)->size());
+        for (uint32_t j = 0; j < outputs.at(i)->size(); j++) {
+            ASSERT_NEAR(outputs.at(i)->raw_ptr()[j], expects.at(i)->raw_ptr()[j], 1e-3f);
+        }
+    }
+}
@@ -0,0 +1,155 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/deconvolution.hpp"
+#include "runtime/shape_infer.hpp"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace jinfer;
+
+struct DeconvParam {
+    uint32_t in_channels;
+    uint32_t out_channels;
+    uint32_t kernel;
+    uint32_t stride;
+    uint32_t padding;
+    uint32_t output_padding;
+    uint32_t dilation;
+    uint32_t groups;
+};
+
+/// 朴素实现，把每个输入元素乘以卷积核后散布到输出上，weights按(in_channels, out_channels / groups, kernel, kernel)行主序存放
+static sftensor
+NaiveDeconv(const sftensor &input, const std::vector<float> &weights, const std::vector<float> &bias,
+            const DeconvParam &p, uint32_t output_rows, uint32_t output_cols)
+{
+    const uint32_t in_per_group = p.in_channels / p.groups;
+    const uint32_t out_per_group = p.out_channels / p.groups;
+    const uint32_t output_size = output_rows * output_cols;
+    auto output = std::make_shared<ftensor>(p.out_channels, output_rows, output_cols);
+    for (uint32_t o = 0; o < p.out_channels; o++) {
+        for (uint32_t j = 0; j < output_size; j++) {
+            output->raw_ptr()[o * output_size + j] = bias.empty() ? 0.f : bias.at(o);
+        }
+    }
+
+    for (uint32_t ic = 0; ic < p.in_channels; ic++) {
+        const uint32_t g = ic / in_per_group;
+        for (uint32_t ih = 0; ih < input->rows(); ih++) {
+            for (uint32_t iw = 0; iw < input->cols(); iw++) {
+                for (uint32_t oc = 0; oc < out_per_group; oc++) {
+                    for (uint32_t kh = 0; kh < p.kernel; kh++) {
+                        for (uint32_t kw = 0; kw < p.kernel; kw++) {
+                            const int oh = int(ih * p.stride + kh * p.dilation) - int(p.padding);
+                            const int ow = int(iw * p.stride + kw * p.dilation) - int(p.padding);
+                            if (oh < 0 || ow < 0 || oh >= int(output_rows) || ow >= int(output_cols)) {
+                                continue;
+                            }
+                            const float w = weights.at(((ic * out_per_group + oc) * p.kernel + kh) * p.kernel + kw);
+                            output->raw_ptr()[(g * out_per_group + oc) * output_size + ow * output_rows + oh] +=
+                                w * input->at(ic, ih, iw);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return output;
+}
+
+static void
+CheckDeconv(const DeconvParam &p, uint32_t rows, uint32_t cols, uint32_t batch = 2, bool use_bias = true)
+{
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    std::vector<float> weights(p.in_channels * (p.out_channels / p.groups) * p.kernel * p.kernel);
+    std::vector<float> bias(use_bias ? p.out_channels : 0);
+    for (auto &w : weights) w = dist(gen);
+    for (auto &b : bias) b = dist(gen);
+
+    DeconvolutionLayer layer(p.in_channels, p.out_channels, p.kernel, p.kernel, p.stride, p.stride,
+                             p.padding, p.padding, p.output_padding, p.output_padding,
+                             p.dilation, p.dilation, p.groups, use_bias);
+    layer.set_weights(weights);
+    layer.set_bias(bias);
+
+    const int output_rows = transposed_window_output_size(int(rows), int(p.kernel), int(p.stride), int(p.padding),
+                                                          int(p.dilation), int(p.output_padding));
+    const int output_cols = transposed_window_output_size(int(cols), int(p.kernel), int(p.stride), int(p.padding),
+                                                          int(p.dilation), int(p.output_padding));
+    ASSERT_GT(output_rows, 0);
+    ASSERT_GT(output_cols, 0);
+
+    std::vector<sftensor> inputs;
+    std::vector<sftensor> outputs;
+    for (uint32_t i = 0; i < batch; i++) {
+        inputs.push_back(std::make_shared<ftensor>(p.in_channels, rows, cols));
+        inputs.back()->rand();
+        outputs.push_back(std::make_shared<ftensor>(p.out_channels, output_rows, output_cols));
+    }
+
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    for (uint32_t i = 0; i < batch; i++) {
+        const sftensor expect = NaiveDeconv(inputs.at(i), weights, bias, p, output_rows, output_cols);
+        for (uint32_t j = 0; j < expect->size(); j++) {
+            ASSERT_NEAR(outputs.at(i)->raw_ptr()[j], expect->raw_ptr()[j], 1e-4f);
+        }
+    }
+}
+
+TEST(test_deconvolution, output_size)
+{
+    ASSERT_EQ(transposed_window_output_size(8, 4, 2, 1, 1, 0), 16);
+    ASSERT_EQ(transposed_window_output_size(8, 3, 2, 1, 1, 1), 16);
+    ASSERT_EQ(transposed_window_output_size(5, 3, 1, 0, 2, 0), 9);
+    ASSERT_EQ(transposed_window_output_size(1, 1, 1, 1, 1, 0), -1);
+    ASSERT_EQ(transposed_window_output_size(8, 3, 2, 1, 1, 2), -1);
+}
+
+TEST(test_deconvolution, deconv4x4_stride2)
+{
+    CheckDeconv({8, 4, 4, 2, 1, 0, 1, 1}, 7, 9);
+}
+
+TEST(test_deconvolution, deconv3x3_stride1)
+{
+    CheckDeconv({3, 5, 3, 1, 1, 0, 1, 1}, 10, 8);
+    CheckDeconv({3, 5, 3, 1, 0, 0, 1, 1}, 6, 7, 1, false);
+}
+
+TEST(test_deconvolution, deconv_output_padding)
+{
+    CheckDeconv({4, 6, 3, 2, 1, 1, 1, 1}, 6, 5);
+    CheckDeconv({2, 3, 2, 3, 0, 2, 1, 1}, 5, 4);
+}
+
+TEST(test_deconvolution, deconv_dilation)
+{
+    CheckDeconv({4, 3, 3, 1, 2, 0, 2, 1}, 7, 6);
+    CheckDeconv({4, 3, 3, 2, 1, 1, 2, 1}, 5, 6);
+}
+
+TEST(test_deconvolution, deconv_groups)
+{
+    CheckDeconv({8, 4, 3, 2, 1, 1, 1, 2}, 6, 6);
+    CheckDeconv({6, 6, 4, 2, 1, 0, 1, 6}, 5, 7);
+}
+
+/// padding较大时，边缘的输入行只对部分kh有贡献
+TEST(test_deconvolution, deconv_large_padding)
+{
+    CheckDeconv({2, 3, 3, 1, 2, 0, 1, 1}, 5, 6);
+}
+
+TEST(test_deconvolution, output_shape_mismatch)
+{
+    DeconvolutionLayer layer(2, 3, 4, 4, 2, 2, 1, 1);
+    layer.set_weights(std::vector<float>(2 * 3 * 4 * 4, 1.f));
+    layer.set_bias(std::vector<float>(3, 0.f));
+
+    std::vector<sftensor> inputs = {std::make_shared<ftensor>(2, 4, 4)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(3, 7, 8)};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferFailedOutputSizeError);
+}
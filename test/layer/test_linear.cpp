@@ -0,0 +1,126 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/linear.hpp"
+#include "runtime/ir.h"
+#include "runtime/runtime_ir.hpp"
+#include "test_util.hpp"
+#include <cmath>
+#include <cstring>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+using namespace jinfer;
+
+/// 朴素实现，input为一行in_features个元素，相邻元素间隔stride
+static float
+NaiveLinear(const float *input, uint32_t stride, const std::vector<float> &weights,
+            const std::vector<float> &bias, uint32_t in_features, uint32_t o)
+{
+    float sum = bias.at(o);
+    for (uint32_t k = 0; k < in_features; k++) {
+        sum += input[k * stride] * weights.at(o * in_features + k);
+    }
+    return sum;
+}
+
+static void
+CheckLinear(uint32_t batch, uint32_t rows, uint32_t in_features, uint32_t out_features,
+            ActivationType activation = ActivationType::kActivationNone)
+{
+    const std::vector<float> weights = RandValues(in_features * out_features, 1);
+    const std::vector<float> bias = RandValues(out_features, 2);
+    LinearLayer layer(in_features, out_features, true);
+    layer.set_weights(weights);
+    layer.set_bias(bias);
+    layer.set_activation(activation);
+
+    std::vector<sftensor> inputs;
+    std::vector<sftensor> outputs;
+    for (uint32_t i = 0; i < batch; i++) {
+        inputs.push_back(std::make_shared<ftensor>(1, rows, in_features));
+        inputs.back()->rand();
+        outputs.push_back(std::make_shared<ftensor>(1, rows, out_features));
+    }
+
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    for (uint32_t i = 0; i < batch; i++) {
+        for (uint32_t r = 0; r < rows; r++) {
+            for (uint32_t o = 0; o < out_features; o++) {
+                const float value = NaiveLinear(inputs.at(i)->raw_ptr() + r, rows, weights, bias, in_features, o);
+                ASSERT_NEAR(outputs.at(i)->at(0, r, o), apply_activation(activation, value), 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(test_linear, gemv)
+{
+    CheckLinear(1, 1, 512, 1000);
+    CheckLinear(1, 1, 7, 3);
+}
+
+TEST(test_linear, gemm)
+{
+    CheckLinear(6, 1, 512, 1000);
+    CheckLinear(3, 1, 33, 17);
+}
+
+TEST(test_linear, matrix_input)
+{
+    CheckLinear(2, 5, 32, 20);
+}
+
+TEST(test_linear, fused_activation)
+{
+    CheckLinear(1, 1, 64, 40, ActivationType::kActivationRelu);
+    CheckLinear(5, 1, 64, 40, ActivationType::kActivationSigmoid);
+}
+
+TEST(test_linear, graph_fuse_sigmoid)
+{
+    std::string bin_path("model_file/test_linear.pnnx.bin");
+    std::string param_path("model_file/test_linear.pnnx.param");
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    // F.sigmoid被融合进线性层
+    const auto &topo_seq = graph.get_topo_seq();
+    ASSERT_EQ(topo_seq.size(), 3);
+    for (const auto &op : topo_seq) {
+        ASSERT_NE(op->type, "F.sigmoid");
+    }
+
+    pnnx::Graph pnnx_graph;
+    ASSERT_EQ(pnnx_graph.load(param_path, bin_path), 0);
+    const pnnx::Operator *linear_op = nullptr;
+    for (const auto *op : pnnx_graph.ops) {
+        if (op->type == "nn.Linear") {
+            linear_op = op;
+        }
+    }
+    ASSERT_NE(linear_op, nullptr);
+    std::vector<float> weights(32 * 128);
+    std::vector<float> bias(128);
+    std::memcpy(weights.data(), linear_op->attrs.at("weight").data.data(), weights.size() * sizeof(float));
+    std::memcpy(bias.data(), linear_op->attrs.at("bias").data.data(), bias.size() * sizeof(float));
+
+    for (uint32_t batch : {1, 4}) {
+        std::vector<sftensor> inputs;
+        for (uint32_t i = 0; i < batch; i++) {
+            inputs.push_back(std::make_shared<ftensor>(32));
+            inputs.back()->rand();
+        }
+
+        const auto outputs = graph.forward(inputs);
+        ASSERT_EQ(outputs.size(), batch);
+        for (uint32_t i = 0; i < batch; i++) {
+            ASSERT_EQ(outputs.at(i)->size(), 128);
+            for (uint32_t o = 0; o < 128; o++) {
+                const float value = NaiveLinear(inputs.at(i)->raw_ptr(), 1, weights, bias, 32, o);
+                ASSERT_NEAR(outputs.at(i)->raw_ptr()[o], 1.f / (1.f + std::exp(-value)), 1e-5f);
+            }
+        }
+    }
+}
@@ -0,0 +1,158 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/adaptive_avgpooling.hpp"
+#include "layer/details/pooling.hpp"
+#include <algorithm>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace jinfer;
+
+/// 朴素实现，逐个窗口按pytorch的定义计算
+static float
+NaivePooling(const sftensor &input, uint32_t c, int oh, int ow, bool max_pooling,
+             int kernel, int stride, int padding, int dilation, bool count_include_pad)
+{
+    const int rows = int(input->rows());
+    const int cols = int(input->cols());
+    const int h_start = oh * stride - padding;
+    const int w_start = ow * stride - padding;
+
+    float max_value = std::numeric_limits<float>::lowest();
+    float sum = 0.f;
+    int count = 0;
+    for (int kh = 0; kh < kernel; kh++) {
+        for (int kw = 0; kw < kernel; kw++) {
+            const int ih = h_start + kh * dilation;
+            const int iw = w_start + kw * dilation;
+            if (ih < 0 || iw < 0 || ih >= rows || iw >= cols) {
+                continue;
+            }
+            const float value = input->at(c, ih, iw);
+            max_value = std::max(max_value, value);
+            sum += value;
+            count += 1;
+        }
+    }
+
+    if (max_pooling) {
+        return max_value;
+    }
+
+    if (count_include_pad) {
+        const int h_end = std::min(h_start + kernel, rows + padding);
+        const int w_end = std::min(w_start + kernel, cols + padding);
+        count = (h_end - h_start) * (w_end - w_start);
+    }
+    return sum / float(count);
+}
+
+static void
+CheckPooling(bool max_pooling, uint32_t channels, uint32_t rows, uint32_t cols,
+             int kernel, int stride, int padding, int dilation, bool ceil_mode, bool count_include_pad,
+             uint32_t output_rows, uint32_t output_cols)
+{
+    const PoolingType type = max_pooling ? PoolingType::kMaxPooling : PoolingType::kAvgPooling;
+    PoolingLayer layer(type, kernel, kernel, stride, stride, padding, padding, dilation, dilation,
+                       ceil_mode, count_include_pad);
+
+    std::vector<sftensor> inputs;
+    std::vector<sftensor> outputs;
+    for (int i = 0; i < 2; i++) {
+        inputs.push_back(std::make_shared<ftensor>(channels, rows, cols));
+        inputs.back()->rand();
+        outputs.push_back(std::make_shared<ftensor>(channels, output_rows, output_cols));
+    }
+
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    for (int i = 0; i < 2; i++) {
+        for (uint32_t c = 0; c < channels; c++) {
+            for (uint32_t oh = 0; oh < output_rows; oh++) {
+                for (uint32_t ow = 0; ow < output_cols; ow++) {
+                    const float expect = NaivePooling(inputs.at(i), c, int(oh), int(ow), max_pooling,
+                                                      kernel, stride, padding, dilation, count_include_pad);
+                    ASSERT_NEAR(outputs.at(i)->at(c, oh, ow), expect, 1e-5f);
+                }
+            }
+        }
+    }
+}
+
+TEST(test_pooling, maxpooling_resnet)
+{
+    CheckPooling(true, 8, 112, 112, 3, 2, 1, 1, false, true, 56, 56);
+}
+
+TEST(test_pooling, maxpooling_ceil_mode)
+{
+    CheckPooling(true, 3, 7, 7, 2, 2, 0, 1, true, true, 4, 4);
+    CheckPooling(true, 3, 9, 9, 3, 2, 1, 1, true, true, 5, 5);
+}
+
+TEST(test_pooling, maxpooling_dilation)
+{
+    CheckPooling(true, 4, 13, 13, 3, 1, 2, 2, false, true, 13, 13);
+}
+
+TEST(test_pooling, avgpooling)
+{
+    CheckPooling(false, 4, 15, 15, 3, 2, 1, 1, false, true, 8, 8);
+    CheckPooling(false, 4, 15, 15, 3, 2, 1, 1, false, false, 8, 8);
+    CheckPooling(false, 4, 8, 8, 3, 2, 1, 1, true, true, 5, 5);
+}
+
+TEST(test_pooling, pooling_output_shape_error)
+{
+    PoolingLayer layer(PoolingType::kMaxPooling, 3, 3, 2, 2, 1, 1);
+    std::vector<sftensor> inputs = {std::make_shared<ftensor>(2, 8, 8)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(2, 8, 8)};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferFailedOutputSizeError);
+}
+
+TEST(test_pooling, adaptive_avgpooling)
+{
+    const uint32_t channels = 5, rows = 10, cols = 7;
+    const uint32_t output_rows = 3, output_cols = 4;
+    AdaptiveAvgPoolingLayer layer(output_rows, output_cols);
+
+    std::vector<sftensor> inputs = {std::make_shared<ftensor>(channels, rows, cols)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(channels, output_rows, output_cols)};
+    inputs.front()->rand();
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    for (uint32_t c = 0; c < channels; c++) {
+        for (uint32_t oh = 0; oh < output_rows; oh++) {
+            for (uint32_t ow = 0; ow < output_cols; ow++) {
+                const uint32_t h_start = oh * rows / output_rows;
+                const uint32_t h_end = ((oh + 1) * rows + output_rows - 1) / output_rows;
+                const uint32_t w_start = ow * cols / output_cols;
+                const uint32_t w_end = ((ow + 1) * cols + output_cols - 1) / output_cols;
+
+                float sum = 0.f;
+                for (uint32_t ih = h_start; ih < h_end; ih++) {
+                    for (uint32_t iw = w_start; iw < w_end; iw++) {
+                        sum += inputs.front()->at(c, ih, iw);
+                    }
+                }
+                const float expect = sum / float((h_end - h_start) * (w_end - w_start));
+                ASSERT_NEAR(outputs.front()->at(c, oh, ow), expect, 1e-5f);
+            }
+        }
+    }
+}
+
+TEST(test_pooling, global_avgpooling)
+{
+    AdaptiveAvgPoolingLayer layer(1, 1);
+    std::vector<sftensor> inputs = {std::make_shared<ftensor>(512, 7, 7)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(512, 1, 1)};
+    inputs.front()->rand();
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    for (uint32_t c = 0; c < 512; c++) {
+        const float expect = arma::accu(inputs.front()->slice(c)) / 49.f;
+        ASSERT_NEAR(outputs.front()->at(c, 0, 0), expect, 1e-4f);
+    }
+}
@@ -0,0 +1,230 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/layer_norm.hpp"
+#include "layer/details/reduce.hpp"
+#include "layer/details/softmax.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace jinfer;
+
+static sftensor
+RandTensor(uint32_t channels, uint32_t rows, uint32_t cols, float scale = 1.f)
+{
+    auto tensor = std::make_shared<ftensor>(channels, rows, cols);
+    tensor->rand();
+    tensor->transform([scale](float value) { return (value - 0.5f) * scale; });
+    return tensor;
+}
+
+/// 朴素实现，沿张量的一个维度计算softmax
+static void
+CheckSoftmax(int axis, uint32_t channels, uint32_t rows, uint32_t cols, float scale)
+{
+    SoftmaxLayer layer(axis);
+    std::vector<sftensor> inputs = {RandTensor(channels, rows, cols, scale), RandTensor(channels, rows, cols, scale)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(channels, rows, cols),
+                                     std::make_shared<ftensor>(channels, rows, cols)};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    const uint32_t dims[3] = {channels, rows, cols};
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const sftensor &input = inputs.at(i);
+        for (uint32_t c = 0; c < channels; c++) {
+            for (uint32_t r = 0; r < rows; r++) {
+                for (uint32_t w = 0; w < cols; w++) {
+                    uint32_t index[3] = {c, r, w};
+                    float max_value = std::numeric_limits<float>::lowest();
+                    for (index[axis] = 0; index[axis] < dims[axis]; index[axis]++) {
+                        max_value = std::max(max_value, input->at(index[0], index[1], index[2]));
+                    }
+                    double sum = 0.;
+                    for (index[axis] = 0; index[axis] < dims[axis]; index[axis]++) {
+                        sum += std::exp(double(input->at(index[0], index[1], index[2]) - max_value));
+                    }
+                    const float expect = float(std::exp(double(input->at(c, r, w) - max_value)) / sum);
+                    ASSERT_NEAR(outputs.at(i)->at(c, r, w), expect, 1e-5f);
+                }
+            }
+        }
+    }
+}
+
+TEST(test_reduction, softmax_contiguous)
+{
+    CheckSoftmax(1, 3, 1000, 4, 10.f);
+}
+
+TEST(test_reduction, softmax_strided)
+{
+    CheckSoftmax(2, 3, 70, 9, 10.f);
+    CheckSoftmax(0, 6, 5, 7, 10.f);
+}
+
+TEST(test_reduction, softmax_large_values)
+{
+    /// 不减去最大值时exp会溢出
+    CheckSoftmax(2, 1, 1, 37, 2000.f);
+    CheckSoftmax(2, 2, 9, 13, 2000.f);
+}
+
+/// 朴素实现，两遍求均值和方差，在逻辑顺序上归一化张量最后的几个维度
+static void
+CheckLayerNorm(const std::vector<uint32_t> &normalized_shape, uint32_t channels, uint32_t rows, uint32_t cols,
+               bool affine)
+{
+    const float eps = 1e-5f;
+    LayerNormLayer layer(normalized_shape, eps, affine);
+
+    size_t normalized_size = 1;
+    for (uint32_t dim : normalized_shape) normalized_size *= dim;
+    std::vector<float> gamma(normalized_size);
+    std::vector<float> beta(normalized_size);
+    for (size_t i = 0; i < normalized_size; i++) {
+        gamma.at(i) = 0.5f + float(i % 7) * 0.1f;
+        beta.at(i) = float(i % 5) * 0.2f - 0.4f;
+    }
+    if (affine) {
+        layer.set_weights(gamma);
+        layer.set_bias(beta);
+    }
+
+    std::vector<sftensor> inputs = {RandTensor(channels, rows, cols, 4.f)};
+    inputs.front()->transform([](float value) { return value + 100.f; });
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(channels, rows, cols)};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    /// 按行主序遍历(channels, rows, cols)，每normalized_size个元素为一组
+    const sftensor &input = inputs.front();
+    const size_t total = size_t(channels) * rows * cols;
+    auto element = [&](const sftensor &tensor, size_t index) {
+        return tensor->at(index / (rows * cols), index / cols % rows, index % cols);
+    };
+    for (size_t begin = 0; begin < total; begin += normalized_size) {
+        double mean = 0., var = 0.;
+        for (size_t j = 0; j < normalized_size; j++) mean += element(input, begin + j);
+        mean /= double(normalized_size);
+        for (size_t j = 0; j < normalized_size; j++) {
+            const double delta = element(input, begin + j) - mean;
+            var += delta * delta;
+        }
+        var /= double(normalized_size);
+
+        for (size_t j = 0; j < normalized_size; j++) {
+            double expect = (element(input, begin + j) - mean) / std::sqrt(var + eps);
+            if (affine) {
+                expect = expect * gamma.at(j) + beta.at(j);
+            }
+            ASSERT_NEAR(element(outputs.front(), begin + j), float(expect), 1e-3f);
+        }
+    }
+}
+
+TEST(test_reduction, layer_norm_last_dim)
+{
+    CheckLayerNorm({33}, 1, 70, 33, true);
+    CheckLayerNorm({16}, 2, 5, 16, false);
+}
+
+TEST(test_reduction, layer_norm_contiguous)
+{
+    /// 二维输入(N, features)的张量为(1, 1, features)，长度不是kLanes的倍数
+    CheckLayerNorm({37}, 1, 1, 37, true);
+    CheckLayerNorm({5, 7}, 3, 5, 7, true);
+    CheckLayerNorm({3, 4, 6}, 3, 4, 6, false);
+}
+
+TEST(test_reduction, layer_norm_shape_error)
+{
+    LayerNormLayer layer({8}, 1e-5f, false);
+    std::vector<sftensor> inputs = {std::make_shared<ftensor>(1, 4, 6)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(1, 4, 6)};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferFailedShapeParameterError);
+}
+
+TEST(test_reduction, mean_spatial)
+{
+    /// (N, C, H, W)沿(2, 3)求均值且不保留维度，输出为(N, C)，张量为(1, 1, C)
+    const uint32_t channels = 6, rows = 9, cols = 11;
+    ReduceLayer layer(ReduceType::kReduceMean, {2, 3}, 4, false);
+    std::vector<sftensor> inputs = {RandTensor(channels, rows, cols), RandTensor(channels, rows, cols)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(1, 1, channels),
+                                     std::make_shared<ftensor>(1, 1, channels)};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    for (size_t i = 0; i < inputs.size(); i++) {
+        for (uint32_t c = 0; c < channels; c++) {
+            double sum = 0.;
+            for (uint32_t r = 0; r < rows; r++) {
+                for (uint32_t w = 0; w < cols; w++) {
+                    sum += inputs.at(i)->at(c, r, w);
+                }
+            }
+            ASSERT_NEAR(outputs.at(i)->at(0, 0, c), float(sum / (rows * cols)), 1e-5f);
+        }
+    }
+}
+
+TEST(test_reduction, sum_channels_keepdim)
+{
+    const uint32_t channels = 5, rows = 4, cols = 3;
+    ReduceLayer layer(ReduceType::kReduceSum, {1}, 4, true);
+    std::vector<sftensor> inputs = {RandTensor(channels, rows, cols)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(1, rows, cols)};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    for (uint32_t r = 0; r < rows; r++) {
+        for (uint32_t w = 0; w < cols; w++) {
+            float sum = 0.f;
+            for (uint32_t c = 0; c < channels; c++) {
+                sum += inputs.front()->at(c, r, w);
+            }
+            ASSERT_NEAR(outputs.front()->at(0, r, w), sum, 1e-5f);
+        }
+    }
+}
+
+TEST(test_reduction, max_min_strided)
+{
+    /// (N, S, D)沿最后一维求最大值，输出为(N, S)，张量为(1, 1, S)
+    const uint32_t rows = 20, cols = 13;
+    ReduceLayer max_layer(ReduceType::kReduceMax, {-1}, 3, false);
+    std::vector<sftensor> inputs = {RandTensor(1, rows, cols)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(1, 1, rows)};
+    ASSERT_EQ(max_layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    for (uint32_t r = 0; r < rows; r++) {
+        float max_value = std::numeric_limits<float>::lowest();
+        for (uint32_t w = 0; w < cols; w++) {
+            max_value = std::max(max_value, inputs.front()->at(0, r, w));
+        }
+        ASSERT_EQ(outputs.front()->at(0, 0, r), max_value);
+    }
+
+    /// (N, C, H, W)沿(1, 3)求最小值，输出为(N, H)
+    const uint32_t channels = 4;
+    ReduceLayer min_layer(ReduceType::kReduceMin, {1, 3}, 4, false);
+    inputs = {RandTensor(channels, rows, cols)};
+    outputs = {std::make_shared<ftensor>(1, 1, rows)};
+    ASSERT_EQ(min_layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    for (uint32_t r = 0; r < rows; r++) {
+        float min_value = std::numeric_limits<float>::max();
+        for (uint32_t c = 0; c < channels; c++) {
+            for (uint32_t w = 0; w < cols; w++) {
+                min_value = std::min(min_value, inputs.front()->at(c, r, w));
+            }
+        }
+        ASSERT_EQ(outputs.front()->at(0, 0, r), min_value);
+    }
+}
+
+TEST(test_reduction, reduce_output_shape_error)
+{
+    ReduceLayer layer(ReduceType::kReduceSum, {2, 3}, 4, true);
+    std::vector<sftensor> inputs = {std::make_shared<ftensor>(3, 4, 5)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(1, 1, 3)};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferFailedOutputSizeError);
+}
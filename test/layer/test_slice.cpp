@@ -0,0 +1,107 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/slice.hpp"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+using namespace jinfer;
+
+static sftensor
+RandTensor(uint32_t channels, uint32_t rows, uint32_t cols)
+{
+    auto tensor = std::make_shared<ftensor>(channels, rows, cols);
+    tensor->rand();
+    return tensor;
+}
+
+/// 逐元素与输入中按切片规则对应的位置比较
+static void
+CheckSlice(const std::array<SliceRange, 3> &ranges, const sftensor &input, const sftensor &output)
+{
+    const uint32_t shape[3] = {input->channels(), input->rows(), input->cols()};
+    int offsets[3];
+    for (int axis = 0; axis < 3; axis++) {
+        int size = 0;
+        ASSERT_TRUE(ranges.at(axis).resolve(int(shape[axis]), offsets[axis], size));
+    }
+
+    for (uint32_t c = 0; c < output->channels(); c++) {
+        for (uint32_t r = 0; r < output->rows(); r++) {
+            for (uint32_t w = 0; w < output->cols(); w++) {
+                ASSERT_EQ(output->at(c, r, w),
+                          input->at(offsets[0] + c * ranges[0].step, offsets[1] + r * ranges[1].step,
+                                    offsets[2] + w * ranges[2].step));
+            }
+        }
+    }
+}
+
+TEST(test_slice, resolve)
+{
+    int offset = 0;
+    int size = 0;
+    ASSERT_TRUE(SliceRange({1, 4, 1}).resolve(6, offset, size));
+    ASSERT_EQ(offset, 1);
+    ASSERT_EQ(size, 3);
+
+    ASSERT_TRUE(SliceRange({-3, INT_MAX, 2}).resolve(6, offset, size));
+    ASSERT_EQ(offset, 3);
+    ASSERT_EQ(size, 2);
+
+    ASSERT_TRUE(SliceRange({0, -1, 1}).resolve(6, offset, size));
+    ASSERT_EQ(size, 5);
+
+    ASSERT_FALSE(SliceRange({4, 2, 1}).resolve(6, offset, size));
+    ASSERT_FALSE(SliceRange({0, 6, 0}).resolve(6, offset, size));
+}
+
+TEST(test_slice, channels_view)
+{
+    std::array<SliceRange, 3> ranges;
+    ranges[0] = {1, 3, 1};
+    SliceLayer layer(ranges);
+
+    std::vector<sftensor> inputs = {RandTensor(4, 3, 5)};
+    std::vector<sftensor> outputs(1);
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    ASSERT_EQ(outputs.front()->raw_ptr(), inputs.front()->raw_ptr() + 3 * 5);
+    ASSERT_EQ(outputs.front()->channels(), 2);
+    CheckSlice(ranges, inputs.front(), outputs.front());
+
+    /// 再次推理时复用同一个视图
+    const sftensor first = outputs.front();
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    ASSERT_EQ(outputs.front(), first);
+}
+
+TEST(test_slice, copy)
+{
+    std::array<SliceRange, 3> ranges;
+    ranges[1] = {1, INT_MAX, 2};
+    ranges[2] = {-4, -1, 1};
+    SliceLayer layer(ranges);
+
+    std::vector<sftensor> inputs = {RandTensor(3, 7, 6), RandTensor(3, 7, 6)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(3, 3, 3), std::make_shared<ftensor>(3, 3, 3)};
+    const float *output_data = outputs.front()->raw_ptr();
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    ASSERT_EQ(outputs.front()->raw_ptr(), output_data);
+    for (size_t b = 0; b < inputs.size(); b++) {
+        CheckSlice(ranges, inputs.at(b), outputs.at(b));
+    }
+}
+
+/// 单通道时沿cols切出的部分同样连续
+TEST(test_slice, cols_view)
+{
+    std::array<SliceRange, 3> ranges;
+    ranges[2] = {2, 5, 1};
+    SliceLayer layer(ranges);
+
+    std::vector<sftensor> inputs = {RandTensor(1, 4, 6)};
+    std::vector<sftensor> outputs(1);
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    ASSERT_EQ(outputs.front()->raw_ptr(), inputs.front()->raw_ptr() + 2 * 4);
+    CheckSlice(ranges, inputs.front(), outputs.front());
+}
@@ -0,0 +1,116 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/split.hpp"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+using namespace jinfer;
+
+static sftensor
+RandTensor(uint32_t channels, uint32_t rows, uint32_t cols)
+{
+    auto tensor = std::make_shared<ftensor>(channels, rows, cols);
+    tensor->rand();
+    return tensor;
+}
+
+/// 沿张量的axis维切分，逐元素与输入中对应位置比较
+static void
+CheckSplit(int axis, const SplitSections &sections, uint32_t channels, uint32_t rows, uint32_t cols,
+           const std::vector<int> &expect_sizes)
+{
+    SplitLayer layer(axis, sections);
+    std::vector<sftensor> inputs = {RandTensor(channels, rows, cols), RandTensor(channels, rows, cols)};
+
+    std::vector<std::vector<sftensor>> pieces(expect_sizes.size());
+    std::vector<std::vector<sftensor> *> outputs;
+    for (size_t i = 0; i < pieces.size(); i++) {
+        uint32_t shape[3] = {channels, rows, cols};
+        shape[axis] = expect_sizes.at(i);
+        for (size_t b = 0; b < inputs.size(); b++) {
+            pieces.at(i).push_back(std::make_shared<ftensor>(shape[0], shape[1], shape[2]));
+        }
+        outputs.push_back(&pieces.at(i));
+    }
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    uint32_t offset = 0;
+    for (size_t i = 0; i < pieces.size(); i++) {
+        for (size_t b = 0; b < inputs.size(); b++) {
+            const sftensor &output = pieces.at(i).at(b);
+            uint32_t index[3];
+            for (index[0] = 0; index[0] < output->channels(); index[0]++) {
+                for (index[1] = 0; index[1] < output->rows(); index[1]++) {
+                    for (index[2] = 0; index[2] < output->cols(); index[2]++) {
+                        uint32_t input_index[3] = {index[0], index[1], index[2]};
+                        input_index[axis] += offset;
+                        ASSERT_EQ(output->at(index[0], index[1], index[2]),
+                                  inputs.at(b)->at(input_index[0], input_index[1], input_index[2]));
+                    }
+                }
+            }
+        }
+        offset += expect_sizes.at(i);
+    }
+}
+
+TEST(test_split, chunk_channels_view)
+{
+    SplitSections sections;
+    sections.chunks = 3;
+    SplitLayer layer(0, sections);
+    std::vector<sftensor> inputs = {RandTensor(7, 4, 5)};
+    std::vector<std::vector<sftensor>> pieces(3, std::vector<sftensor>(1));
+    std::vector<std::vector<sftensor> *> outputs = {&pieces.at(0), &pieces.at(1), &pieces.at(2)};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    /// 各段直接指向输入的内存，7个通道按3、3、1切分
+    ASSERT_EQ(pieces.at(0).front()->raw_ptr(), inputs.front()->raw_ptr());
+    ASSERT_EQ(pieces.at(1).front()->raw_ptr(), inputs.front()->raw_ptr() + 3 * 4 * 5);
+    ASSERT_EQ(pieces.at(2).front()->raw_ptr(), inputs.front()->raw_ptr() + 6 * 4 * 5);
+    ASSERT_EQ(pieces.at(2).front()->channels(), 1);
+    ASSERT_EQ(pieces.at(1).front()->at(2, 3, 4), inputs.front()->at(5, 3, 4));
+
+    /// 再次推理时复用同一个视图
+    const sftensor first = pieces.at(1).front();
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+    ASSERT_EQ(pieces.at(1).front(), first);
+
+    /// 输入释放后视图仍然有效
+    const float expect = inputs.front()->at(6, 1, 2);
+    inputs.clear();
+    ASSERT_EQ(pieces.at(2).front()->at(0, 1, 2), expect);
+}
+
+TEST(test_split, chunk)
+{
+    SplitSections sections;
+    sections.chunks = 2;
+    CheckSplit(0, sections, 6, 3, 4, {3, 3});
+    CheckSplit(1, sections, 2, 5, 3, {3, 2});
+    CheckSplit(2, sections, 3, 4, 7, {4, 3});
+}
+
+TEST(test_split, split_size)
+{
+    SplitSections sections;
+    sections.split_size = 2;
+    CheckSplit(2, sections, 1, 1, 5, {2, 2, 1});
+    CheckSplit(1, sections, 3, 4, 2, {2, 2});
+}
+
+TEST(test_split, split_sections)
+{
+    SplitSections sections;
+    sections.sizes = {1, 4, 2};
+    CheckSplit(0, sections, 7, 2, 3, {1, 4, 2});
+    CheckSplit(2, sections, 2, 3, 7, {1, 4, 2});
+
+    /// 各段长度之和与维度长度不同
+    SplitLayer layer(0, sections);
+    std::vector<sftensor> inputs = {RandTensor(6, 2, 3)};
+    std::vector<std::vector<sftensor>> pieces(3, std::vector<sftensor>(1));
+    std::vector<std::vector<sftensor> *> outputs = {&pieces.at(0), &pieces.at(1), &pieces.at(2)};
+    ASSERT_NE(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+}
@@ -0,0 +1,246 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/upsample.hpp"
+#include "runtime/runtime_ir.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+using namespace jinfer;
+
+/// 朴素实现，逐个输出元素按pytorch的坐标映射计算
+static float
+NaiveResize(const sftensor &input, const ResizeParam &param, uint32_t c, uint32_t oh, uint32_t ow,
+            uint32_t output_rows, uint32_t output_cols)
+{
+    auto source = [&param](uint32_t i, uint32_t in, uint32_t out, float scale) {
+        if (param.mode == ResizeMode::kResizeBilinear && param.align_corners) {
+            return out > 1 ? float(i) * float(in - 1) / float(out - 1) : 0.f;
+        }
+        const float ratio = scale > 0.f ? 1.f / scale : float(in) / float(out);
+        if (param.mode == ResizeMode::kResizeNearest) {
+            return std::min(std::floor(float(i) * ratio), float(in - 1));
+        }
+        return std::max(ratio * (float(i) + 0.5f) - 0.5f, 0.f);
+    };
+
+    const float h = source(oh, input->rows(), output_rows, param.scale_h);
+    const float w = source(ow, input->cols(), output_cols, param.scale_w);
+    if (param.mode == ResizeMode::kResizeNearest) {
+        return input->at(c, uint32_t(h), uint32_t(w));
+    }
+
+    const uint32_t h0 = std::min(uint32_t(h), input->rows() - 1);
+    const uint32_t w0 = std::min(uint32_t(w), input->cols() - 1);
+    const uint32_t h1 = std::min(h0 + 1, input->rows() - 1);
+    const uint32_t w1 = std::min(w0 + 1, input->cols() - 1);
+    const float lh = h - float(h0);
+    const float lw = w - float(w0);
+    return (1.f - lh) * ((1.f - lw) * input->at(c, h0, w0) + lw * input->at(c, h0, w1))
+        + lh * ((1.f - lw) * input->at(c, h1, w0) + lw * input->at(c, h1, w1));
+}
+
+/// prepared为true时按输入形状预先计算索引表并传给forward，否则在forward中计算
+static void
+CheckResize(const ResizeParam &param, uint32_t channels, uint32_t rows, uint32_t cols, bool prepared)
+{
+    int output_rows = 0;
+    int output_cols = 0;
+    ASSERT_TRUE(param.output_size(int(rows), int(cols), output_rows, output_cols));
+
+    UpsampleLayer layer(param);
+    std::shared_ptr<const ResizePlan> plan;
+    if (prepared) {
+        plan = layer.make_plan(rows, cols, output_rows, output_cols);
+    }
+
+    std::vector<sftensor> inputs;
+    std::vector<sftensor> outputs;
+    for (uint32_t i = 0; i < 2; i++) {
+        inputs.push_back(std::make_shared<ftensor>(channels, rows, cols));
+        inputs.back()->rand();
+        outputs.push_back(std::make_shared<ftensor>(channels, output_rows, output_cols));
+    }
+
+    ASSERT_EQ(layer.forward(inputs, outputs, plan.get()), InferStatus::kInferSuccess);
+    for (uint32_t i = 0; i < 2; i++) {
+        for (uint32_t c = 0; c < channels; c++) {
+            for (uint32_t oh = 0; oh < uint32_t(output_rows); oh++) {
+                for (uint32_t ow = 0; ow < uint32_t(output_cols); ow++) {
+                    ASSERT_NEAR(outputs.at(i)->at(c, oh, ow),
+                                NaiveResize(inputs.at(i), param, c, oh, ow, output_rows, output_cols), 1e-5f);
+                }
+            }
+        }
+    }
+}
+
+static ResizeParam
+ScaleParam(ResizeMode mode, float scale_h, float scale_w, bool align_corners = false)
+{
+    ResizeParam param;
+    param.mode = mode;
+    param.scale_h = scale_h;
+    param.scale_w = scale_w;
+    param.align_corners = align_corners;
+    return param;
+}
+
+static ResizeParam
+SizeParam(ResizeMode mode, int output_h, int output_w, bool align_corners = false)
+{
+    ResizeParam param;
+    param.mode = mode;
+    param.output_h = output_h;
+    param.output_w = output_w;
+    param.align_corners = align_corners;
+    return param;
+}
+
+TEST(test_upsample, nearest_scale)
+{
+    CheckResize(ScaleParam(ResizeMode::kResizeNearest, 2.f, 2.f), 4, 7, 5, true);
+    CheckResize(ScaleParam(ResizeMode::kResizeNearest, 2.f, 2.f), 4, 7, 5, false);
+    CheckResize(ScaleParam(ResizeMode::kResizeNearest, 1.5f, 3.f), 3, 5, 4, true);
+}
+
+TEST(test_upsample, nearest_size)
+{
+    CheckResize(SizeParam(ResizeMode::kResizeNearest, 11, 6), 3, 5, 4, true);
+    CheckResize(SizeParam(ResizeMode::kResizeNearest, 3, 2), 3, 8, 5, false);
+}
+
+TEST(test_upsample, bilinear_scale)
+{
+    CheckResize(ScaleParam(ResizeMode::kResizeBilinear, 2.f, 2.f), 4, 7, 5, true);
+    CheckResize(ScaleParam(ResizeMode::kResizeBilinear, 2.f, 2.f), 4, 7, 5, false);
+    CheckResize(ScaleParam(ResizeMode::kResizeBilinear, 2.5f, 1.5f), 2, 4, 6, true);
+}
+
+TEST(test_upsample, bilinear_align_corners)
+{
+    CheckResize(ScaleParam(ResizeMode::kResizeBilinear, 2.f, 2.f, true), 4, 7, 5, true);
+    CheckResize(SizeParam(ResizeMode::kResizeBilinear, 9, 1, true), 2, 4, 6, false);
+}
+
+TEST(test_upsample, bilinear_downsample)
+{
+    CheckResize(SizeParam(ResizeMode::kResizeBilinear, 4, 3), 3, 9, 7, true);
+}
+
+/// 与pytorch的结果比较：F.interpolate(x, scale_factor=2, mode="bilinear", align_corners=False)
+TEST(test_upsample, bilinear_reference)
+{
+    auto input = std::make_shared<ftensor>(1, 2, 2);
+    input->raw_ptr()[0] = 1.f;// (0, 0)
+    input->raw_ptr()[1] = 3.f;// (1, 0)
+    input->raw_ptr()[2] = 2.f;// (0, 1)
+    input->raw_ptr()[3] = 4.f;// (1, 1)
+    std::vector<sftensor> inputs = {input};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(1, 4, 4)};
+
+    UpsampleLayer layer(ScaleParam(ResizeMode::kResizeBilinear, 2.f, 2.f));
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferSuccess);
+
+    const float expect[4][4] = {{1.00f, 1.25f, 1.75f, 2.00f},
+                                {1.50f, 1.75f, 2.25f, 2.50f},
+                                {2.50f, 2.75f, 3.25f, 3.50f},
+                                {3.00f, 3.25f, 3.75f, 4.00f}};
+    for (uint32_t r = 0; r < 4; r++) {
+        for (uint32_t c = 0; c < 4; c++) {
+            ASSERT_NEAR(outputs.front()->at(0, r, c), expect[r][c], 1e-6f);
+        }
+    }
+}
+
+/// 传入的索引表与forward时的形状不同，按实际形状临时计算
+TEST(test_upsample, prepared_shape_changed)
+{
+    const ResizeParam param = ScaleParam(ResizeMode::kResizeBilinear, 2.f, 2.f);
+    UpsampleLayer layer(param);
+    const auto plan = layer.make_plan(4, 4, 8, 8);
+
+    auto input = std::make_shared<ftensor>(2, 3, 5);
+    input->rand();
+    std::vector<sftensor> inputs = {input};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(2, 6, 10)};
+    for (const LayerPlan *layer_plan : {static_cast<const LayerPlan *>(plan.get()), (const LayerPlan *) nullptr}) {
+        outputs.front()->fill(0.f);
+        ASSERT_EQ(layer.forward(inputs, outputs, layer_plan), InferStatus::kInferSuccess);
+        for (uint32_t c = 0; c < 2; c++) {
+            for (uint32_t oh = 0; oh < 6; oh++) {
+                for (uint32_t ow = 0; ow < 10; ow++) {
+                    ASSERT_NEAR(outputs.front()->at(c, oh, ow), NaiveResize(input, param, c, oh, ow, 6, 10), 1e-5f);
+                }
+            }
+        }
+    }
+}
+
+TEST(test_upsample, output_shape_mismatch)
+{
+    UpsampleLayer layer(ScaleParam(ResizeMode::kResizeNearest, 2.f, 2.f));
+    std::vector<sftensor> inputs = {std::make_shared<ftensor>(2, 4, 4)};
+    std::vector<sftensor> outputs = {std::make_shared<ftensor>(2, 8, 7)};
+    ASSERT_EQ(layer.forward(inputs, outputs), InferStatus::kInferFailedOutputSizeError);
+}
+
+/// FPN中的用法：nn.Upsample放大两倍后再用F.interpolate缩放到指定大小
+TEST(test_upsample, graph_forward)
+{
+    const std::string param_path = testing::TempDir() + "upsample.pnnx.param";
+    std::ofstream param(param_path);
+    param << "7767517\n"
+          << "4 3\n"
+          << "pnnx.Input pnnx_input_0 0 1 0 #0=(2,4,6,5)f32\n"
+          << "nn.Upsample up 1 1 0 1 mode=nearest scale_factor=(2.000000,2.000000) #0=(2,4,6,5)f32 #1=(2,4,12,10)f32\n"
+          << "F.interpolate resize 1 1 1 2 align_corners=False mode=bilinear size=(7,9) #1=(2,4,12,10)f32 #2=(2,4,7,9)f32\n"
+          << "pnnx.Output pnnx_output_0 1 0 2 #2=(2,4,7,9)f32\n";
+    param.close();
+
+    RuntimeGraph graph(param_path, "model_file/simple_ops2.pnnx.bin");
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    std::vector<sftensor> inputs;
+    for (int i = 0; i < 2; i++) {
+        inputs.push_back(std::make_shared<ftensor>(4, 6, 5));
+        inputs.back()->rand();
+    }
+    const auto &outputs = graph.forward(inputs);
+    ASSERT_EQ(outputs.size(), 2);
+
+    /// 两个插值节点的索引表都随内存规划一起计算
+    ASSERT_EQ(graph.memory_plans().size(), 1);
+    const MemoryPlan &plan = graph.memory_plans().begin()->second;
+    ASSERT_EQ(std::count_if(plan.layer_plans.begin(), plan.layer_plans.end(),
+                            [](const auto &layer_plan) { return layer_plan != nullptr; }),
+              2);
+
+    const ResizeParam up = ScaleParam(ResizeMode::kResizeNearest, 2.f, 2.f);
+    const ResizeParam resize = SizeParam(ResizeMode::kResizeBilinear, 7, 9);
+    for (int i = 0; i < 2; i++) {
+        auto middle = std::make_shared<ftensor>(4, 12, 10);
+        for (uint32_t c = 0; c < 4; c++) {
+            for (uint32_t oh = 0; oh < 12; oh++) {
+                for (uint32_t ow = 0; ow < 10; ow++) {
+                    middle->raw_ptr()[c * 120 + ow * 12 + oh] = NaiveResize(inputs.at(i), up, c, oh, ow, 12, 10);
+                }
+            }
+        }
+
+        ASSERT_EQ(outputs.at(i)->channels(), 4);
+        ASSERT_EQ(outputs.at(i)->rows(), 7);
+        ASSERT_EQ(outputs.at(i)->cols(), 9);
+        for (uint32_t c = 0; c < 4; c++) {
+            for (uint32_t oh = 0; oh < 7; oh++) {
+                for (uint32_t ow = 0; ow < 9; ow++) {
+                    ASSERT_NEAR(outputs.at(i)->at(c, oh, ow), NaiveResize(middle, resize, c, oh, ow, 7, 9), 1e-5f);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "math/gemm.hpp"
+#include "test_util.hpp"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace jinfer;
+
+/// 用朴素的三重循环检查sgemm，矩阵带有额外的列间距
+static void
+CheckGemm(uint32_t m, uint32_t n, uint32_t k, bool accumulate)
+{
+    const uint32_t lda = m + 3;
+    const uint32_t ldb = k + 1;
+    const uint32_t ldc = m + 2;
+    const std::vector<float> a = RandValues(size_t(lda) * k, 1);
+    const std::vector<float> b = RandValues(size_t(ldb) * n, 2);
+    std::vector<float> c = RandValues(size_t(ldc) * n, 3);
+    std::vector<float> expect = c;
+    for (uint32_t j = 0; j < n; j++) {
+        for (uint32_t i = 0; i < m; i++) {
+            double sum = accumulate ? expect[i + size_t(j) * ldc] : 0.;
+            for (uint32_t p = 0; p < k; p++) {
+                sum += double(a[i + size_t(p) * lda]) * b[p + size_t(j) * ldb];
+            }
+            expect[i + size_t(j) * ldc] = float(sum);
+        }
+    }
+
+    sgemm(m, n, k, a.data(), lda, b.data(), ldb, c.data(), ldc, accumulate);
+    for (uint32_t j = 0; j < n; j++) {
+        for (uint32_t i = 0; i < ldc; i++) {
+            /// 列间距中的填充不能被写入
+            ASSERT_NEAR(c[i + size_t(j) * ldc], expect[i + size_t(j) * ldc], 1e-3f)
+                << "m=" << m << " n=" << n << " k=" << k << " i=" << i << " j=" << j;
+        }
+    }
+}
+
+TEST(test_gemm, all_kernels)
+{
+    const GemmKernel default_kernel = gemm_kernel();
+    ASSERT_EQ(gemm_kernel_supported(GemmKernel::kGemmScalar), true);
+    for (GemmKernel kernel : {GemmKernel::kGemmScalar, GemmKernel::kGemmAvx2, GemmKernel::kGemmAvx512}) {
+        if (!set_gemm_kernel(kernel)) {
+            LOG(INFO) << "skip unsupported gemm kernel " << int(kernel);
+            continue;
+        }
+        ASSERT_EQ(gemm_kernel(), kernel);
+
+        /// 覆盖边缘小块、多个KC/MC分块以及卷积中m很小而k很大的形状
+        CheckGemm(1, 1, 1, false);
+        CheckGemm(7, 5, 3, false);
+        CheckGemm(33, 13, 17, true);
+        CheckGemm(300, 70, 600, false);
+        CheckGemm(49, 64, 1152, true);
+        CheckGemm(3, 2100, 40, false);
+    }
+    ASSERT_EQ(set_gemm_kernel(default_kernel), true);
+}
+
+TEST(test_gemm, empty_k)
+{
+    std::vector<float> c(6, 1.f);
+    sgemm(2, 3, 0, nullptr, 2, nullptr, 1, c.data(), 2, true);
+    ASSERT_EQ(c, std::vector<float>(6, 1.f));
+    sgemm(2, 3, 0, nullptr, 2, nullptr, 1, c.data(), 2, false);
+    ASSERT_EQ(c, std::vector<float>(6, 0.f));
+}
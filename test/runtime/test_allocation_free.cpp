@@ -0,0 +1,265 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/runtime_ir.hpp"
+#include "runtime/session.hpp"
+#include "test_util.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <string>
+
+#if defined(__GLIBC__)
+#include <link.h>
+#define JINFER_COUNT_ALLOCATIONS
+#endif
+
+using namespace jinfer;
+
+#ifdef JINFER_COUNT_ALLOCATIONS
+/// 替换测试程序的malloc系列函数，统计期间的每次分配计数；operator new和armadillo最终都经过这里
+static std::atomic<bool> counting{false};
+static std::atomic<uint64_t> allocations{0};
+
+/// OpenMP运行时每次进入单线程的并行区域都会分配线程组，这部分不计入
+static uintptr_t omp_begin = 0;
+static uintptr_t omp_end = 0;
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+}
+
+static inline void
+record_allocation(void *caller)
+{
+    if (counting.load(std::memory_order_relaxed)) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(caller);
+        if (address < omp_begin || address >= omp_end) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+extern "C" void *
+malloc(size_t size) noexcept
+{
+    record_allocation(__builtin_return_address(0));
+    return __libc_malloc(size);
+}
+
+extern "C" void *
+calloc(size_t count, size_t size) noexcept
+{
+    record_allocation(__builtin_return_address(0));
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *
+realloc(void *ptr, size_t size) noexcept
+{
+    record_allocation(__builtin_return_address(0));
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void *
+memalign(size_t alignment, size_t size) noexcept
+{
+    record_allocation(__builtin_return_address(0));
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" void *
+aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    record_allocation(__builtin_return_address(0));
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int
+posix_memalign(void **ptr, size_t alignment, size_t size) noexcept
+{
+    record_allocation(__builtin_return_address(0));
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void *memory = __libc_memalign(alignment, size);
+    if (memory == nullptr && size != 0) {
+        return ENOMEM;
+    }
+    *ptr = memory;
+    return 0;
+}
+
+extern "C" void
+free(void *ptr) noexcept
+{
+    __libc_free(ptr);
+}
+
+static int
+find_omp_runtime(struct dl_phdr_info *info, size_t, void *)
+{
+    if (info->dlpi_name == nullptr
+        || (std::strstr(info->dlpi_name, "libgomp") == nullptr && std::strstr(info->dlpi_name, "libomp") == nullptr)) {
+        return 0;
+    }
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const auto &header = info->dlpi_phdr[i];
+        if (header.p_type == PT_LOAD && (header.p_flags & PF_X)) {
+            omp_begin = info->dlpi_addr + header.p_vaddr;
+            omp_end = omp_begin + header.p_memsz;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/// 统计fn执行期间所有线程的堆分配次数
+template<typename Fn>
+static uint64_t
+CountAllocations(Fn &&fn)
+{
+    if (omp_end == 0) {
+        dl_iterate_phdr(find_omp_runtime, nullptr);
+    }
+    allocations = 0;
+    counting = true;
+    fn();
+    counting = false;
+    return allocations.load();
+}
+#endif
+
+/// 写出测试用的模型文件，Session和RuntimeGraph共用
+static std::pair<std::string, std::string>
+WriteTestModel()
+{
+    return WriteModel(
+        "allocation_free",
+        "7767517\n"
+        "11 10\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,3,15,13)f32\n"
+        "nn.Conv2d conv1 1 1 0 1 bias=True dilation=(1,1) groups=1 in_channels=3 kernel_size=(3,3) out_channels=8 padding=(1,1) padding_mode=zeros stride=(1,1) @bias=(8)f32 @weight=(8,3,3,3)f32 #0=(1,3,15,13)f32 #1=(1,8,15,13)f32\n"
+        "nn.ReLU relu 1 1 1 2 #1=(1,8,15,13)f32 #2=(1,8,15,13)f32\n"
+        "nn.MaxPool2d pool 1 1 2 3 ceil_mode=False dilation=(1,1) kernel_size=(3,3) padding=(1,1) return_indices=False stride=(2,2) #2=(1,8,15,13)f32 #3=(1,8,8,7)f32\n"
+        "nn.Conv2d conv2 1 1 3 4 bias=False dilation=(1,1) groups=1 in_channels=8 kernel_size=(1,1) out_channels=6 padding=(0,0) padding_mode=zeros stride=(1,1) @weight=(6,8,1,1)f32 #3=(1,8,8,7)f32 #4=(1,6,8,7)f32\n"
+        "nn.Sigmoid sigmoid 1 1 4 5 #4=(1,6,8,7)f32 #5=(1,6,8,7)f32\n"
+        "nn.AdaptiveAvgPool2d avgpool 1 1 5 6 output_size=(3,3) #5=(1,6,8,7)f32 #6=(1,6,3,3)f32\n"
+        "nn.Softmax softmax 1 1 6 7 dim=1 #6=(1,6,3,3)f32 #7=(1,6,3,3)f32\n"
+        "torch.mean mean 1 1 7 8 dim=(2,3) keepdim=False #7=(1,6,3,3)f32 #8=(1,6)f32\n"
+        "nn.Linear fc 1 1 8 9 bias=True in_features=6 out_features=4 @bias=(4)f32 @weight=(4,6)f32 #8=(1,6)f32 #9=(1,4)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 9 #9=(1,4)f32\n",
+        {{"conv1.weight", RandValues(8 * 3 * 3 * 3, 1)},
+         {"conv1.bias", RandValues(8, 2)},
+         {"conv2.weight", RandValues(6 * 8, 3)},
+         {"fc.weight", RandValues(4 * 6, 4)},
+         {"fc.bias", RandValues(4, 5)}});
+}
+
+static std::shared_ptr<const CompiledModel>
+CompileModel()
+{
+    const auto [param_path, bin_path] = WriteTestModel();
+    if (param_path.empty()) {
+        return nullptr;
+    }
+    return CompiledModel::compile(param_path, bin_path, "pnnx_input_0", "pnnx_output_0");
+}
+
+static std::vector<sftensor>
+RandInputs(uint32_t batch)
+{
+    std::vector<sftensor> inputs;
+    for (uint32_t i = 0; i < batch; i++) {
+        inputs.push_back(std::make_shared<ftensor>(3, 15, 13));
+        inputs.back()->rand();
+    }
+    return inputs;
+}
+
+#ifdef JINFER_COUNT_ALLOCATIONS
+TEST(test_allocation_free, counter_works)
+{
+    const uint64_t count = CountAllocations([]() {
+        auto value = std::make_shared<int>(1);
+        arma::fmat matrix(32, 32);
+        matrix.zeros();
+    });
+    ASSERT_GE(count, 2);
+}
+
+TEST(test_allocation_free, session_steady_state)
+{
+    auto model = CompileModel();
+    ASSERT_NE(model, nullptr);
+
+    Session session(model);
+    for (uint32_t batch : {1, 3}) {
+        const auto inputs = RandInputs(batch);
+        /// 第一次推理分配激活值和各线程的临时缓冲区
+        session.forward(inputs);
+        session.forward(inputs);
+
+        const uint64_t count = CountAllocations([&]() {
+            for (int i = 0; i < 3; i++) {
+                session.forward(inputs);
+            }
+        });
+        ASSERT_EQ(count, 0) << "batch: " << batch;
+    }
+}
+
+TEST(test_allocation_free, runtime_graph_steady_state)
+{
+    const auto [param_path, bin_path] = WriteTestModel();
+    ASSERT_FALSE(param_path.empty());
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    for (uint32_t batch : {1, 3}) {
+        const auto inputs = RandInputs(batch);
+        /// 第一次推理创建内存规划、分配各操作数和层的暂存数组
+        graph.forward(inputs);
+        graph.forward(inputs);
+
+        const uint64_t count = CountAllocations([&]() {
+            for (int i = 0; i < 3; i++) {
+                graph.forward(inputs);
+            }
+        });
+        ASSERT_EQ(count, 0) << "batch: " << batch;
+    }
+}
+#endif
+
+TEST(test_allocation_free, reuse_activations)
+{
+    auto model = CompileModel();
+    ASSERT_NE(model, nullptr);
+
+    Session session(model);
+    const auto inputs = RandInputs(2);
+    const std::vector<sftensor> first = session.forward(inputs);
+    std::vector<float> expects;
+    for (const auto &output : first) {
+        expects.insert(expects.end(), output->raw_ptr(), output->raw_ptr() + output->size());
+    }
+
+    /// 输入形状不变时输出复用同一个张量，结果不受缓冲区复用影响
+    const auto &second = session.forward(inputs);
+    ASSERT_EQ(second.size(), first.size());
+    size_t index = 0;
+    for (size_t i = 0; i < second.size(); i++) {
+        ASSERT_EQ(second.at(i).get(), first.at(i).get());
+        for (uint32_t j = 0; j < second.at(i)->size(); j++) {
+            ASSERT_FLOAT_EQ(second.at(i)->raw_ptr()[j], expects.at(index++));
+        }
+    }
+}
@@ -0,0 +1,180 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/batching_server.hpp"
+#include <fstream>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+
+using namespace jinfer;
+
+TEST(test_batching_server, mpmc_queue)
+{
+    MpmcQueue<int> queue(3);
+    ASSERT_EQ(queue.capacity(), 4);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(queue.try_push(i), true);
+    }
+    int value = 4;
+    ASSERT_EQ(queue.try_push(value), false);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(queue.try_pop(value), true);
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_EQ(queue.try_pop(value), false);
+}
+
+TEST(test_batching_server, concurrent_producers)
+{
+    auto model = CompiledModel::compile("model_file/dynamic_ops.pnnx.param", "model_file/dynamic_ops.pnnx.bin",
+                                        "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    BatchingOptions options;
+    options.max_batch_size = 8;
+    options.max_delay = std::chrono::milliseconds(20);
+    options.worker_num = 2;
+    BatchingServer server(model, options);
+
+    /// 不同线程提交不同形状的样本，结果与单独推理一致
+    const int producer_num = 4;
+    const int request_num = 16;
+    std::vector<std::vector<sftensor>> inputs(producer_num);
+    std::vector<std::vector<sftensor>> outputs(producer_num);
+    std::vector<std::thread> producers;
+    for (int i = 0; i < producer_num; i++) {
+        producers.emplace_back([&, i]() {
+            std::vector<std::future<sftensor>> futures;
+            for (int j = 0; j < request_num; j++) {
+                inputs.at(i).push_back(std::make_shared<ftensor>(3, 4 + i % 2, 4));
+                inputs.at(i).back()->rand();
+                futures.push_back(server.submit(inputs.at(i).back()));
+            }
+            for (auto &future : futures) {
+                outputs.at(i).push_back(future.get());
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    Session session(model);
+    for (int i = 0; i < producer_num; i++) {
+        ASSERT_EQ(outputs.at(i).size(), request_num);
+        for (int j = 0; j < request_num; j++) {
+            const auto &expect = session.forward({inputs.at(i).at(j)}).front();
+            const auto &output = outputs.at(i).at(j);
+            ASSERT_EQ(output->size(), expect->size());
+            for (uint32_t k = 0; k < output->size(); k++) {
+                ASSERT_FLOAT_EQ(output->raw_ptr()[k], expect->raw_ptr()[k]);
+            }
+        }
+    }
+
+    ASSERT_EQ(server.requests(), producer_num * request_num);
+    ASSERT_LT(server.batches(), server.requests());
+}
+
+TEST(test_batching_server, stop_drains_queue)
+{
+    auto model = CompiledModel::compile("model_file/dynamic_ops.pnnx.param", "model_file/dynamic_ops.pnnx.bin",
+                                        "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    BatchingOptions options;
+    options.max_batch_size = 4;
+    options.max_delay = std::chrono::seconds(10);
+    BatchingServer server(model, options);
+
+    std::vector<std::future<sftensor>> futures;
+    for (int i = 0; i < 6; i++) {
+        auto input = std::make_shared<ftensor>(3, 4, 4);
+        input->rand();
+        futures.push_back(server.submit(input));
+    }
+    server.stop();
+    for (auto &future : futures) {
+        ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        ASSERT_EQ(future.get()->channels(), 3);
+    }
+    ASSERT_EQ(server.requests(), 6);
+}
+
+/// 最后一个提交完的线程立即停止服务，其余线程提交的请求可能还在入队，也都要得到结果
+TEST(test_batching_server, stop_after_concurrent_submit)
+{
+    auto model = CompiledModel::compile("model_file/dynamic_ops.pnnx.param", "model_file/dynamic_ops.pnnx.bin",
+                                        "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    BatchingOptions options;
+    options.max_batch_size = 4;
+    options.queue_capacity = 8;
+    options.worker_num = 3;
+    BatchingServer server(model, options);
+
+    const int producer_num = 4;
+    const int request_num = 32;
+    std::atomic<int> finished{0};
+    std::vector<std::vector<std::future<sftensor>>> futures(producer_num);
+    std::vector<std::thread> producers;
+    for (int i = 0; i < producer_num; i++) {
+        producers.emplace_back([&, i]() {
+            for (int j = 0; j < request_num; j++) {
+                auto input = std::make_shared<ftensor>(3, 4, 4);
+                input->rand();
+                futures.at(i).push_back(server.submit(input));
+            }
+            if (finished.fetch_add(1) + 1 == producer_num) {
+                server.stop();
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    for (auto &producer_futures : futures) {
+        for (auto &future : producer_futures) {
+            ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+            ASSERT_EQ(future.get()->channels(), 3);
+        }
+    }
+    ASSERT_EQ(server.requests(), producer_num * request_num);
+}
+
+TEST(test_batching_server, invalid_requests)
+{
+    const std::string param_path = testing::TempDir() + "batching_pool.pnnx.param";
+    std::ofstream param(param_path);
+    param << "7767517\n"
+          << "3 2\n"
+          << "pnnx.Input pnnx_input_0 0 1 0 #0=(?,3,?,?)f32\n"
+          << "nn.MaxPool2d pool 1 1 0 1 ceil_mode=False dilation=(1,1) kernel_size=(3,3) padding=(0,0) return_indices=False stride=(1,1) #0=(?,3,?,?)f32 #1=(?,3,?,?)f32\n"
+          << "pnnx.Output pnnx_output_0 1 0 1 #1=(?,3,?,?)f32\n";
+    param.close();
+    auto model = CompiledModel::compile(param_path, "model_file/dynamic_ops.pnnx.bin", "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    BatchingOptions options;
+    options.max_batch_size = 4;
+    BatchingServer server(model, options);
+
+    /// 通道数不符的样本在提交时失败，小于池化窗口的样本在推理时失败，都不影响其他请求
+    auto wrong_channels = server.submit(std::make_shared<ftensor>(4, 5, 5));
+    auto too_small = server.submit(std::make_shared<ftensor>(3, 2, 2));
+    auto valid = server.submit(std::make_shared<ftensor>(3, 5, 6));
+    ASSERT_THROW(wrong_channels.get(), std::runtime_error);
+    ASSERT_THROW(too_small.get(), std::runtime_error);
+    const sftensor output = valid.get();
+    ASSERT_EQ(output->rows(), 3);
+    ASSERT_EQ(output->cols(), 4);
+
+    server.stop();
+    auto stopped = server.submit(std::make_shared<ftensor>(3, 5, 5));
+    ASSERT_EQ(stopped.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    ASSERT_THROW(stopped.get(), std::runtime_error);
+}
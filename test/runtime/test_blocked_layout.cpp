@@ -0,0 +1,95 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "layer/details/layout_transform.hpp"
+#include "runtime/runtime_ir.hpp"
+#include "test_util.hpp"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace jinfer;
+
+TEST(test_blocked_layout, transform_round_trip)
+{
+    Tensor<float> input(10, 5, 7);
+    input.rand();
+    Tensor<float> blocked(channel_blocks(10), 5 * kChannelBlock, 7);
+    LayoutTransformLayer::to_blocked(input, blocked);
+
+    const float *blocked_ptr = blocked.raw_ptr();
+    for (uint32_t c = 0; c < 16; c++) {
+        for (uint32_t h = 0; h < 5; h++) {
+            for (uint32_t w = 0; w < 7; w++) {
+                const float value = blocked_ptr[(c / 8) * 5 * 7 * 8 + (w * 5 + h) * 8 + c % 8];
+                ASSERT_EQ(value, c < 10 ? input.at(c, h, w) : 0.f);
+            }
+        }
+    }
+
+    Tensor<float> planar(10, 5, 7);
+    LayoutTransformLayer::to_planar(blocked, planar);
+    for (uint32_t i = 0; i < input.size(); i++) {
+        ASSERT_EQ(planar.raw_ptr()[i], input.raw_ptr()[i]);
+    }
+}
+
+TEST(test_blocked_layout, conv_pooling_activation)
+{
+    const auto [param_path, bin_path] = WriteModel(
+        "blocked",
+        "7767517\n"
+        "8 8\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,3,15,13)f32\n"
+        "nn.Conv2d conv1 1 1 0 1 bias=True dilation=(1,1) groups=1 in_channels=3 kernel_size=(3,3) out_channels=10 padding=(1,1) padding_mode=zeros stride=(2,2) @bias=(10)f32 @weight=(10,3,3,3)f32 #0=(1,3,15,13)f32 #1=(1,10,8,7)f32\n"
+        "nn.ReLU relu 1 1 1 2 #1=(1,10,8,7)f32 #2=(1,10,8,7)f32\n"
+        "nn.MaxPool2d pool1 1 1 2 3 ceil_mode=False dilation=(1,1) kernel_size=(3,3) padding=(1,1) return_indices=False stride=(1,1) #2=(1,10,8,7)f32 #3=(1,10,8,7)f32\n"
+        "nn.Conv2d conv2 1 1 3 4 bias=False dilation=(2,2) groups=1 in_channels=10 kernel_size=(3,3) out_channels=12 padding=(2,2) padding_mode=zeros stride=(1,1) @weight=(12,10,3,3)f32 #3=(1,10,8,7)f32 #4=(1,12,8,7)f32\n"
+        "nn.Sigmoid sigmoid 1 1 4 5 #4=(1,12,8,7)f32 #5=(1,12,8,7)f32\n"
+        "nn.AvgPool2d pool2 1 1 5 6 ceil_mode=True count_include_pad=False divisor_override=None kernel_size=(2,2) padding=(1,1) stride=(2,2) #5=(1,12,8,7)f32 #6=(1,12,5,4)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 6 #6=(1,12,5,4)f32\n",
+        {{"conv1.weight", RandValues(10 * 3 * 3 * 3, 1)},
+         {"conv1.bias", RandValues(10, 2)},
+         {"conv2.weight", RandValues(12 * 10 * 3 * 3, 3)}});
+    ASSERT_FALSE(param_path.empty());
+
+    RuntimeGraph planar_graph(param_path, bin_path);
+    ASSERT_EQ(planar_graph.init(), true);
+    ASSERT_EQ(planar_graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    RuntimeGraph blocked_graph(param_path, bin_path);
+    blocked_graph.set_blocked_layout(true);
+    ASSERT_EQ(blocked_graph.init(), true);
+    ASSERT_EQ(blocked_graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    // 整个区域只在入口和出口各插入一个转换节点
+    // 两个激活函数融合进卷积
+    const auto &topo_seq = blocked_graph.get_topo_seq();
+    ASSERT_EQ(topo_seq.size(), 8);
+    ASSERT_EQ(topo_seq.at(1)->name, "pnnx_input_0.to_nchw8c");
+    ASSERT_EQ(topo_seq.at(1)->type, "jinfer.ToBlocked");
+    ASSERT_EQ(topo_seq.at(6)->name, "pool2.to_nchw");
+    ASSERT_EQ(topo_seq.at(6)->type, "jinfer.ToPlanar");
+    for (size_t i = 2; i < 6; i++) {
+        ASSERT_EQ(topo_seq.at(i)->output_operand->layout, RuntimeDataLayout::kLayoutNCHW8c) << topo_seq.at(i)->name;
+    }
+
+    for (uint32_t batch : {1, 3}) {
+        std::vector<std::shared_ptr<Tensor<float>>> inputs;
+        for (uint32_t b = 0; b < batch; b++) {
+            auto input = std::make_shared<ftensor>(3, 15, 13);
+            input->rand();
+            inputs.push_back(input);
+        }
+
+        const auto expects = planar_graph.forward(inputs);
+        const auto outputs = blocked_graph.forward(inputs);
+        ASSERT_EQ(outputs.size(), batch);
+        for (uint32_t b = 0; b < batch; b++) {
+            ASSERT_EQ(outputs.at(b)->raw_shapes(), expects.at(b)->raw_shapes());
+            for (uint32_t i = 0; i < expects.at(b)->size(); i++) {
+                ASSERT_NEAR(outputs.at(b)->raw_ptr()[i], expects.at(b)->raw_ptr()[i], 1e-4f);
+            }
+        }
+    }
+}
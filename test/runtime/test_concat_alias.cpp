@@ -0,0 +1,155 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/runtime_ir.hpp"
+#include "runtime/session.hpp"
+#include "test_util.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+using namespace jinfer;
+
+/// cat1 = cat(relu(x), sigmoid(x))，cat2 = cat(cat1, x)，输出cat2的第1到4个通道
+static std::pair<std::string, std::string>
+WriteConcatModel(int cat_dim)
+{
+    const std::string suffix = std::to_string(cat_dim);
+    const std::string cat1_shape = cat_dim == 1 ? "(1,4,4,5)" : "(1,2,4,10)";
+    const std::string cat2_shape = cat_dim == 1 ? "(1,6,4,5)" : "(1,2,4,15)";
+    const std::string slice_shape = cat_dim == 1 ? "(1,4,4,5)" : "(1,1,4,15)";
+    const std::string slice_end = cat_dim == 1 ? "5" : "2";
+    std::ostringstream content;
+    content << "7767517\n"
+            << "7 6\n"
+            << "pnnx.Input pnnx_input_0 0 1 0 #0=(1,2,4,5)f32\n"
+            << "nn.ReLU relu 1 1 0 1 #0=(1,2,4,5)f32 #1=(1,2,4,5)f32\n"
+            << "nn.Sigmoid sigmoid 1 1 0 2 #0=(1,2,4,5)f32 #2=(1,2,4,5)f32\n"
+            << "torch.cat cat1 2 1 1 2 3 dim=" << cat_dim << " #1=(1,2,4,5)f32 #2=(1,2,4,5)f32 #3=" << cat1_shape
+            << "f32\n"
+            << "torch.cat cat2 2 1 3 0 4 dim=" << cat_dim << " #3=" << cat1_shape << "f32 #0=(1,2,4,5)f32 #4="
+            << cat2_shape << "f32\n"
+            << "Tensor.slice slice 1 1 4 5 dims=(1) ends=(" << slice_end << ") starts=(1) steps=(1) #4=" << cat2_shape
+            << "f32 #5=" << slice_shape << "f32\n"
+            << "pnnx.Output pnnx_output_0 1 0 5 #5=" << slice_shape << "f32\n";
+    return WriteModel("concat" + suffix, content.str());
+}
+
+/// cat2中通道c、行r、列w的参考值
+static float
+Expect(const sftensor &input, int cat_dim, uint32_t c, uint32_t r, uint32_t w)
+{
+    const uint32_t part = cat_dim == 1 ? c / 2 : w / 5;
+    const float x = cat_dim == 1 ? input->at(c % 2, r, w) : input->at(c, r, w % 5);
+    switch (part) {
+    case 0: return std::max(x, 0.f);
+    case 1: return 1.f / (1.f + std::exp(-x));
+    default: return x;
+    }
+}
+
+static std::shared_ptr<RuntimeOperator>
+FindOperator(const RuntimeGraph &graph, const std::string &name)
+{
+    for (const auto &op : graph.operators()) {
+        if (op->name == name) {
+            return op;
+        }
+    }
+    return nullptr;
+}
+
+static const float *
+DataOf(const std::shared_ptr<RuntimeOperator> &op)
+{
+    return op->output_operand->data.front()->raw_ptr();
+}
+
+TEST(test_concat_alias, graph_channels)
+{
+    const auto [param_path, bin_path] = WriteConcatModel(1);
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    for (int i = 0; i < 2; i++) {
+        auto input = std::make_shared<ftensor>(2, 4, 5);
+        input->rand();
+        input->transform([](float value) { return value - 0.5f; });
+        const auto outputs = graph.forward({input});
+        ASSERT_EQ(outputs.size(), 1);
+        ASSERT_EQ(outputs.front()->raw_shapes(), std::vector<uint32_t>({4, 4, 5}));
+        for (uint32_t c = 0; c < 4; c++) {
+            for (uint32_t r = 0; r < 4; r++) {
+                for (uint32_t w = 0; w < 5; w++) {
+                    ASSERT_NEAR(outputs.front()->at(c, r, w), Expect(input, 1, c + 1, r, w), 1e-6f);
+                }
+            }
+        }
+    }
+
+    /// 前驱节点直接写在cat2的输出中，切片是cat2输出的视图
+    const float *cat2_data = DataOf(FindOperator(graph, "cat2"));
+    ASSERT_EQ(DataOf(FindOperator(graph, "cat1")), cat2_data);
+    ASSERT_EQ(DataOf(FindOperator(graph, "relu")), cat2_data);
+    ASSERT_EQ(DataOf(FindOperator(graph, "sigmoid")), cat2_data + 2 * 4 * 5);
+    ASSERT_EQ(DataOf(FindOperator(graph, "slice")), cat2_data + 4 * 5);
+}
+
+/// 沿cols拼接时每一段不连续，各节点使用自己的缓冲区
+TEST(test_concat_alias, graph_cols)
+{
+    const auto [param_path, bin_path] = WriteConcatModel(3);
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    auto input = std::make_shared<ftensor>(2, 4, 5);
+    input->rand();
+    input->transform([](float value) { return value - 0.5f; });
+    const auto outputs = graph.forward({input});
+    ASSERT_EQ(outputs.front()->raw_shapes(), std::vector<uint32_t>({1, 4, 15}));
+    for (uint32_t r = 0; r < 4; r++) {
+        for (uint32_t w = 0; w < 15; w++) {
+            ASSERT_NEAR(outputs.front()->at(0, r, w), Expect(input, 3, 1, r, w), 1e-6f);
+        }
+    }
+
+    for (const auto &[_, plan] : graph.memory_plans()) {
+        for (const auto &alias : plan.aliases) {
+            ASSERT_EQ(alias.target, -1);
+        }
+    }
+}
+
+TEST(test_concat_alias, session)
+{
+    const auto [param_path, bin_path] = WriteConcatModel(1);
+    auto model = CompiledModel::compile(param_path, bin_path, "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    Session session(model);
+    const float *output_data = nullptr;
+    for (int i = 0; i < 3; i++) {
+        auto input = std::make_shared<ftensor>(2, 4, 5);
+        input->rand();
+        input->transform([](float value) { return value - 0.5f; });
+        const auto &outputs = session.forward({input});
+        for (uint32_t c = 0; c < 4; c++) {
+            for (uint32_t r = 0; r < 4; r++) {
+                for (uint32_t w = 0; w < 5; w++) {
+                    ASSERT_NEAR(outputs.front()->at(c, r, w), Expect(input, 1, c + 1, r, w), 1e-6f);
+                }
+            }
+        }
+
+        /// 相同形状的多次推理使用同一块拼接缓冲区
+        if (output_data != nullptr) {
+            ASSERT_EQ(outputs.front()->raw_ptr(), output_data);
+        }
+        output_data = outputs.front()->raw_ptr();
+    }
+}
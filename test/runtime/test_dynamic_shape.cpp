@@ -0,0 +1,144 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "data/tensor.hpp"
+#include "runtime/runtime_ir.hpp"
+#include <cmath>
+#include <fstream>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <string>
+
+static std::vector<std::shared_ptr<jinfer::Tensor<float>>>
+RandInputs(uint32_t batch, uint32_t channels, uint32_t rows, uint32_t cols)
+{
+    std::vector<std::shared_ptr<jinfer::Tensor<float>>> inputs;
+    for (uint32_t i = 0; i < batch; ++i) {
+        auto input = std::make_shared<jinfer::Tensor<float>>(channels, rows, cols);
+        input->rand();
+        inputs.push_back(input);
+    }
+    return inputs;
+}
+
+static void
+CheckOutputs(const std::vector<std::shared_ptr<jinfer::Tensor<float>>> &inputs,
+             const std::vector<std::shared_ptr<jinfer::Tensor<float>>> &outputs)
+{
+    ASSERT_EQ(inputs.size(), outputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        ASSERT_EQ(inputs.at(i)->channels(), outputs.at(i)->channels());
+        ASSERT_EQ(inputs.at(i)->rows(), outputs.at(i)->rows());
+        ASSERT_EQ(inputs.at(i)->cols(), outputs.at(i)->cols());
+
+        const float *in = inputs.at(i)->raw_ptr();
+        const float *out = outputs.at(i)->raw_ptr();
+        for (uint32_t j = 0; j < inputs.at(i)->size(); ++j) {
+            const float expect = 1.f / (1.f + std::exp(-std::max(in[j], 0.f)));
+            ASSERT_NEAR(out[j], expect, 1e-5f);
+        }
+    }
+}
+
+TEST(test_dynamic_shape, dynamic_batch_and_shape)
+{
+    using namespace jinfer;
+    std::string bin_path("model_file/dynamic_ops.pnnx.bin");
+    std::string param_path("model_file/dynamic_ops.pnnx.param");
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    const auto inputs1 = RandInputs(2, 3, 8, 8);
+    CheckOutputs(inputs1, graph.forward(inputs1));
+
+    const auto inputs2 = RandInputs(4, 3, 16, 12);
+    CheckOutputs(inputs2, graph.forward(inputs2));
+    ASSERT_EQ(graph.memory_plans().size(), 2);
+
+    // 相同输入形状复用已缓存的内存规划
+    const auto inputs3 = RandInputs(2, 3, 8, 8);
+    CheckOutputs(inputs3, graph.forward(inputs3));
+    ASSERT_EQ(graph.memory_plans().size(), 2);
+}
+
+TEST(test_dynamic_shape, reuse_output_buffers)
+{
+    using namespace jinfer;
+    std::string bin_path("model_file/dynamic_ops.pnnx.bin");
+    std::string param_path("model_file/dynamic_ops.pnnx.param");
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    const auto outputs1 = graph.forward(RandInputs(2, 3, 4, 4));
+    const float *ptr = outputs1.at(0)->raw_ptr();
+
+    // 形状不变时输出缓冲区不重新分配，批次增大时只追加新的张量
+    const auto outputs2 = graph.forward(RandInputs(3, 3, 4, 4));
+    ASSERT_EQ(outputs2.size(), 3);
+    ASSERT_EQ(outputs2.at(0)->raw_ptr(), ptr);
+}
+
+TEST(test_dynamic_shape, lazy_dynamic_operand_data)
+{
+    using namespace jinfer;
+    std::string bin_path("model_file/dynamic_ops.pnnx.bin");
+    std::string param_path("model_file/dynamic_ops.pnnx.param");
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+
+    const auto &ops = graph.operators();
+    for (const auto &op : ops) {
+        if (op->output_operand) {
+            ASSERT_EQ(op->output_operand->shape.at(0), -1);
+            ASSERT_TRUE(op->output_operand->data.empty());
+        }
+    }
+}
+
+TEST(test_dynamic_shape, shape_infer_fail)
+{
+    using namespace jinfer;
+    const std::string param_path = testing::TempDir() + "dynamic_pool.pnnx.param";
+    std::ofstream param(param_path);
+    param << "7767517\n"
+          << "3 2\n"
+          << "pnnx.Input pnnx_input_0 0 1 0 #0=(?,3,?,?)f32\n"
+          << "nn.MaxPool2d pool 1 1 0 1 ceil_mode=False dilation=(1,1) kernel_size=(3,3) padding=(0,0) return_indices=False stride=(1,1) #0=(?,3,?,?)f32 #1=(?,3,?,?)f32\n"
+          << "pnnx.Output pnnx_output_0 1 0 1 #1=(?,3,?,?)f32\n";
+    param.close();
+
+    RuntimeGraph graph(param_path, "model_file/dynamic_ops.pnnx.bin");
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    // 输入小于池化窗口时形状推导失败，forward返回空结果且不缓存内存规划
+    const auto &failed = graph.forward(RandInputs(2, 3, 2, 2));
+    ASSERT_TRUE(failed.empty());
+    ASSERT_EQ(graph.memory_plans().size(), 0);
+
+    const auto &outputs = graph.forward(RandInputs(2, 3, 5, 6));
+    ASSERT_EQ(outputs.size(), 2);
+    ASSERT_EQ(outputs.at(0)->rows(), 3);
+    ASSERT_EQ(outputs.at(0)->cols(), 4);
+    ASSERT_EQ(graph.memory_plans().size(), 1);
+}
+
+TEST(test_dynamic_shape, invalid_inputs)
+{
+    using namespace jinfer;
+    RuntimeGraph graph("model_file/dynamic_ops.pnnx.param", "model_file/dynamic_ops.pnnx.bin");
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    const auto inputs = RandInputs(2, 3, 4, 4);
+    const auto outputs = graph.forward(inputs);
+    ASSERT_EQ(outputs.size(), 2);
+
+    // 通道数与模型文件不符时forward失败，上一次结果的缓冲区仍然保留
+    ASSERT_TRUE(graph.forward(RandInputs(2, 4, 4, 4)).empty());
+    const auto &again = graph.forward(inputs);
+    ASSERT_EQ(again.size(), 2);
+    ASSERT_EQ(again.at(0).get(), outputs.at(0).get());
+}
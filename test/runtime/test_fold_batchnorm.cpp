@@ -0,0 +1,280 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/runtime_ir.hpp"
+#include "test_util.hpp"
+#include <cmath>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace jinfer;
+
+TEST(test_fold_batchnorm, conv_batchnorm_relu)
+{
+    const std::vector<float> weights = RandValues(4 * 3 * 3 * 3, 1);
+    const std::vector<float> gamma = RandValues(4, 2);
+    const std::vector<float> beta = RandValues(4, 3);
+    const std::vector<float> mean = RandValues(4, 4);
+    const std::vector<float> var = RandValues(4, 5, 0.5f, 2.f);
+    const auto [param_path, bin_path] = WriteModel(
+        "conv_bn",
+        "7767517\n"
+        "5 4\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,3,8,8)f32\n"
+        "nn.Conv2d conv 1 1 0 1 bias=False dilation=(1,1) groups=1 in_channels=3 kernel_size=(3,3) out_channels=4 padding=(1,1) padding_mode=zeros stride=(1,1) @weight=(4,3,3,3)f32 #0=(1,3,8,8)f32 #1=(1,4,8,8)f32\n"
+        "nn.BatchNorm2d bn 1 1 1 2 affine=True eps=1.000000e-05 num_features=4 @bias=(4)f32 @running_mean=(4)f32 @running_var=(4)f32 @weight=(4)f32 #1=(1,4,8,8)f32 #2=(1,4,8,8)f32\n"
+        "nn.ReLU relu 1 1 2 3 #2=(1,4,8,8)f32 #3=(1,4,8,8)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 3 #3=(1,4,8,8)f32\n",
+        {{"conv.weight", weights},
+         {"bn.weight", gamma},
+         {"bn.bias", beta},
+         {"bn.running_mean", mean},
+         {"bn.running_var", var}});
+    ASSERT_FALSE(param_path.empty());
+
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    // BatchNorm被删除，ReLU融合进卷积
+    const auto &topo_seq = graph.get_topo_seq();
+    ASSERT_EQ(topo_seq.size(), 3);
+    ASSERT_EQ(topo_seq.at(1)->type, "nn.Conv2d");
+    auto activation = topo_seq.at(1)->get_param<RuntimeParameterString>("activation");
+    ASSERT_TRUE(activation);
+    ASSERT_EQ(activation->value, "nn.ReLU");
+
+    auto input = std::make_shared<ftensor>(3, 8, 8);
+    input->rand();
+    const auto outputs = graph.forward({input});
+    ASSERT_EQ(outputs.size(), 1);
+
+    for (int o = 0; o < 4; o++) {
+        for (int oh = 0; oh < 8; oh++) {
+            for (int ow = 0; ow < 8; ow++) {
+                float sum = 0.f;
+                for (int ic = 0; ic < 3; ic++) {
+                    for (int kh = 0; kh < 3; kh++) {
+                        for (int kw = 0; kw < 3; kw++) {
+                            const int ih = oh - 1 + kh;
+                            const int iw = ow - 1 + kw;
+                            if (ih < 0 || iw < 0 || ih >= 8 || iw >= 8) {
+                                continue;
+                            }
+                            sum += weights.at(((o * 3 + ic) * 3 + kh) * 3 + kw) * input->at(ic, ih, iw);
+                        }
+                    }
+                }
+                float expect = (sum - mean.at(o)) / std::sqrt(var.at(o) + 1e-5f) * gamma.at(o) + beta.at(o);
+                expect = std::max(expect, 0.f);
+                ASSERT_NEAR(outputs.front()->at(o, oh, ow), expect, 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(test_fold_batchnorm, linear_batchnorm1d)
+{
+    const std::vector<float> weights = RandValues(5 * 6, 1);
+    const std::vector<float> bias = RandValues(5, 2);
+    const std::vector<float> mean = RandValues(5, 4);
+    const std::vector<float> var = RandValues(5, 5, 0.5f, 2.f);
+    const auto [param_path, bin_path] = WriteModel(
+        "linear_bn",
+        "7767517\n"
+        "4 3\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,6)f32\n"
+        "nn.Linear fc 1 1 0 1 bias=True in_features=6 out_features=5 @bias=(5)f32 @weight=(5,6)f32 #0=(1,6)f32 #1=(1,5)f32\n"
+        "nn.BatchNorm1d bn 1 1 1 2 affine=False eps=1.000000e-03 num_features=5 @running_mean=(5)f32 @running_var=(5)f32 #1=(1,5)f32 #2=(1,5)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 2 #2=(1,5)f32\n",
+        {{"fc.weight", weights},
+         {"fc.bias", bias},
+         {"bn.running_mean", mean},
+         {"bn.running_var", var}});
+    ASSERT_FALSE(param_path.empty());
+
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+    ASSERT_EQ(graph.get_topo_seq().size(), 3);
+
+    auto input = std::make_shared<ftensor>(6);
+    input->rand();
+    const auto outputs = graph.forward({input});
+    for (int o = 0; o < 5; o++) {
+        float sum = bias.at(o);
+        for (int k = 0; k < 6; k++) {
+            sum += weights.at(o * 6 + k) * input->raw_ptr()[k];
+        }
+        const float expect = (sum - mean.at(o)) / std::sqrt(var.at(o) + 1e-3f);
+        ASSERT_NEAR(outputs.front()->raw_ptr()[o], expect, 1e-4f);
+    }
+}
+
+/// depthwise卷积折叠BatchNorm后再融合ReLU6，只剩下一个卷积节点
+TEST(test_fold_batchnorm, depthwise_batchnorm_relu6)
+{
+    const std::vector<float> weights = RandValues(4 * 3 * 3, 1, -4.f, 4.f);
+    const std::vector<float> gamma = RandValues(4, 2);
+    const std::vector<float> beta = RandValues(4, 3);
+    const std::vector<float> mean = RandValues(4, 4);
+    const std::vector<float> var = RandValues(4, 5, 0.5f, 2.f);
+    const auto [param_path, bin_path] = WriteModel(
+        "depthwise_bn",
+        "7767517\n"
+        "5 4\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,4,9,7)f32\n"
+        "nn.Conv2d conv 1 1 0 1 bias=False dilation=(1,1) groups=4 in_channels=4 kernel_size=(3,3) out_channels=4 padding=(1,1) padding_mode=zeros stride=(2,2) @weight=(4,1,3,3)f32 #0=(1,4,9,7)f32 #1=(1,4,5,4)f32\n"
+        "nn.BatchNorm2d bn 1 1 1 2 affine=True eps=1.000000e-05 num_features=4 @bias=(4)f32 @running_mean=(4)f32 @running_var=(4)f32 @weight=(4)f32 #1=(1,4,5,4)f32 #2=(1,4,5,4)f32\n"
+        "nn.ReLU6 relu6 1 1 2 3 #2=(1,4,5,4)f32 #3=(1,4,5,4)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 3 #3=(1,4,5,4)f32\n",
+        {{"conv.weight", weights},
+         {"bn.weight", gamma},
+         {"bn.bias", beta},
+         {"bn.running_mean", mean},
+         {"bn.running_var", var}});
+    ASSERT_FALSE(param_path.empty());
+
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    const auto &topo_seq = graph.get_topo_seq();
+    ASSERT_EQ(topo_seq.size(), 3);
+    ASSERT_EQ(topo_seq.at(1)->type, "nn.Conv2d");
+    auto activation = topo_seq.at(1)->get_param<RuntimeParameterString>("activation");
+    ASSERT_TRUE(activation);
+    ASSERT_EQ(activation->value, "nn.ReLU6");
+
+    auto input = std::make_shared<ftensor>(4, 9, 7);
+    input->rand();
+    const auto outputs = graph.forward({input});
+    for (int c = 0; c < 4; c++) {
+        for (int oh = 0; oh < 5; oh++) {
+            for (int ow = 0; ow < 4; ow++) {
+                float sum = 0.f;
+                for (int kh = 0; kh < 3; kh++) {
+                    for (int kw = 0; kw < 3; kw++) {
+                        const int ih = oh * 2 - 1 + kh;
+                        const int iw = ow * 2 - 1 + kw;
+                        if (ih < 0 || iw < 0 || ih >= 9 || iw >= 7) {
+                            continue;
+                        }
+                        sum += weights.at((c * 3 + kh) * 3 + kw) * input->at(c, ih, iw);
+                    }
+                }
+                float expect = (sum - mean.at(c)) / std::sqrt(var.at(c) + 1e-5f) * gamma.at(c) + beta.at(c);
+                expect = std::min(std::max(expect, 0.f), 6.f);
+                ASSERT_NEAR(outputs.front()->at(c, oh, ow), expect, 1e-4f);
+            }
+        }
+    }
+}
+
+/// 普通卷积后的ReLU6融合进卷积；卷积已经带有激活函数时，后面的ReLU6作为单独的层计算
+TEST(test_fold_batchnorm, conv_relu6)
+{
+    const std::vector<float> weights = RandValues(6 * 5, 1, -4.f, 4.f);
+    const std::vector<float> bias = RandValues(6, 2);
+    const auto [param_path, bin_path] = WriteModel(
+        "conv_relu6",
+        "7767517\n"
+        "5 4\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,5,6,7)f32\n"
+        "nn.Conv2d conv 1 1 0 1 bias=True dilation=(1,1) groups=1 in_channels=5 kernel_size=(1,1) out_channels=6 padding=(0,0) padding_mode=zeros stride=(1,1) @bias=(6)f32 @weight=(6,5,1,1)f32 #0=(1,5,6,7)f32 #1=(1,6,6,7)f32\n"
+        "nn.ReLU6 relu6_0 1 1 1 2 #1=(1,6,6,7)f32 #2=(1,6,6,7)f32\n"
+        "F.relu6 relu6_1 1 1 2 3 #2=(1,6,6,7)f32 #3=(1,6,6,7)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 3 #3=(1,6,6,7)f32\n",
+        {{"conv.weight", weights},
+         {"conv.bias", bias}});
+    ASSERT_FALSE(param_path.empty());
+
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    const auto &topo_seq = graph.get_topo_seq();
+    ASSERT_EQ(topo_seq.size(), 4);
+    ASSERT_EQ(topo_seq.at(1)->type, "nn.Conv2d");
+    auto activation = topo_seq.at(1)->get_param<RuntimeParameterString>("activation");
+    ASSERT_TRUE(activation);
+    ASSERT_EQ(activation->value, "nn.ReLU6");
+    ASSERT_EQ(topo_seq.at(2)->name, "relu6_1");
+    ASSERT_NE(topo_seq.at(2)->layer, nullptr);
+
+    auto input = std::make_shared<ftensor>(5, 6, 7);
+    input->rand();
+    const auto outputs = graph.forward({input});
+    ASSERT_EQ(outputs.size(), 1);
+    for (int o = 0; o < 6; o++) {
+        for (int r = 0; r < 6; r++) {
+            for (int c = 0; c < 7; c++) {
+                float sum = bias.at(o);
+                for (int ic = 0; ic < 5; ic++) {
+                    sum += weights.at(o * 5 + ic) * input->at(ic, r, c);
+                }
+                ASSERT_NEAR(outputs.front()->at(o, r, c), std::min(std::max(sum, 0.f), 6.f), 1e-4f);
+            }
+        }
+    }
+}
+
+/// 卷积的输出同时被BatchNorm和ReLU使用，BatchNorm不能折叠，作为单独的层计算
+TEST(test_fold_batchnorm, conv_fan_out)
+{
+    const std::vector<float> weights = RandValues(4 * 3, 1);
+    const std::vector<float> bias = RandValues(4, 2);
+    const std::vector<float> gamma = RandValues(4, 3);
+    const std::vector<float> beta = RandValues(4, 4);
+    const std::vector<float> mean = RandValues(4, 5);
+    const std::vector<float> var = RandValues(4, 6, 0.5f, 2.f);
+    const auto [param_path, bin_path] = WriteModel(
+        "conv_fan_out",
+        "7767517\n"
+        "6 5\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,3,5,6)f32\n"
+        "nn.Conv2d conv 1 1 0 1 bias=True dilation=(1,1) groups=1 in_channels=3 kernel_size=(1,1) out_channels=4 padding=(0,0) padding_mode=zeros stride=(1,1) @bias=(4)f32 @weight=(4,3,1,1)f32 #0=(1,3,5,6)f32 #1=(1,4,5,6)f32\n"
+        "nn.BatchNorm2d bn 1 1 1 3 affine=True eps=1.000000e-05 num_features=4 @bias=(4)f32 @running_mean=(4)f32 @running_var=(4)f32 @weight=(4)f32 #1=(1,4,5,6)f32 #3=(1,4,5,6)f32\n"
+        "nn.ReLU relu 1 1 1 4 #1=(1,4,5,6)f32 #4=(1,4,5,6)f32\n"
+        "torch.cat cat 2 1 3 4 5 dim=1 #3=(1,4,5,6)f32 #4=(1,4,5,6)f32 #5=(1,8,5,6)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 5 #5=(1,8,5,6)f32\n",
+        {{"conv.weight", weights},
+         {"conv.bias", bias},
+         {"bn.weight", gamma},
+         {"bn.bias", beta},
+         {"bn.running_mean", mean},
+         {"bn.running_var", var}});
+    ASSERT_FALSE(param_path.empty());
+
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    bool found = false;
+    for (const auto &op : graph.get_topo_seq()) {
+        if (op->name == "bn") {
+            ASSERT_NE(op->layer, nullptr);
+            found = true;
+        }
+    }
+    ASSERT_TRUE(found);
+
+    auto input = std::make_shared<ftensor>(3, 5, 6);
+    input->rand();
+    const auto outputs = graph.forward({input});
+    ASSERT_EQ(outputs.size(), 1);
+    for (int o = 0; o < 4; o++) {
+        for (int r = 0; r < 5; r++) {
+            for (int c = 0; c < 6; c++) {
+                float sum = bias.at(o);
+                for (int ic = 0; ic < 3; ic++) {
+                    sum += weights.at(o * 3 + ic) * input->at(ic, r, c);
+                }
+                const float normalized = (sum - mean.at(o)) / std::sqrt(var.at(o) + 1e-5f) * gamma.at(o) + beta.at(o);
+                ASSERT_NEAR(outputs.front()->at(o, r, c), normalized, 1e-4f);
+                ASSERT_NEAR(outputs.front()->at(o + 4, r, c), std::max(sum, 0.f), 1e-4f);
+            }
+        }
+    }
+}
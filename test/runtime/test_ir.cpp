@@ -216,10 +216,13 @@ TEST(test_ir, pnnx_graph_all)
             LOG(INFO)
                 << name << " type: " << int(attribute_->type)
                 << " shape: " << ShapeStr(attribute_->shape);
+            // init之后权重留在模型文件中，读取后判断权重是否为空
+            ASSERT_EQ(attribute_->pending(), true);
+            attribute_->materialize();
             const auto &weight_data = attribute_->weight_data;
             ASSERT_EQ(weight_data
                           .empty(),
-                      false);// 判断权重是否为空
+                      false);
         }
         LOG(INFO)
             << "inputs: ";
@@ -0,0 +1,98 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/runtime_ir.hpp"
+#include "test_util.hpp"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace jinfer;
+
+/// 两个输入各自经过一个1x1卷积，只构建第一个分支
+TEST(test_lazy_weights, unreachable_branch)
+{
+    const std::vector<float> weight_a = RandValues(2 * 3, 1);
+    const std::vector<float> bias_a = RandValues(2, 2);
+    const auto [param_path, bin_path] = WriteModel(
+        "two_branches",
+        "7767517\n"
+        "6 4\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,3,4,5)f32\n"
+        "pnnx.Input pnnx_input_1 0 1 1 #1=(1,3,4,5)f32\n"
+        "nn.Conv2d conv_a 1 1 0 2 bias=True dilation=(1,1) groups=1 in_channels=3 kernel_size=(1,1) out_channels=2 padding=(0,0) padding_mode=zeros stride=(1,1) @bias=(2)f32 @weight=(2,3,1,1)f32 #0=(1,3,4,5)f32 #2=(1,2,4,5)f32\n"
+        "nn.Conv2d conv_b 1 1 1 3 bias=True dilation=(1,1) groups=1 in_channels=3 kernel_size=(1,1) out_channels=4 padding=(0,0) padding_mode=zeros stride=(1,1) @bias=(4)f32 @weight=(4,3,1,1)f32 #1=(1,3,4,5)f32 #3=(1,4,4,5)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 2 #2=(1,2,4,5)f32\n"
+        "pnnx.Output pnnx_output_1 1 0 3 #3=(1,4,4,5)f32\n",
+        {{"conv_a.weight", weight_a},
+         {"conv_a.bias", bias_a},
+         {"conv_b.weight", RandValues(4 * 3, 3)},
+         {"conv_b.bias", RandValues(4, 4)}});
+    ASSERT_FALSE(param_path.empty());
+
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    std::shared_ptr<RuntimeOperator> conv_a;
+    std::shared_ptr<RuntimeOperator> conv_b;
+    for (const auto &op : graph.operators()) {
+        for (const auto &[_, attr] : op->attrs) {
+            ASSERT_TRUE(attr->pending());
+            ASSERT_TRUE(attr->weight_data.empty());
+        }
+        if (op->name == "conv_a") conv_a = op;
+        if (op->name == "conv_b") conv_b = op;
+    }
+    ASSERT_NE(conv_a, nullptr);
+    ASSERT_NE(conv_b, nullptr);
+
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    /// 可达节点的权重在创建层后释放，另一个分支的权重从未读取
+    for (const auto &[_, attr] : conv_a->attrs) {
+        ASSERT_FALSE(attr->pending());
+        ASSERT_TRUE(attr->weight_data.empty());
+    }
+    for (const auto &[_, attr] : conv_b->attrs) {
+        ASSERT_TRUE(attr->pending());
+    }
+    ASSERT_EQ(conv_b->layer, nullptr);
+
+    auto input = std::make_shared<ftensor>(3, 4, 5);
+    input->rand();
+    const auto outputs = graph.forward({input});
+    ASSERT_EQ(outputs.size(), 1);
+    for (uint32_t o = 0; o < 2; o++) {
+        for (uint32_t r = 0; r < 4; r++) {
+            for (uint32_t w = 0; w < 5; w++) {
+                float expect = bias_a.at(o);
+                for (uint32_t i = 0; i < 3; i++) {
+                    expect += weight_a.at(o * 3 + i) * input->at(i, r, w);
+                }
+                ASSERT_NEAR(outputs.front()->at(o, r, w), expect, 1e-5f);
+            }
+        }
+    }
+
+    /// 需要时仍可以按需读取
+    const auto weight_b = conv_b->attrs.at("weight");
+    weight_b->materialize();
+    ASSERT_FALSE(weight_b->pending());
+    ASSERT_EQ(weight_b->get<float>(), RandValues(4 * 3, 3));
+    ASSERT_TRUE(weight_b->weight_data.empty());
+}
+
+TEST(test_lazy_weights, clear_before_read)
+{
+    const std::string param_path = "model_file/test_linear.pnnx.param";
+    const std::string bin_path = "model_file/test_linear.pnnx.bin";
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    for (const auto &op : graph.operators()) {
+        for (const auto &[_, attr] : op->attrs) {
+            attr->clear_weight();
+            ASSERT_FALSE(attr->pending());
+            attr->materialize();
+            ASSERT_TRUE(attr->weight_data.empty());
+        }
+    }
+}
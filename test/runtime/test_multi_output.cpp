@@ -0,0 +1,97 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/runtime_ir.hpp"
+#include "runtime/session.hpp"
+#include "test_util.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace jinfer;
+
+/// 输入按通道切成两块，分别经过ReLU和Sigmoid后输出
+static std::pair<std::string, std::string>
+WriteChunkModel()
+{
+    return WriteModel("chunk",
+                      "7767517\n"
+                      "6 6\n"
+                      "pnnx.Input pnnx_input_0 0 1 0 #0=(1,6,3,5)f32\n"
+                      "torch.chunk chunk 1 2 0 1 2 chunks=2 dim=1 #0=(1,6,3,5)f32 #1=(1,3,3,5)f32 #2=(1,3,3,5)f32\n"
+                      "nn.ReLU relu 1 1 1 3 #1=(1,3,3,5)f32 #3=(1,3,3,5)f32\n"
+                      "nn.Sigmoid sigmoid 1 1 2 4 #2=(1,3,3,5)f32 #4=(1,3,3,5)f32\n"
+                      "pnnx.Output pnnx_output_0 1 0 3 #3=(1,3,3,5)f32\n"
+                      "pnnx.Output pnnx_output_1 1 0 4 #4=(1,3,3,5)f32\n");
+}
+
+static void
+CheckChunkOutputs(const sftensor &input, const sftensor &relu_output, const sftensor &sigmoid_output)
+{
+    for (uint32_t c = 0; c < 3; c++) {
+        for (uint32_t r = 0; r < 3; r++) {
+            for (uint32_t w = 0; w < 5; w++) {
+                ASSERT_FLOAT_EQ(relu_output->at(c, r, w), std::max(input->at(c, r, w), 0.f));
+                ASSERT_NEAR(sigmoid_output->at(c, r, w), 1.f / (1.f + std::exp(-input->at(c + 3, r, w))), 1e-6f);
+            }
+        }
+    }
+}
+
+TEST(test_multi_output, graph_chunk)
+{
+    const auto [param_path, bin_path] = WriteChunkModel();
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+
+    std::shared_ptr<RuntimeOperator> chunk;
+    for (const auto &op : graph.operators()) {
+        if (op->name == "chunk") chunk = op;
+    }
+    ASSERT_NE(chunk, nullptr);
+    ASSERT_EQ(chunk->output_operands.size(), 2);
+    ASSERT_EQ(chunk->output_operand, chunk->output_operands.front());
+    ASSERT_EQ(chunk->output_operators.size(), 2);
+
+    const std::vector<std::string> input_names = {"pnnx_input_0"};
+    const std::vector<std::string> output_names = {"pnnx_output_0", "pnnx_output_1"};
+    ASSERT_EQ(graph.build(input_names, output_names), true);
+
+    auto input = std::make_shared<ftensor>(6, 3, 5);
+    input->rand();
+    input->transform([](float value) { return value - 0.5f; });
+    const auto outputs = graph.forward(std::vector<std::vector<sftensor>>{{input}});
+    ASSERT_EQ(outputs.size(), 2);
+    CheckChunkOutputs(input, outputs.at(0).front(), outputs.at(1).front());
+
+    /// 通道方向的分块是输入的视图
+    ASSERT_EQ(chunk->output_operands.at(1)->data.front()->raw_ptr(), input->raw_ptr() + 3 * 3 * 5);
+}
+
+TEST(test_multi_output, session_chunk)
+{
+    const auto [param_path, bin_path] = WriteChunkModel();
+    auto model = CompiledModel::compile(param_path, bin_path, "pnnx_input_0", "pnnx_output_1");
+    ASSERT_NE(model, nullptr);
+
+    /// 第二个分块单独占用一个激活值
+    ASSERT_EQ(model->activation_count(), model->operators().size() + 1);
+
+    Session session(model);
+    for (int i = 0; i < 2; i++) {
+        auto input = std::make_shared<ftensor>(6, 3, 5);
+        input->rand();
+        const auto &outputs = session.forward({input});
+        ASSERT_EQ(outputs.size(), 1);
+        for (uint32_t c = 0; c < 3; c++) {
+            for (uint32_t r = 0; r < 3; r++) {
+                for (uint32_t w = 0; w < 5; w++) {
+                    ASSERT_NEAR(outputs.front()->at(c, r, w), 1.f / (1.f + std::exp(-input->at(c + 3, r, w))),
+                                1e-6f);
+                }
+            }
+        }
+    }
+}
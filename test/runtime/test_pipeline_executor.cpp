@@ -0,0 +1,128 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/pipeline_executor.hpp"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+
+using namespace jinfer;
+
+TEST(test_pipeline_executor, partition_stages)
+{
+    using Boundaries = std::vector<size_t>;
+    ASSERT_EQ(PipelineExecutor::partition_stages({0, 1, 1, 1, 1, 0}, 2), Boundaries({0, 3, 6}));
+    ASSERT_EQ(PipelineExecutor::partition_stages({0, 8, 1, 1, 1, 1, 0}, 2), Boundaries({0, 2, 7}));
+    ASSERT_EQ(PipelineExecutor::partition_stages({0, 3, 3, 3, 0}, 3), Boundaries({0, 2, 3, 5}));
+    ASSERT_EQ(PipelineExecutor::partition_stages({1, 2}, 4), Boundaries({0, 1, 2}));
+    ASSERT_EQ(PipelineExecutor::partition_stages({1, 2, 3}, 1), Boundaries({0, 3}));
+}
+
+TEST(test_pipeline_executor, conv_pipeline)
+{
+    auto model = CompiledModel::compile("model_file/simple_ops2.pnnx.param", "model_file/simple_ops2.pnnx.bin",
+                                        "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    std::vector<sftensor> sample{std::make_shared<ftensor>(3, 16, 16)};
+    sample.front()->rand();
+    PipelineOptions options;
+    options.stage_num = 3;
+    options.max_in_flight = 4;
+    options.calibration_runs = 1;
+    PipelineExecutor pipeline(model, sample, options);
+
+    const auto &boundaries = pipeline.stage_boundaries();
+    ASSERT_EQ(boundaries.size(), 4);
+    ASSERT_EQ(boundaries.front(), 0);
+    ASSERT_EQ(boundaries.back(), model->operators().size());
+
+    /// 两个线程各提交若干请求，结果与单独的会话一致
+    const int producer_num = 2;
+    const int request_num = 6;
+    std::vector<std::vector<sftensor>> inputs(producer_num);
+    std::vector<std::vector<std::vector<sftensor>>> outputs(producer_num);
+    std::vector<std::thread> producers;
+    for (int i = 0; i < producer_num; i++) {
+        producers.emplace_back([&, i]() {
+            std::vector<std::future<std::vector<sftensor>>> futures;
+            for (int j = 0; j < request_num; j++) {
+                inputs.at(i).push_back(std::make_shared<ftensor>(3, 16, 16));
+                inputs.at(i).back()->rand();
+                futures.push_back(pipeline.submit({inputs.at(i).back()}));
+            }
+            for (auto &future : futures) {
+                outputs.at(i).push_back(future.get());
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    Session session(model);
+    for (int i = 0; i < producer_num; i++) {
+        for (int j = 0; j < request_num; j++) {
+            const auto &expect = session.forward({inputs.at(i).at(j)}).front();
+            ASSERT_EQ(outputs.at(i).at(j).size(), 1);
+            const auto &output = outputs.at(i).at(j).front();
+            ASSERT_EQ(output->size(), expect->size());
+            for (uint32_t k = 0; k < output->size(); k++) {
+                ASSERT_FLOAT_EQ(output->raw_ptr()[k], expect->raw_ptr()[k]);
+            }
+        }
+    }
+}
+
+TEST(test_pipeline_executor, stop_drains_requests)
+{
+    auto model = CompiledModel::compile("model_file/dynamic_ops.pnnx.param", "model_file/dynamic_ops.pnnx.bin",
+                                        "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    std::vector<sftensor> sample{std::make_shared<ftensor>(3, 8, 8)};
+    sample.front()->rand();
+    PipelineOptions options;
+    options.stage_num = 8;
+    options.max_in_flight = 2;
+    PipelineExecutor pipeline(model, sample, options);
+    ASSERT_EQ(pipeline.stage_boundaries().size(), model->operators().size() + 1);
+
+    std::vector<std::future<std::vector<sftensor>>> futures;
+    for (int i = 0; i < 5; i++) {
+        futures.push_back(pipeline.submit(sample));
+    }
+    pipeline.stop();
+    for (auto &future : futures) {
+        ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        ASSERT_EQ(future.get().front()->rows(), 8);
+    }
+}
+
+TEST(test_pipeline_executor, invalid_requests)
+{
+    auto model = CompiledModel::compile("model_file/dynamic_ops.pnnx.param", "model_file/dynamic_ops.pnnx.bin",
+                                        "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    std::vector<sftensor> sample{std::make_shared<ftensor>(3, 8, 8)};
+    sample.front()->rand();
+    PipelineOptions options;
+    options.max_in_flight = 1;
+    PipelineExecutor pipeline(model, sample, options);
+
+    /// 只有一个帧，失败的请求必须把帧放回空闲队列，后面的请求才能提交
+    for (int i = 0; i < 3; i++) {
+        auto failed = pipeline.submit({std::make_shared<ftensor>(4, 8, 8)});
+        ASSERT_THROW(failed.get(), std::runtime_error);
+    }
+    auto empty = pipeline.submit({});
+    ASSERT_THROW(empty.get(), std::runtime_error);
+    ASSERT_EQ(pipeline.submit(sample).get().front()->rows(), 8);
+
+    pipeline.stop();
+    auto stopped = pipeline.submit(sample);
+    ASSERT_EQ(stopped.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    ASSERT_THROW(stopped.get(), std::runtime_error);
+}
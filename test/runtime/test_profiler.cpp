@@ -0,0 +1,74 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/runtime_ir.hpp"
+#include <fstream>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace jinfer;
+
+TEST(test_profiler, conv_graph)
+{
+    RuntimeGraph graph("model_file/simple_ops2.pnnx.param", "model_file/simple_ops2.pnnx.bin");
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    std::vector<sftensor> inputs;
+    for (int i = 0; i < 2; i++) {
+        inputs.push_back(std::make_shared<ftensor>(3, 16, 16));
+        inputs.back()->rand();
+    }
+
+    /// 未设置分析器时不记录
+    graph.forward(inputs);
+    ASSERT_EQ(graph.profiler(), nullptr);
+
+    auto profiler = std::make_shared<Profiler>();
+    graph.set_profiler(profiler);
+    const int runs = 3;
+    for (int i = 0; i < runs; i++) {
+        graph.forward(inputs);
+    }
+    ASSERT_EQ(profiler->runs(), runs);
+    ASSERT_EQ(profiler->trace_events().size(), 3 * runs);
+
+    const auto profiles = profiler->profiles();
+    ASSERT_EQ(profiles.size(), 3);
+    for (size_t i = 0; i < profiles.size(); i++) {
+        ASSERT_EQ(profiles.at(i).calls, runs);
+        ASSERT_EQ(profiles.at(i).type, "nn.Conv2d");
+        if (i > 0) {
+            ASSERT_GE(profiles.at(i - 1).total_ms, profiles.at(i).total_ms);
+        }
+    }
+
+    for (const auto &profile : profiles) {
+        if (profile.name == "op3") {
+            /// 2x64x16x16个输出，每个输出32x3x3次乘加
+            ASSERT_EQ(profile.flops, uint64_t(runs) * 2 * 64 * 16 * 16 * 32 * 9 * 2);
+            const uint64_t bytes_read = (2 * 32 * 16 * 16 + 64 * 32 * 9 + 64) * sizeof(float);
+            ASSERT_EQ(profile.bytes_read, uint64_t(runs) * bytes_read);
+            ASSERT_EQ(profile.bytes_written, uint64_t(runs) * 2 * 64 * 16 * 16 * sizeof(float));
+        }
+    }
+
+    const std::string report = profiler->report();
+    ASSERT_NE(report.find("op5"), std::string::npos);
+    ASSERT_NE(report.find("GFLOP/s"), std::string::npos);
+
+    const std::string trace_path = testing::TempDir() + "simple_ops2_trace.json";
+    ASSERT_EQ(profiler->dump_chrome_trace(trace_path), true);
+    std::ifstream trace_file(trace_path);
+    std::stringstream trace;
+    trace << trace_file.rdbuf();
+    ASSERT_EQ(trace.str().rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0);
+    ASSERT_NE(trace.str().find("\"name\":\"op1\",\"cat\":\"nn.Conv2d\",\"ph\":\"X\""), std::string::npos);
+
+    profiler->clear();
+    graph.set_profiler(nullptr);
+    graph.forward(inputs);
+    ASSERT_EQ(profiler->runs(), 0);
+    ASSERT_TRUE(profiler->trace_events().empty());
+}
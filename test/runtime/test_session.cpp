@@ -0,0 +1,150 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/session.hpp"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace jinfer;
+
+static std::vector<sftensor>
+RandInputs(uint32_t batch, uint32_t channels, uint32_t rows, uint32_t cols)
+{
+    std::vector<sftensor> inputs;
+    for (uint32_t i = 0; i < batch; i++) {
+        inputs.push_back(std::make_shared<ftensor>(channels, rows, cols));
+        inputs.back()->rand();
+    }
+    return inputs;
+}
+
+static void
+CheckSame(const std::vector<sftensor> &outputs, const std::vector<sftensor> &expects)
+{
+    ASSERT_EQ(outputs.size(), expects.size());
+    for (size_t i = 0; i < outputs.size(); i++) {
+        ASSERT_EQ(outputs.at(i)->size(), expects.at(i)->size());
+        for (uint32_t j = 0; j < outputs.at(i)->size(); j++) {
+            ASSERT_FLOAT_EQ(outputs.at(i)->raw_ptr()[j], expects.at(i)->raw_ptr()[j]);
+        }
+    }
+}
+
+TEST(test_session, compile_fail)
+{
+    ASSERT_EQ(CompiledModel::compile("model_file/not_exist.param", "model_file/not_exist.bin",
+                                     "pnnx_input_0", "pnnx_output_0"), nullptr);
+}
+
+TEST(test_session, same_as_graph)
+{
+    const std::string param_path = "model_file/simple_ops2.pnnx.param";
+    const std::string bin_path = "model_file/simple_ops2.pnnx.bin";
+    auto model = CompiledModel::compile(param_path, bin_path, "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    Session session(model);
+    for (int i = 0; i < 2; i++) {
+        const auto inputs = RandInputs(2, 3, 16, 16);
+        CheckSame(session.forward(inputs), graph.forward(inputs));
+    }
+}
+
+TEST(test_session, concurrent_sessions)
+{
+    const std::string param_path = "model_file/dynamic_ops.pnnx.param";
+    const std::string bin_path = "model_file/dynamic_ops.pnnx.bin";
+    auto model = CompiledModel::compile(param_path, bin_path, "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    /// 每个线程使用自己的会话，批次和形状各不相同
+    const int thread_num = 4;
+    std::vector<std::vector<sftensor>> inputs;
+    std::vector<std::vector<sftensor>> expects;
+    for (int i = 0; i < thread_num; i++) {
+        inputs.push_back(RandInputs(i + 1, 3, 8 + i, 8));
+        expects.emplace_back();
+        for (const auto &output : graph.forward(inputs.back())) {
+            expects.back().push_back(std::make_shared<ftensor>(*output));
+        }
+    }
+
+    std::vector<std::vector<sftensor>> outputs(thread_num);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_num; i++) {
+        threads.emplace_back([&, i]() {
+            Session session(model);
+            for (int j = 0; j < 8; j++) {
+                const auto &result = session.forward(inputs.at(i));
+                outputs.at(i).clear();
+                for (const auto &output : result) {
+                    outputs.at(i).push_back(std::make_shared<ftensor>(*output));
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < thread_num; i++) {
+        CheckSame(outputs.at(i), expects.at(i));
+    }
+    ASSERT_EQ(model->operators().size(), graph.get_topo_seq().size());
+}
+
+/// 不合法的输入只让这一次推理失败，会话之后仍可正常使用
+TEST(test_session, invalid_inputs)
+{
+    const std::string param_path = "model_file/simple_ops2.pnnx.param";
+    const std::string bin_path = "model_file/simple_ops2.pnnx.bin";
+    auto model = CompiledModel::compile(param_path, bin_path, "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    Session session(model);
+    ASSERT_TRUE(session.forward(RandInputs(2, 3, 8, 16)).empty());
+    ASSERT_TRUE(session.forward({}).empty());
+    ASSERT_FALSE(session.set_inputs(RandInputs(1, 4, 16, 16)));
+
+    const auto &outputs = session.forward(RandInputs(2, 3, 16, 16));
+    ASSERT_EQ(outputs.size(), 2);
+    ASSERT_EQ(outputs.front()->channels(), 128);
+}
+
+/// 内存规划个数有上限，被淘汰的规划仍由使用它的会话持有
+TEST(test_session, evict_memory_plans)
+{
+    const std::string param_path = "model_file/dynamic_ops.pnnx.param";
+    const std::string bin_path = "model_file/dynamic_ops.pnnx.bin";
+    auto model = CompiledModel::compile(param_path, bin_path, "pnnx_input_0", "pnnx_output_0");
+    ASSERT_NE(model, nullptr);
+
+    const auto inputs = RandInputs(1, 3, 8, 8);
+    std::vector<int> input_shape;
+    ASSERT_TRUE(model->input_shape_of(inputs, input_shape));
+
+    Session session(model);
+    std::vector<sftensor> expects;
+    for (const auto &output : session.forward(inputs)) {
+        expects.push_back(std::make_shared<ftensor>(*output));
+    }
+    const auto first_plan = model->memory_plan(input_shape);
+    ASSERT_NE(first_plan, nullptr);
+
+    Session other(model);
+    for (uint32_t i = 0; i < CompiledModel::kMaxMemoryPlans; i++) {
+        ASSERT_EQ(other.forward(RandInputs(1, 3, 9 + i, 8)).size(), 1);
+    }
+    ASSERT_NE(model->memory_plan(input_shape), first_plan);
+
+    CheckSame(session.forward(inputs), expects);
+}
@@ -0,0 +1,192 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/runtime_ir.hpp"
+#include "runtime/shape_infer.hpp"
+#include <fstream>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace jinfer;
+
+static void
+SetIntArray(const std::shared_ptr<RuntimeOperator> &op, const std::string &name, const std::vector<int> &value)
+{
+    auto param = std::make_shared<RuntimeParameterIntArray>();
+    param->value = value;
+    op->params.insert({name, param});
+}
+
+static void
+SetInt(const std::shared_ptr<RuntimeOperator> &op, const std::string &name, int value)
+{
+    auto param = std::make_shared<RuntimeParameterInt>();
+    param->value = value;
+    op->params.insert({name, param});
+}
+
+static void
+SetBool(const std::shared_ptr<RuntimeOperator> &op, const std::string &name, bool value)
+{
+    auto param = std::make_shared<RuntimeParameterBool>();
+    param->value = value;
+    op->params.insert({name, param});
+}
+
+TEST(test_shape_infer, conv2d)
+{
+    auto op = std::make_shared<RuntimeOperator>();
+    op->name = "conv";
+    op->type = "nn.Conv2d";
+    SetInt(op, "in_channels", 3);
+    SetInt(op, "out_channels", 64);
+    SetIntArray(op, "kernel_size", {7, 7});
+    SetIntArray(op, "stride", {2, 2});
+    SetIntArray(op, "padding", {3, 3});
+    SetIntArray(op, "dilation", {1, 1});
+
+    std::vector<int> output_shape;
+    ASSERT_TRUE(ShapeInferRegisterer::infer_shape(op, {{4, 3, 224, 224}}, output_shape));
+    ASSERT_EQ(output_shape, std::vector<int>({4, 64, 112, 112}));
+
+    // 输入通道与参数不一致
+    ASSERT_FALSE(ShapeInferRegisterer::infer_shape(op, {{4, 5, 224, 224}}, output_shape));
+}
+
+TEST(test_shape_infer, maxpool2d)
+{
+    auto op = std::make_shared<RuntimeOperator>();
+    op->name = "maxpool";
+    op->type = "nn.MaxPool2d";
+    SetIntArray(op, "kernel_size", {3, 3});
+    SetIntArray(op, "stride", {2, 2});
+    SetIntArray(op, "padding", {1, 1});
+    SetIntArray(op, "dilation", {1, 1});
+    SetBool(op, "ceil_mode", false);
+
+    std::vector<int> output_shape;
+    ASSERT_TRUE(ShapeInferRegisterer::infer_shape(op, {{1, 64, 112, 112}}, output_shape));
+    ASSERT_EQ(output_shape, std::vector<int>({1, 64, 56, 56}));
+
+    ASSERT_TRUE(ShapeInferRegisterer::infer_shape(op, {{1, 64, 8, 8}}, output_shape));
+    ASSERT_EQ(output_shape, std::vector<int>({1, 64, 4, 4}));
+}
+
+TEST(test_shape_infer, maxpool2d_ceil_mode)
+{
+    auto op = std::make_shared<RuntimeOperator>();
+    op->name = "maxpool";
+    op->type = "nn.MaxPool2d";
+    SetIntArray(op, "kernel_size", {2, 2});
+    SetIntArray(op, "stride", {2, 2});
+    SetIntArray(op, "padding", {0, 0});
+    SetBool(op, "ceil_mode", true);
+
+    std::vector<int> output_shape;
+    ASSERT_TRUE(ShapeInferRegisterer::infer_shape(op, {{1, 8, 7, 7}}, output_shape));
+    ASSERT_EQ(output_shape, std::vector<int>({1, 8, 4, 4}));
+}
+
+TEST(test_shape_infer, adaptive_avgpool_flatten_linear)
+{
+    auto avgpool = std::make_shared<RuntimeOperator>();
+    avgpool->name = "avgpool";
+    avgpool->type = "nn.AdaptiveAvgPool2d";
+    SetIntArray(avgpool, "output_size", {1, 1});
+
+    auto flatten = std::make_shared<RuntimeOperator>();
+    flatten->name = "flatten";
+    flatten->type = "torch.flatten";
+    SetInt(flatten, "start_dim", 1);
+    SetInt(flatten, "end_dim", -1);
+
+    auto linear = std::make_shared<RuntimeOperator>();
+    linear->name = "fc";
+    linear->type = "nn.Linear";
+    SetInt(linear, "in_features", 512);
+    SetInt(linear, "out_features", 1000);
+
+    std::vector<int> shape1, shape2, shape3;
+    ASSERT_TRUE(ShapeInferRegisterer::infer_shape(avgpool, {{8, 512, 7, 7}}, shape1));
+    ASSERT_EQ(shape1, std::vector<int>({8, 512, 1, 1}));
+    ASSERT_TRUE(ShapeInferRegisterer::infer_shape(flatten, {shape1}, shape2));
+    ASSERT_EQ(shape2, std::vector<int>({8, 512}));
+    ASSERT_TRUE(ShapeInferRegisterer::infer_shape(linear, {shape2}, shape3));
+    ASSERT_EQ(shape3, std::vector<int>({8, 1000}));
+
+    ASSERT_FALSE(ShapeInferRegisterer::infer_shape(linear, {{8, 256}}, shape3));
+}
+
+TEST(test_shape_infer, expression_broadcast)
+{
+    auto op = std::make_shared<RuntimeOperator>();
+    op->name = "expr";
+    op->type = "pnnx.Expression";
+
+    std::vector<int> output_shape;
+    ASSERT_TRUE(ShapeInferRegisterer::infer_shape(op, {{2, 64, 8, 8}, {2, 64, 8, 8}}, output_shape));
+    ASSERT_EQ(output_shape, std::vector<int>({2, 64, 8, 8}));
+    ASSERT_TRUE(ShapeInferRegisterer::infer_shape(op, {{2, 64, 8, 8}, {64, 1, 1}}, output_shape));
+    ASSERT_EQ(output_shape, std::vector<int>({2, 64, 8, 8}));
+    ASSERT_FALSE(ShapeInferRegisterer::infer_shape(op, {{2, 64, 8, 8}, {2, 32, 8, 8}}, output_shape));
+}
+
+TEST(test_shape_infer, build_check_shapes)
+{
+    std::string bin_path("model_file/simple_ops2.pnnx.bin");
+    std::string param_path("model_file/simple_ops2.pnnx.param");
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    // 静态输入形状在构建时推导的内存规划会被缓存
+    ASSERT_EQ(graph.memory_plans().size(), 1);
+    const MemoryPlan &plan = graph.memory_plans().begin()->second;
+    ASSERT_EQ(plan.input_shape, std::vector<int>({2, 3, 16, 16}));
+    ASSERT_EQ(plan.output_shapes.back().empty(), true);
+}
+
+TEST(test_shape_infer, build_fill_dynamic_dims)
+{
+    // 中间操作数的空间维度声明为动态，构建时由输入形状补全
+    const std::string param_path = testing::TempDir() + "simple_ops2_dynamic.pnnx.param";
+    std::ofstream param(param_path);
+    param << "7767517\n"
+          << "5 4\n"
+          << "pnnx.Input pnnx_input_0 0 1 0 #0=(2,3,16,16)f32\n"
+          << "nn.Conv2d op1 1 1 0 1 bias=True dilation=(1,1) groups=1 in_channels=3 kernel_size=(3,3) out_channels=32 padding=(1,1) padding_mode=zeros stride=(1,1) @bias=(32)f32 @weight=(32,3,3,3)f32 #0=(2,3,16,16)f32 #1=(2,32,?,?)f32\n"
+          << "nn.Conv2d op3 1 1 1 2 bias=True dilation=(1,1) groups=1 in_channels=32 kernel_size=(3,3) out_channels=64 padding=(1,1) padding_mode=zeros stride=(2,2) @bias=(64)f32 @weight=(64,32,3,3)f32 #1=(2,32,?,?)f32 #2=(2,64,?,?)f32\n"
+          << "nn.Conv2d op5 1 1 2 3 bias=True dilation=(1,1) groups=1 in_channels=64 kernel_size=(3,3) out_channels=128 padding=(1,1) padding_mode=zeros stride=(1,1) @bias=(128)f32 @weight=(128,64,3,3)f32 #2=(2,64,?,?)f32 #3=(2,128,?,?)f32\n"
+          << "pnnx.Output pnnx_output_0 1 0 3 #3=(2,128,?,?)f32\n";
+    param.close();
+
+    RuntimeGraph graph(param_path, "model_file/simple_ops2.pnnx.bin");
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    for (const auto &op : graph.get_topo_seq()) {
+        if (op->name == "op3") {
+            ASSERT_EQ(op->output_operand->shape, std::vector<int>({2, 64, 8, 8}));
+            ASSERT_EQ(op->output_operand->data.size(), 2);
+        } else if (op->name == "pnnx_output_0") {
+            ASSERT_EQ(op->input_operands_seq.front()->shape, std::vector<int>({2, 128, 8, 8}));
+        }
+    }
+}
+
+TEST(test_shape_infer, build_shape_mismatch)
+{
+    const std::string param_path = testing::TempDir() + "simple_ops2_mismatch.pnnx.param";
+    std::ofstream param(param_path);
+    param << "7767517\n"
+          << "3 2\n"
+          << "pnnx.Input pnnx_input_0 0 1 0 #0=(2,3,16,16)f32\n"
+          << "nn.Conv2d op1 1 1 0 1 bias=True dilation=(1,1) groups=1 in_channels=3 kernel_size=(3,3) out_channels=32 padding=(1,1) padding_mode=zeros stride=(1,1) @bias=(32)f32 @weight=(32,3,3,3)f32 #0=(2,3,16,16)f32 #1=(2,32,8,8)f32\n"
+          << "pnnx.Output pnnx_output_0 1 0 1 #1=(2,32,8,8)f32\n";
+    param.close();
+
+    RuntimeGraph graph(param_path, "model_file/simple_ops2.pnnx.bin");
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), false);
+}
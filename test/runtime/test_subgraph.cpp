@@ -0,0 +1,170 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/runtime_ir.hpp"
+#include "test_util.hpp"
+#include <algorithm>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace jinfer;
+
+/// 1x1卷积的主干加上全局平均池化和线性层组成的分类头
+static std::shared_ptr<RuntimeGraph>
+CreateClassifier()
+{
+    const auto [param_path, bin_path] = WriteModel(
+        "classifier",
+        "7767517\n"
+        "7 6\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,3,4,5)f32\n"
+        "nn.Conv2d conv 1 1 0 1 bias=True dilation=(1,1) groups=1 in_channels=3 kernel_size=(1,1) out_channels=2 padding=(0,0) padding_mode=zeros stride=(1,1) @bias=(2)f32 @weight=(2,3,1,1)f32 #0=(1,3,4,5)f32 #1=(1,2,4,5)f32\n"
+        "nn.ReLU relu 1 1 1 2 #1=(1,2,4,5)f32 #2=(1,2,4,5)f32\n"
+        "torch.mean mean 1 1 2 3 dim=(2,3) keepdim=False #2=(1,2,4,5)f32 #3=(1,2)f32\n"
+        "nn.Linear fc 1 1 3 4 bias=True in_features=2 out_features=3 @bias=(3)f32 @weight=(3,2)f32 #3=(1,2)f32 #4=(1,3)f32\n"
+        "nn.ReLU head_relu 1 1 4 5 #4=(1,3)f32 #5=(1,3)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 5 #5=(1,3)f32\n",
+        {{"conv.weight", RandValues(2 * 3, 1)},
+         {"conv.bias", RandValues(2, 2)},
+         {"fc.weight", RandValues(3 * 2, 3)},
+         {"fc.bias", RandValues(3, 4)}});
+    if (param_path.empty()) {
+        return nullptr;
+    }
+
+    auto graph = std::make_shared<RuntimeGraph>(param_path, bin_path);
+    if (!graph->init()) {
+        return nullptr;
+    }
+    return graph;
+}
+
+static std::shared_ptr<RuntimeOperator>
+FindOperator(const RuntimeGraph &graph, const std::string &name)
+{
+    for (const auto &op : graph.operators()) {
+        if (op->name == name) {
+            return op;
+        }
+    }
+    return nullptr;
+}
+
+static std::vector<std::string>
+TopoNames(const RuntimeGraph &graph)
+{
+    std::vector<std::string> names;
+    for (const auto &op : graph.get_topo_seq()) {
+        names.push_back(op->name);
+    }
+    return names;
+}
+
+/// conv和relu的参考结果
+static float
+Feature(const sftensor &input, uint32_t c, uint32_t r, uint32_t w)
+{
+    const std::vector<float> weight = RandValues(2 * 3, 1);
+    const std::vector<float> bias = RandValues(2, 2);
+    float value = bias.at(c);
+    for (uint32_t i = 0; i < 3; i++) {
+        value += weight.at(c * 3 + i) * input->at(i, r, w);
+    }
+    return std::max(value, 0.f);
+}
+
+TEST(test_subgraph, truncated_backbone)
+{
+    auto graph = CreateClassifier();
+    ASSERT_NE(graph, nullptr);
+    ASSERT_EQ(graph->build("pnnx_input_0", "relu"), true);
+    ASSERT_EQ(TopoNames(*graph), std::vector<std::string>({"pnnx_input_0", "conv", "relu"}));
+
+    /// 分类头既不读取权重也不创建层
+    const auto fc = FindOperator(*graph, "fc");
+    ASSERT_NE(fc, nullptr);
+    ASSERT_EQ(fc->layer, nullptr);
+    for (const auto &[_, attr] : fc->attrs) {
+        ASSERT_TRUE(attr->pending());
+    }
+    ASSERT_EQ(FindOperator(*graph, "mean")->layer, nullptr);
+
+    auto input = std::make_shared<ftensor>(3, 4, 5);
+    input->rand();
+    const auto outputs = graph->forward({input});
+    ASSERT_EQ(outputs.size(), 1);
+    ASSERT_EQ(outputs.front()->raw_shapes(), std::vector<uint32_t>({2, 4, 5}));
+    for (uint32_t c = 0; c < 2; c++) {
+        for (uint32_t r = 0; r < 4; r++) {
+            for (uint32_t w = 0; w < 5; w++) {
+                ASSERT_NEAR(outputs.front()->at(c, r, w), Feature(input, c, r, w), 1e-5f);
+            }
+        }
+    }
+}
+
+TEST(test_subgraph, multiple_outputs)
+{
+    auto graph = CreateClassifier();
+    ASSERT_NE(graph, nullptr);
+    const std::vector<std::string> input_names = {"pnnx_input_0"};
+    const std::vector<std::string> output_names = {"relu", "fc", "pnnx_output_0"};
+    ASSERT_EQ(graph->build(input_names, output_names), true);
+    ASSERT_EQ(graph->output_operators().size(), 3);
+
+    /// fc作为输出时不能融合后面的激活函数
+    const auto fc = FindOperator(*graph, "fc");
+    ASSERT_EQ(fc->params.count("activation"), 0);
+    ASSERT_NE(FindOperator(*graph, "head_relu")->layer, nullptr);
+
+    auto input = std::make_shared<ftensor>(3, 4, 5);
+    input->rand();
+    const auto outputs = graph->forward(std::vector<std::vector<sftensor>>{{input}});
+    ASSERT_EQ(outputs.size(), 3);
+
+    std::vector<float> pooled(2, 0.f);
+    for (uint32_t c = 0; c < 2; c++) {
+        for (uint32_t r = 0; r < 4; r++) {
+            for (uint32_t w = 0; w < 5; w++) {
+                ASSERT_NEAR(outputs.at(0).front()->at(c, r, w), Feature(input, c, r, w), 1e-5f);
+                pooled.at(c) += Feature(input, c, r, w) / 20.f;
+            }
+        }
+    }
+
+    const std::vector<float> weight = RandValues(3 * 2, 3);
+    const std::vector<float> bias = RandValues(3, 4);
+    for (uint32_t o = 0; o < 3; o++) {
+        const float expect = bias.at(o) + weight.at(o * 2) * pooled.at(0) + weight.at(o * 2 + 1) * pooled.at(1);
+        ASSERT_NEAR(outputs.at(1).front()->at(0, 0, o), expect, 1e-5f);
+        ASSERT_NEAR(outputs.at(2).front()->at(0, 0, o), std::max(expect, 0.f), 1e-5f);
+    }
+}
+
+TEST(test_subgraph, missing_operators)
+{
+    auto graph = CreateClassifier();
+    ASSERT_NE(graph, nullptr);
+    ASSERT_EQ(graph->build("pnnx_input_0", "unknown"), false);
+    ASSERT_EQ(graph->build("conv", "pnnx_output_0"), false);
+    ASSERT_EQ(graph->state(), GraphState::need_build);
+}
+
+/// 子图依赖的输入节点没有列出时构建失败
+TEST(test_subgraph, missing_input)
+{
+    const auto [param_path, bin_path] = WriteModel(
+        "two_inputs",
+        "7767517\n"
+        "4 3\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,3,4,5)f32\n"
+        "pnnx.Input pnnx_input_1 0 1 1 #1=(1,3,4,5)f32\n"
+        "torch.cat cat 2 1 0 1 2 dim=1 #0=(1,3,4,5)f32 #1=(1,3,4,5)f32 #2=(1,6,4,5)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 2 #2=(1,6,4,5)f32\n");
+    ASSERT_FALSE(param_path.empty());
+
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), false);
+}
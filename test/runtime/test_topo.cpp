@@ -3,8 +3,10 @@
 //
 #include "runtime/ir.h"
 #include "runtime/runtime_ir.hpp"
+#include "test_util.hpp"
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <sstream>
 #include <string>
 
 TEST(test_ir, topo)
@@ -81,8 +83,8 @@ TEST(test_ir, build_output_ops2)
 TEST(test_ir, build1_status)
 {
     using namespace jinfer;
-    std::string bin_path("model_file/simple_ops.pnnx.bin");
-    std::string param_path("model_file/simple_ops.pnnx.param");
+    std::string bin_path("model_file/simple_ops2.pnnx.bin");
+    std::string param_path("model_file/simple_ops2.pnnx.param");
     RuntimeGraph graph(param_path, bin_path);
     ASSERT_EQ(int(graph.state()), -2);
     const bool init_success = graph.init();
@@ -93,6 +95,35 @@ TEST(test_ir, build1_status)
     ASSERT_EQ(int(graph.state()), 0);
 }
 
+TEST(test_ir, build_missing_layer)
+{
+    using namespace jinfer;
+    // simple_ops中的pnnx.Expression没有对应的层，构建失败
+    RuntimeGraph graph("model_file/simple_ops.pnnx.param", "model_file/simple_ops.pnnx.bin");
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), false);
+    ASSERT_EQ(graph.state(), GraphState::need_build);
+}
+
+TEST(test_ir, build_layer_parse_fail)
+{
+    using namespace jinfer;
+    // nn.Softmax缺少dim参数，创建层失败时构建返回false而不是终止进程
+    const auto [param_path, bin_path] = WriteModel(
+        "softmax_no_dim",
+        "7767517\n"
+        "3 2\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,3,4,4)f32\n"
+        "nn.Softmax softmax 1 1 0 1 #0=(1,3,4,4)f32 #1=(1,3,4,4)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 1 #1=(1,3,4,4)f32\n");
+    ASSERT_FALSE(param_path.empty());
+
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), false);
+    ASSERT_EQ(graph.state(), GraphState::need_build);
+}
+
 TEST(test_ir, build1_output_tensors)
 {
     using namespace jinfer;
@@ -133,3 +164,114 @@ TEST(test_ir, build1_output_tensors)
         }
     }
 }
+
+static size_t
+TopoIndex(const jinfer::RuntimeGraph &graph, const std::string &name)
+{
+    const auto &topo_operators = graph.get_topo_seq();
+    for (size_t i = 0; i < topo_operators.size(); i++) {
+        if (topo_operators.at(i)->name == name) {
+            return i;
+        }
+    }
+    return topo_operators.size();
+}
+
+/// 很深的链式计算图，排序不能依赖递归
+TEST(test_topo, deep_chain)
+{
+    using namespace jinfer;
+    const int depth = 3000;
+    std::ostringstream content;
+    content << "7767517\n"
+            << depth + 2 << " " << depth + 1 << "\n"
+            << "pnnx.Input pnnx_input_0 0 1 0 #0=(1,2,3,4)f32\n";
+    for (int i = 0; i < depth; i++) {
+        content << "nn.ReLU relu_" << i << " 1 1 " << i << " " << i + 1 << " #" << i << "=(1,2,3,4)f32 #"
+                << i + 1 << "=(1,2,3,4)f32\n";
+    }
+    content << "pnnx.Output pnnx_output_0 1 0 " << depth << " #" << depth << "=(1,2,3,4)f32\n";
+
+    const auto [param_path, bin_path] = WriteModel("deep_chain", content.str());
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    const auto &topo_operators = graph.get_topo_seq();
+    ASSERT_EQ(topo_operators.size(), depth + 2);
+    ASSERT_EQ(topo_operators.front()->name, "pnnx_input_0");
+    for (int i = 0; i < depth; i++) {
+        ASSERT_EQ(topo_operators.at(i + 1)->name, "relu_" + std::to_string(i));
+    }
+    ASSERT_EQ(topo_operators.back()->name, "pnnx_output_0");
+
+    auto input = std::make_shared<ftensor>(2, 3, 4);
+    input->rand();
+    const auto outputs = graph.forward({input});
+    ASSERT_EQ(outputs.size(), 1);
+    for (uint32_t i = 0; i < input->size(); i++) {
+        ASSERT_FLOAT_EQ(outputs.front()->raw_ptr()[i], std::max(input->raw_ptr()[i], 0.f));
+    }
+}
+
+/// 两个分支汇合，一个分支排完之后再排另一个，分支的输出在就绪后立刻被消费
+TEST(test_topo, branch_locality)
+{
+    using namespace jinfer;
+    const auto [param_path, bin_path] = WriteModel(
+        "two_branches_topo",
+        "7767517\n"
+        "7 7\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,2,3,4)f32\n"
+        "nn.ReLU a1 1 1 0 1 #0=(1,2,3,4)f32 #1=(1,2,3,4)f32\n"
+        "nn.ReLU a2 1 1 1 2 #1=(1,2,3,4)f32 #2=(1,2,3,4)f32\n"
+        "nn.ReLU b1 1 1 0 3 #0=(1,2,3,4)f32 #3=(1,2,3,4)f32\n"
+        "nn.ReLU b2 1 1 3 4 #3=(1,2,3,4)f32 #4=(1,2,3,4)f32\n"
+        "torch.cat cat 2 1 2 4 5 dim=1 #2=(1,2,3,4)f32 #4=(1,2,3,4)f32 #5=(1,4,3,4)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 5 #5=(1,4,3,4)f32\n");
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), true);
+
+    ASSERT_EQ(graph.get_topo_seq().size(), 7);
+    ASSERT_EQ(TopoIndex(graph, "pnnx_input_0"), 0);
+    ASSERT_EQ(TopoIndex(graph, "a2"), TopoIndex(graph, "a1") + 1);
+    ASSERT_EQ(TopoIndex(graph, "b2"), TopoIndex(graph, "b1") + 1);
+    ASSERT_EQ(TopoIndex(graph, "cat"), 5);
+    ASSERT_EQ(TopoIndex(graph, "pnnx_output_0"), 6);
+}
+
+TEST(test_topo, cycle)
+{
+    using namespace jinfer;
+    const auto [param_path, bin_path] = WriteModel(
+        "cycle_topo",
+        "7767517\n"
+        "4 3\n"
+        "pnnx.Input pnnx_input_0 0 1 0 #0=(1,2,3,4)f32\n"
+        "nn.ReLU a 1 1 0 1 #0=(1,2,3,4)f32 #1=(1,2,3,4)f32\n"
+        "nn.ReLU b 1 1 1 2 #1=(1,2,3,4)f32 #2=(1,2,3,4)f32\n"
+        "pnnx.Output pnnx_output_0 1 0 2 #2=(1,2,3,4)f32\n");
+    RuntimeGraph graph(param_path, bin_path);
+    ASSERT_EQ(graph.init(), true);
+
+    /// 模型文件无法描述环，手动把b的输出连回a
+    std::shared_ptr<RuntimeOperator> a;
+    std::shared_ptr<RuntimeOperator> b;
+    for (const auto &op : graph.operators()) {
+        if (op->name == "a") a = op;
+        if (op->name == "b") b = op;
+    }
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    auto operand = std::make_shared<RuntimeOperand>();
+    operand->name = "b";
+    operand->shape = b->output_operand->shape;
+    a->input_operands.insert({"b", operand});
+    a->input_operands_seq.push_back(operand);
+    b->output_operators.insert({"a", a});
+    b->output_names.push_back("a");
+
+    ASSERT_EQ(graph.build("pnnx_input_0", "pnnx_output_0"), false);
+    ASSERT_EQ(graph.state(), GraphState::need_build);
+}
@@ -0,0 +1,64 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+
+#ifndef _TEST_UTIL_HPP_
+#define _TEST_UTIL_HPP_
+
+#include "runtime/store_zip.hpp"
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// 固定种子的均匀分布随机数，同一种子每次得到相同的数据
+inline std::vector<float>
+RandValues(size_t size, uint32_t seed, float low = -1.f, float high = 1.f)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(low, high);
+    std::vector<float> values(size);
+    for (auto &value : values) value = dist(gen);
+    return values;
+}
+
+inline void
+WriteWeights(pnnx::StoreZipWriter &writer, const std::string &name, const std::vector<float> &values)
+{
+    writer.write_file(name, (const char *) values.data(), values.size() * sizeof(float));
+}
+
+/**
+ * 在临时目录下写出测试用的模型文件
+ * @param name 模型名称，文件为name.pnnx.param和name.pnnx.bin
+ * @param content 结构文件的内容
+ * @param weights 权重名称和数据，可以为空
+ * @return 结构文件和权重文件的路径，写入失败时路径为空
+ */
+inline std::pair<std::string, std::string>
+WriteModel(const std::string &name, const std::string &content,
+           const std::vector<std::pair<std::string, std::vector<float>>> &weights = {})
+{
+    const std::string param_path = testing::TempDir() + name + ".pnnx.param";
+    const std::string bin_path = testing::TempDir() + name + ".pnnx.bin";
+    std::ofstream param(param_path);
+    param << content;
+    param.close();
+    if (!param) {
+        return {};
+    }
+
+    pnnx::StoreZipWriter writer;
+    if (writer.open(bin_path) != 0) {
+        return {};
+    }
+    for (const auto &[weight_name, values] : weights) {
+        WriteWeights(writer, weight_name, values);
+    }
+    writer.close();
+    return {param_path, bin_path};
+}
+
+#endif//_TEST_UTIL_HPP_
@@ -0,0 +1,135 @@
+//
+// Created by 27836 on 2026/10/19.
+//
+#include "runtime/runtime_ir.hpp"
+#include <chrono>
+#include <cstring>
+#include <glog/logging.h>
+#include <iostream>
+#include <sstream>
+
+using namespace jinfer;
+
+static void
+PrintUsage(const char *program)
+{
+    std::cerr << "usage: " << program << " <param_path> <bin_path> [options]\n"
+              << "  --shape c,h,w     shape of one input sample (default 3,224,224)\n"
+              << "  --batch n         number of samples (default 1)\n"
+              << "  --input name      name of the input operator (default pnnx_input_0)\n"
+              << "  --output name     name of the output operator (default pnnx_output_0)\n"
+              << "  --repeat n        number of timed forward runs (default 10)\n"
+              << "  --profile path    print per-operator statistics and write a chrome trace to path\n";
+}
+
+static bool
+ParseShape(const std::string &text, std::vector<uint32_t> &shape)
+{
+    shape.clear();
+    std::stringstream stream(text);
+    std::string dim;
+    while (std::getline(stream, dim, ',')) {
+        const int value = std::atoi(dim.c_str());
+        if (value <= 0) {
+            return false;
+        }
+        shape.push_back(uint32_t(value));
+    }
+    return !shape.empty() && shape.size() <= 3;
+}
+
+int main(int argc, char *argv[])
+{
+    google::InitGoogleLogging("jinfer_run");
+    FLAGS_alsologtostderr = true;
+
+    if (argc < 3) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    const std::string param_path = argv[1];
+    const std::string bin_path = argv[2];
+    std::vector<uint32_t> shape{3, 224, 224};
+    std::string input_name = "pnnx_input_0";
+    std::string output_name = "pnnx_output_0";
+    int batch = 1;
+    int repeat = 10;
+    std::string trace_path;
+    for (int i = 3; i < argc; i++) {
+        if (i + 1 >= argc) {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        const char *value = argv[++i];
+        if (!std::strcmp(argv[i - 1], "--shape")) {
+            if (!ParseShape(value, shape)) {
+                std::cerr << "invalid shape " << value << "\n";
+                return 1;
+            }
+        } else if (!std::strcmp(argv[i - 1], "--batch")) {
+            batch = std::atoi(value);
+        } else if (!std::strcmp(argv[i - 1], "--input")) {
+            input_name = value;
+        } else if (!std::strcmp(argv[i - 1], "--output")) {
+            output_name = value;
+        } else if (!std::strcmp(argv[i - 1], "--repeat")) {
+            repeat = std::atoi(value);
+        } else if (!std::strcmp(argv[i - 1], "--profile")) {
+            trace_path = value;
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (batch <= 0 || repeat <= 0) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    RuntimeGraph graph(param_path, bin_path);
+    if (!graph.init() || !graph.build(input_name, output_name)) {
+        std::cerr << "failed to load graph " << param_path << "\n";
+        return 1;
+    }
+
+    std::vector<sftensor> inputs;
+    for (int i = 0; i < batch; i++) {
+        inputs.push_back(std::make_shared<ftensor>(shape));
+        inputs.back()->rand();
+    }
+
+    // 第一次forward会创建内存规划并分配输出，不计入耗时
+    auto outputs = graph.forward(inputs);
+    if (outputs.empty()) {
+        std::cerr << "forward of graph " << param_path << " failed\n";
+        return 1;
+    }
+    if (!trace_path.empty()) {
+        graph.set_profiler(std::make_shared<Profiler>());
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++) {
+        outputs = graph.forward(inputs);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double total_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    if (outputs.empty()) {
+        std::cerr << "forward of graph " << param_path << " failed\n";
+        return 1;
+    }
+    const auto &output = outputs.front();
+    std::cout << "output: " << outputs.size() << " x (" << output->channels() << ", " << output->rows()
+              << ", " << output->cols() << ")\n"
+              << "latency: " << total_ms / repeat << " ms per forward, "
+              << 1000.0 * batch * repeat / total_ms << " samples/s\n";
+
+    if (graph.profiler()) {
+        std::cout << graph.profiler()->report();
+        if (!graph.profiler()->dump_chrome_trace(trace_path)) {
+            return 1;
+        }
+    }
+    return 0;
+}